@@ -0,0 +1,163 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/choice_classes.hpp>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle;
+using namespace mockturtle::bench;
+
+MOCKTURTLE_BENCHMARK( "cut_enumeration/k4_truth" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const cuts = cut_enumeration<aig_network, true>( aig, ps );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "cut_enumeration/k6" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  cut_enumeration_params ps;
+  ps.cut_size = 6u;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const cuts = cut_enumeration<aig_network>( aig, ps );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
+
+/* adds the re-associated structure a & (b & c) of each gate (a & b) & c as a choice */
+static std::vector<std::pair<aig_network::node, aig_network::signal>> add_reassociated_choices( aig_network& aig )
+{
+  std::vector<std::pair<aig_network::node, aig_network::signal>> equivalences;
+  auto const num_nodes = aig.size();
+  for ( auto n = 0u; n < num_nodes; ++n )
+  {
+    if ( !aig.is_and( n ) )
+    {
+      continue;
+    }
+    std::array<aig_network::signal, 2> fanins;
+    aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      fanins[i] = f;
+    } );
+    auto const p = aig.get_node( fanins[0] );
+    if ( aig.is_complemented( fanins[0] ) || !aig.is_and( p ) )
+    {
+      continue;
+    }
+    std::array<aig_network::signal, 2> grand_fanins;
+    aig.foreach_fanin( p, [&]( auto const& f, auto i ) {
+      grand_fanins[i] = f;
+    } );
+    auto const alt = aig.create_and( grand_fanins[0], aig.create_and( grand_fanins[1], fanins[1] ) );
+    auto const m = aig.get_node( alt );
+    if ( m != n && aig.is_and( m ) )
+    {
+      equivalences.emplace_back( m, aig.is_complemented( alt ) ? !aig.make_signal( n ) : aig.make_signal( n ) );
+    }
+  }
+  return equivalences;
+}
+
+MOCKTURTLE_BENCHMARK( "choice_classes/reassociated" )
+{
+  auto aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  auto const equivalences = add_reassociated_choices( aig );
+
+  state.measure( aig.num_gates(), [&]() {
+    choice_classes choices( aig, equivalences );
+    do_not_optimize( choices.num_choices() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "cut_enumeration/k4_truth_choices" )
+{
+  auto aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  choice_classes const choices( aig, add_reassociated_choices( aig ) );
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const cuts = choice_cut_enumeration<aig_network, true>( aig, choices, ps );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "fast_cut_enumeration/k4_truth" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  cut_enumeration_params ps;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const cuts = fast_cut_enumeration<aig_network, 4u, true>( aig, ps );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "fast_cut_enumeration/k6" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  cut_enumeration_params ps;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const cuts = fast_cut_enumeration<aig_network, 6u>( aig, ps );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "dynamic_cut_enumeration/k4_truth" )
+{
+  using network_cuts_t = dynamic_network_cuts<aig_network, 4u, true, empty_cut_data>;
+  using cut_manager_t = detail::dynamic_cut_enumeration_impl<aig_network, 4u, true, empty_cut_data>;
+
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  cut_enumeration_params ps;
+  ps.cut_limit = 8u;
+
+  state.measure( aig.num_gates(), [&]() {
+    cut_enumeration_stats st;
+    network_cuts_t cuts( aig.size() );
+    cut_manager_t cut_manager( aig, ps, st, cuts );
+    cut_manager.init_cuts();
+    aig.foreach_gate( [&]( auto const& n ) {
+      cut_manager.compute_cuts( n );
+    } );
+    do_not_optimize( cuts.total_cuts() );
+  } );
+}
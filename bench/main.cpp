@@ -0,0 +1,147 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle::bench;
+
+static void print_usage()
+{
+  std::cout << "usage: run_benchmarks [options] [filter]\n"
+               "  --sizes N,N,...  network sizes (default: 1000,10000,100000)\n"
+               "  --samples N      number of measured runs (default: 5)\n"
+               "  --warmup N       number of warm-up runs (default: 1)\n"
+               "  --csv FILE       write the results to FILE instead of stdout\n"
+               "  --list           list the benchmarks\n";
+}
+
+int main( int argc, char** argv )
+{
+  benchmark_params ps;
+  std::vector<uint32_t> sizes{ 1000u, 10000u, 100000u };
+  std::string filter;
+  std::string csv_filename;
+
+  for ( auto i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[i];
+    if ( arg == "--list" )
+    {
+      for ( auto const& c : registry() )
+      {
+        std::cout << c.name << "\n";
+      }
+      return 0;
+    }
+    else if ( arg == "--help" || arg == "-h" )
+    {
+      print_usage();
+      return 0;
+    }
+    else if ( i + 1 < argc && arg == "--sizes" )
+    {
+      sizes.clear();
+      std::stringstream ss( argv[++i] );
+      std::string size;
+      while ( std::getline( ss, size, ',' ) )
+      {
+        sizes.push_back( static_cast<uint32_t>( std::stoul( size ) ) );
+      }
+    }
+    else if ( i + 1 < argc && arg == "--samples" )
+    {
+      ps.samples = std::max( 1u, static_cast<uint32_t>( std::stoul( argv[++i] ) ) );
+    }
+    else if ( i + 1 < argc && arg == "--warmup" )
+    {
+      ps.warmup = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+    }
+    else if ( i + 1 < argc && arg == "--csv" )
+    {
+      csv_filename = argv[++i];
+    }
+    else if ( arg.front() != '-' )
+    {
+      filter = arg;
+    }
+    else
+    {
+      print_usage();
+      return 1;
+    }
+  }
+
+  std::ofstream file;
+  if ( !csv_filename.empty() )
+  {
+    file.open( csv_filename );
+  }
+  std::ostream& os = csv_filename.empty() ? std::cout : file;
+
+  os << "benchmark,size,operations,samples,min_ns,median_ns,ns_per_operation\n";
+  for ( auto const& c : registry() )
+  {
+    if ( c.name.find( filter ) == std::string::npos )
+    {
+      continue;
+    }
+
+    for ( auto size : sizes )
+    {
+      benchmark_result result;
+      result.name = c.name;
+      result.size = size;
+
+      benchmark_state state( ps, result );
+      c.fn( state );
+      if ( result.times.empty() )
+      {
+        continue;
+      }
+
+      std::sort( result.times.begin(), result.times.end() );
+      auto const median = result.times[result.times.size() / 2];
+      os << fmt::format( "{},{},{},{},{:.0f},{:.0f},{:.2f}\n", result.name, result.size, result.operations, result.times.size(),
+                         result.times.front(), median, result.operations == 0u ? 0.0 : median / result.operations );
+      os.flush();
+
+      if ( !csv_filename.empty() )
+      {
+        std::cout << fmt::format( "[i] {:<40} {:>8} {:>12.2f} ns/op\n", result.name, result.size, result.operations == 0u ? 0.0 : median / result.operations );
+      }
+    }
+  }
+
+  return 0;
+}
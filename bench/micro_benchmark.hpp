@@ -0,0 +1,189 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file micro_benchmark.hpp
+  \brief Harness for micro-benchmarks of core primitives
+
+  Benchmarks are registered with `MOCKTURTLE_BENCHMARK` and are called once
+  for each network size.  Each benchmark prepares its input and calls
+  `benchmark_state::measure` with the number of operations performed by the
+  measured function, which is run for a fixed number of warm-up iterations
+  and samples.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+namespace mockturtle::bench
+{
+
+/*! \brief Parameters of the harness. */
+struct benchmark_params
+{
+  /*! \brief Number of runs before the measurements (not recorded). */
+  uint32_t warmup{ 1u };
+
+  /*! \brief Number of measured runs. */
+  uint32_t samples{ 5u };
+};
+
+/*! \brief Measurement of a benchmark for one network size. */
+struct benchmark_result
+{
+  std::string name;
+  uint32_t size{ 0u };
+  uint64_t operations{ 0u };
+
+  /*! \brief Time of each sample in nanoseconds. */
+  std::vector<double> times;
+};
+
+class benchmark_state
+{
+public:
+  benchmark_state( benchmark_params const& ps, benchmark_result& result )
+      : ps( ps ), result( result )
+  {
+  }
+
+  /*! \brief Network size requested for this run. */
+  uint32_t size() const
+  {
+    return result.size;
+  }
+
+  /*! \brief Measures a function performing `operations` operations. */
+  template<class Fn>
+  void measure( uint64_t operations, Fn&& fn )
+  {
+    measure(
+        operations, []() { return 0; }, [&]( int ) { fn(); } );
+  }
+
+  /*! \brief Measures `fn( input )` on a fresh `input = setup()` for each run.
+   *
+   * Only the call to `fn` is measured.
+   */
+  template<class Setup, class Fn>
+  void measure( uint64_t operations, Setup&& setup, Fn&& fn )
+  {
+    using clock = std::chrono::steady_clock;
+
+    result.operations = operations;
+    for ( auto i = 0u; i < ps.warmup + ps.samples; ++i )
+    {
+      auto input = setup();
+      auto const begin = clock::now();
+      fn( input );
+      auto const end = clock::now();
+      if ( i >= ps.warmup )
+      {
+        result.times.push_back( std::chrono::duration<double, std::nano>( end - begin ).count() );
+      }
+    }
+  }
+
+private:
+  benchmark_params const& ps;
+  benchmark_result& result;
+};
+
+struct benchmark_case
+{
+  std::string name;
+  std::function<void( benchmark_state& )> fn;
+};
+
+inline std::vector<benchmark_case>& registry()
+{
+  static std::vector<benchmark_case> cases;
+  return cases;
+}
+
+struct benchmark_registrar
+{
+  benchmark_registrar( std::string const& name, std::function<void( benchmark_state& )> const& fn )
+  {
+    registry().push_back( { name, fn } );
+  }
+};
+
+/*! \brief Prevents the compiler from removing the computation of `value`. */
+template<class T>
+inline void do_not_optimize( T const& value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+  asm volatile( ""
+                :
+                : "r,m"( value )
+                : "memory" );
+#else
+  static volatile char sink;
+  sink = *reinterpret_cast<char const volatile*>( &value );
+#endif
+}
+
+/*! \brief Generates a random AIG with `num_gates` gates. */
+inline aig_network random_aig( uint32_t num_pis, uint32_t num_gates, uint64_t seed = 0xcafeaffe )
+{
+  random_network_generator_params_size ps;
+  ps.seed = seed;
+  ps.num_pis = num_pis;
+  ps.num_gates = num_gates;
+  return random_aig_generator( ps ).generate();
+}
+
+/*! \brief Returns `num` random numbers in `[0, bound)`. */
+inline std::vector<uint32_t> random_indices( uint32_t num, uint32_t bound, uint64_t seed = 0xcafeaffe )
+{
+  std::mt19937 rng( static_cast<std::mt19937::result_type>( seed ) );
+  std::uniform_int_distribution<uint32_t> dist( 0u, bound - 1u );
+  std::vector<uint32_t> indices( num );
+  std::generate( indices.begin(), indices.end(), [&]() { return dist( rng ); } );
+  return indices;
+}
+
+} // namespace mockturtle::bench
+
+#define MOCKTURTLE_BENCHMARK_CONCAT_IMPL( a, b ) a##b
+#define MOCKTURTLE_BENCHMARK_CONCAT( a, b ) MOCKTURTLE_BENCHMARK_CONCAT_IMPL( a, b )
+
+/*! \brief Registers a benchmark, whose body has access to `state`. */
+#define MOCKTURTLE_BENCHMARK( name )                                                                                                                                                      \
+  static void MOCKTURTLE_BENCHMARK_CONCAT( _mockturtle_benchmark_, __LINE__ )( ::mockturtle::bench::benchmark_state & state );                                                         \
+  static ::mockturtle::bench::benchmark_registrar MOCKTURTLE_BENCHMARK_CONCAT( _mockturtle_benchmark_registrar_, __LINE__ )( name, MOCKTURTLE_BENCHMARK_CONCAT( _mockturtle_benchmark_, __LINE__ ) ); \
+  static void MOCKTURTLE_BENCHMARK_CONCAT( _mockturtle_benchmark_, __LINE__ )( ::mockturtle::bench::benchmark_state & state )
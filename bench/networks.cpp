@@ -0,0 +1,436 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/concurrent_network_builder.hpp>
+#include <mockturtle/utils/network_compaction.hpp>
+#include <mockturtle/utils/network_snapshot.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
+#include <mockturtle/utils/undo_log.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle;
+using namespace mockturtle::bench;
+
+namespace
+{
+
+/* creates `size` AND gates over random (mostly new) signals */
+void create_random_ands( aig_network& aig, std::vector<aig_network::signal>& fs, std::vector<uint32_t> const& indices )
+{
+  for ( auto i = 0u; i + 1u < indices.size(); i += 2u )
+  {
+    auto const a = fs[indices[i] % fs.size()];
+    auto const b = fs[indices[i + 1u] % fs.size()];
+    fs.push_back( aig.create_and( indices[i] & 1 ? !a : a, b ) );
+  }
+}
+
+} // namespace
+
+MOCKTURTLE_BENCHMARK( "aig/create_and" )
+{
+  auto const num_pis = std::max( 8u, state.size() / 10u );
+  auto const indices = random_indices( 2u * state.size(), 1u << 30u );
+
+  state.measure( state.size(), [&]() {
+    aig_network aig;
+    std::vector<aig_network::signal> fs;
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      fs.push_back( aig.create_pi() );
+    }
+    create_random_ands( aig, fs, indices );
+    do_not_optimize( aig.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/create_and_strash_hit" )
+{
+  auto const num_pis = std::max( 8u, state.size() / 10u );
+  auto const indices = random_indices( 2u * state.size(), 1u << 30u );
+
+  aig_network aig;
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    pis.push_back( aig.create_pi() );
+  }
+  auto fs = pis;
+  create_random_ands( aig, fs, indices );
+
+  /* recreating the same gates only hits the structural hash table */
+  state.measure( state.size(), [&]() {
+    auto gs = pis;
+    create_random_ands( aig, gs, indices );
+    do_not_optimize( gs.back() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "concurrent_network_builder/create_and" )
+{
+  auto const num_pis = std::max( 8u, state.size() / 10u );
+  auto const num_threads = default_num_threads();
+  auto const indices = random_indices( 2u * state.size(), 1u << 30u );
+
+  state.measure( state.size(), [&]() {
+    aig_network aig;
+    std::vector<aig_network::signal> pis;
+    for ( auto i = 0u; i < num_pis; ++i )
+    {
+      pis.push_back( aig.create_pi() );
+    }
+
+    /* each thread builds a slice of the gates on top of the PIs */
+    concurrent_network_builder builder( aig );
+    parallel_for( num_threads, num_threads, [&]( uint64_t index, uint32_t ) {
+      auto fs = pis;
+      auto const begin = indices.begin() + 2u * ( state.size() * index / num_threads );
+      auto const end = indices.begin() + 2u * ( state.size() * ( index + 1u ) / num_threads );
+      for ( auto it = begin; it != end; it += 2 )
+      {
+        auto const a = fs[*it % fs.size()];
+        auto const b = fs[*( it + 1 ) % fs.size()];
+        fs.push_back( builder.create_and( *it & 1 ? !a : a, b ) );
+      }
+    } );
+    builder.commit();
+    do_not_optimize( aig.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/substitute_node" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+
+  state.measure(
+      gates.size() / 4u, [&]() { return aig.clone(); },
+      [&]( aig_network& ntk ) {
+        for ( auto i = 0u; i < gates.size(); i += 4u )
+        {
+          auto const n = gates[i];
+          if ( ntk.is_dead( n ) )
+          {
+            continue;
+          }
+          aig_network::signal fanin;
+          ntk.foreach_fanin( n, [&]( auto const& f ) {
+            fanin = f;
+            return false;
+          } );
+          ntk.substitute_node( n, !fanin );
+        }
+        do_not_optimize( ntk.num_gates() );
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/clone" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  state.measure( aig.size(), [&]() {
+    auto const ntk = aig.clone();
+    do_not_optimize( ntk.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/snapshot_rollback" )
+{
+  auto aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+
+  /* a speculative attempt that changes a few nodes, normalized by the network size as for `aig/clone` */
+  state.measure( aig.size(), [&]() {
+    network_snapshot snapshot{ aig };
+    for ( auto i = 0u; i < gates.size(); i += gates.size() / 8u )
+    {
+      aig.create_po( aig.create_and( aig.make_signal( gates[i] ), !aig.make_signal( gates[( i + 1u ) % gates.size()] ) ) );
+    }
+    snapshot.rollback();
+    do_not_optimize( aig.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/transaction_rollback" )
+{
+  auto aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+
+  /* the same speculative attempt as for `aig/snapshot_rollback`, undone through the log */
+  network_undo_log log{ aig };
+  state.measure( aig.size(), [&]() {
+    log.begin();
+    for ( auto i = 0u; i < gates.size(); i += gates.size() / 8u )
+    {
+      aig.create_po( aig.create_and( aig.make_signal( gates[i] ), !aig.make_signal( gates[( i + 1u ) % gates.size()] ) ) );
+    }
+    log.rollback();
+    do_not_optimize( aig.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/compact_nodes" )
+{
+  auto const num_pis = std::max( 8u, state.size() / 10u );
+  auto const indices = random_indices( 2u * state.size(), 1u << 30u );
+
+  /* every other gate is taken out, such that dead nodes are spread over the whole network */
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  std::vector<aig_network::node> dead;
+  for ( auto i = 0u; i + 3u < indices.size(); i += 4u )
+  {
+    auto const f = aig.create_and( fs[indices[i] % fs.size()], !fs[indices[i + 1u] % fs.size()] );
+    dead.push_back( aig.get_node( aig.create_and( f, fs[indices[i + 2u] % num_pis] ) ) );
+    fs.push_back( f );
+  }
+  aig.create_po( fs.back() );
+  for ( auto const& n : dead )
+  {
+    if ( aig.fanout_size( n ) == 0u )
+    {
+      aig.take_out_node( n );
+    }
+  }
+
+  state.measure(
+      aig.size(),
+      [&]() { return aig.clone(); },
+      [&]( auto& ntk ) {
+        auto const remapping = compact_nodes( ntk );
+        do_not_optimize( remapping.num_removed() );
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/cleanup_dangling" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const ntk = cleanup_dangling( aig );
+    do_not_optimize( ntk.num_gates() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "aig/foreach_fanin" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  state.measure( 2u * aig.num_gates(), [&]() {
+    uint64_t sum{ 0u };
+    aig.foreach_gate( [&]( auto const& n ) {
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        sum += aig.node_to_index( aig.get_node( f ) );
+      } );
+    } );
+    do_not_optimize( sum );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "fanout_view/construct" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  state.measure( aig.num_gates(), [&]() {
+    fanout_view fanout_aig{ aig };
+    do_not_optimize( fanout_aig.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "fanout_view/foreach_fanout" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  fanout_view fanout_aig{ aig };
+
+  state.measure( 2u * aig.num_gates(), [&]() {
+    uint64_t sum{ 0u };
+    fanout_aig.foreach_node( [&]( auto const& n ) {
+      fanout_aig.foreach_fanout( n, [&]( auto const& f ) {
+        sum += fanout_aig.node_to_index( f );
+      } );
+    } );
+    do_not_optimize( sum );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "fanout_view/substitute_high_fanout" )
+{
+  auto const indices = random_indices( state.size(), 1u << 30u );
+
+  /* `size` gates share the same fanin, which is then substituted */
+  aig_network aig;
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < 1024u; ++i )
+  {
+    pis.push_back( aig.create_pi() );
+  }
+  auto const shared = aig.create_and( pis[0], pis[1] );
+  for ( auto i = 0u; i < state.size(); ++i )
+  {
+    auto const a = pis[2u + indices[i] % 1022u];
+    auto const b = pis[2u + ( indices[i] >> 10u ) % 1022u];
+    aig.create_po( aig.create_and( shared, aig.create_and( a, !b ) ) );
+  }
+
+  state.measure(
+      state.size(), [&]() { return fanout_view{ aig.clone() }; },
+      [&]( auto& fanout_aig ) {
+        fanout_aig.substitute_node( fanout_aig.get_node( shared ), !pis[0] );
+        do_not_optimize( fanout_aig.num_gates() );
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "depth_view/update_levels" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  depth_view depth_aig{ aig };
+
+  state.measure( aig.num_gates(), [&]() {
+    depth_aig.update_levels();
+    do_not_optimize( depth_aig.depth() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "depth_view/incremental_substitute" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  std::vector<aig_network::node> gates;
+  aig.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+
+  /* levels and depth are kept up to date after each substitution */
+  depth_view_params ps;
+  ps.incremental = true;
+  state.measure(
+      gates.size() / 64u,
+      [&]() {
+        /* the view refers to the network, which must outlive it */
+        auto ntk = std::make_unique<aig_network>( aig.clone() );
+        auto view = std::make_unique<depth_view<aig_network>>( *ntk, unit_cost<aig_network>{}, ps );
+        return std::make_pair( std::move( ntk ), std::move( view ) );
+      },
+      [&]( auto& input ) {
+        auto& depth_aig = *input.second;
+        for ( auto i = 0u; i < gates.size(); i += 64u )
+        {
+          auto const n = gates[i];
+          if ( depth_aig.is_dead( n ) )
+          {
+            continue;
+          }
+          aig_network::signal fanin;
+          depth_aig.foreach_fanin( n, [&]( auto const& f ) {
+            fanin = f;
+            return false;
+          } );
+          depth_aig.substitute_node( n, !fanin );
+          do_not_optimize( depth_aig.depth() );
+        }
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "node_map/sequential" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  node_map<uint32_t, aig_network> values( aig, 0u );
+
+  state.measure( 2u * aig.size(), [&]() {
+    aig.foreach_node( [&]( auto const& n, auto i ) {
+      values[n] = i;
+    } );
+    uint64_t sum{ 0u };
+    aig.foreach_node( [&]( auto const& n ) {
+      sum += values[n];
+    } );
+    do_not_optimize( sum );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "node_map/fanins" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+  node_map<uint32_t, aig_network> levels( aig, 0u );
+
+  /* typical access pattern of a topological traversal */
+  state.measure( 2u * aig.num_gates(), [&]() {
+    aig.foreach_gate( [&]( auto const& n ) {
+      uint32_t level{ 0u };
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[f] );
+      } );
+      levels[n] = level + 1u;
+    } );
+    do_not_optimize( levels[aig.index_to_node( aig.size() - 1u )] );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "unordered_node_map/fanins" )
+{
+  auto const aig = random_aig( std::max( 8u, state.size() / 10u ), state.size() );
+
+  state.measure( 2u * aig.num_gates(), [&]() {
+    unordered_node_map<uint32_t, aig_network> levels( aig );
+    aig.foreach_ci( [&]( auto const& n ) {
+      levels[n] = 0u;
+    } );
+    levels[aig.get_constant( false )] = 0u;
+    aig.foreach_gate( [&]( auto const& n ) {
+      uint32_t level{ 0u };
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[f] );
+      } );
+      levels[n] = level + 1u;
+    } );
+    do_not_optimize( levels.size() );
+  } );
+}
@@ -0,0 +1,146 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <mockturtle/algorithms/retiming.hpp>
+#include <mockturtle/networks/generic.hpp>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle;
+using namespace mockturtle::bench;
+
+namespace
+{
+
+generic_network::signal create_register_box( generic_network& ntk, generic_network::signal const& a )
+{
+  auto const in_register = ntk.create_box_input( a );
+  auto const node_register = ntk.create_register( in_register );
+  return ntk.create_box_output( node_register );
+}
+
+/* 64-bit pipeline whose stages mix neighbouring bits, then compress to half the width and expand again */
+generic_network pipelined_datapath( uint32_t num_gates )
+{
+  constexpr uint32_t width = 64u;
+  constexpr uint32_t depth = 4u;
+  auto const num_stages = std::max( 1u, num_gates / ( width * depth + width + width / 2u ) );
+  auto const indices = random_indices( 2u * width * depth * num_stages, 1u << 30u );
+
+  generic_network ntk;
+  std::vector<generic_network::signal> fs;
+  for ( auto i = 0u; i < width; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+
+  auto index = 0u;
+  for ( auto s = 0u; s < num_stages; ++s )
+  {
+    for ( auto& f : fs )
+    {
+      f = create_register_box( ntk, f );
+    }
+    for ( auto d = 0u; d < depth; ++d )
+    {
+      std::vector<generic_network::signal> next;
+      for ( auto i = 0u; i < width; ++i, index += 2u )
+      {
+        auto const b = fs[( i + 1u + indices[index] % 3u ) % width];
+        next.push_back( indices[index + 1u] & 1 ? ntk.create_and( fs[i], b ) : ntk.create_xor( fs[i], b ) );
+      }
+      fs = next;
+    }
+
+    std::vector<generic_network::signal> half;
+    for ( auto i = 0u; i < width; i += 2u )
+    {
+      half.push_back( ntk.create_and( fs[i], fs[i + 1u] ) );
+    }
+    for ( auto i = 0u; i < width; ++i )
+    {
+      fs[i] = ntk.create_xor( half[i / 2u], half[( i / 2u + 1u ) % half.size()] );
+    }
+  }
+
+  for ( auto const& f : fs )
+  {
+    ntk.create_po( f );
+  }
+  return ntk;
+}
+
+} // namespace
+
+MOCKTURTLE_BENCHMARK( "retime/pipelined_datapath" )
+{
+  auto const ntk = pipelined_datapath( state.size() );
+
+  state.measure(
+      ntk.num_gates(),
+      [&]() { return ntk.clone(); },
+      [&]( auto& copy ) {
+        retime( copy );
+        do_not_optimize( copy.num_registers() );
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "retime/pipelined_datapath_4_threads" )
+{
+  auto const ntk = pipelined_datapath( state.size() );
+  retime_params ps;
+  ps.num_threads = 4u;
+
+  state.measure(
+      ntk.num_gates(),
+      [&]() { return ntk.clone(); },
+      [&]( auto& copy ) {
+        retime( copy, ps );
+        do_not_optimize( copy.num_registers() );
+      } );
+}
+
+MOCKTURTLE_BENCHMARK( "retime/deep_chain" )
+{
+  /* two registers merged forward across a long chain of inverters */
+  generic_network ntk;
+  auto f = ntk.create_and( create_register_box( ntk, ntk.create_pi() ), create_register_box( ntk, ntk.create_pi() ) );
+  for ( auto i = 0u; i < state.size(); ++i )
+  {
+    f = ntk.create_not( f );
+  }
+  ntk.create_po( f );
+
+  state.measure(
+      state.size(),
+      [&]() { return ntk.clone(); },
+      [&]( auto& copy ) {
+        retime( copy );
+        do_not_optimize( copy.num_registers() );
+      } );
+}
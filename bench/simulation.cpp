@@ -0,0 +1,153 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle;
+using namespace mockturtle::bench;
+
+MOCKTURTLE_BENCHMARK( "simulate/input_word" )
+{
+  auto const aig = random_aig( 64u, state.size() );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const values = simulate<bool>( aig, input_word_simulator( 0xcafeaffecafeaffe ) );
+    do_not_optimize( values.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/static_truth_table_8" )
+{
+  auto const aig = random_aig( 8u, state.size() );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const values = simulate<kitty::static_truth_table<8u>>( aig );
+    do_not_optimize( values.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/dynamic_truth_table_8" )
+{
+  auto const aig = random_aig( 8u, state.size() );
+  default_simulator<kitty::dynamic_truth_table> sim( 8u );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const values = simulate<kitty::dynamic_truth_table>( aig, sim );
+    do_not_optimize( values.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/partial_truth_table_1024" )
+{
+  auto const aig = random_aig( 64u, state.size() );
+  partial_simulator sim( aig.num_pis(), 1024u );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const values = simulate<kitty::partial_truth_table>( aig, sim );
+    do_not_optimize( values.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/bit_packed_1024" )
+{
+  auto const aig = random_aig( 64u, state.size() );
+  bit_packed_simulator sim( aig.num_pis(), 1024u );
+
+  state.measure( aig.num_gates(), [&]() {
+    auto const values = simulate<kitty::partial_truth_table>( aig, sim );
+    do_not_optimize( values.size() );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/parallel_by_level_64" )
+{
+  auto const aig = random_aig( 64u, state.size() );
+  topo_view const topo{ aig };
+
+  node_map<uint64_t, aig_network> values( aig, 0u );
+  aig.foreach_pi( [&]( auto const& n, auto i ) {
+    values[n] = UINT64_C( 0xcafeaffecafeaffe ) * ( i + 1u );
+  } );
+
+  state.measure( aig.num_gates(), [&]() {
+    parallel_foreach_gate_by_level( topo, [&]( auto const& n, uint32_t ) {
+      uint64_t value{ ~UINT64_C( 0 ) };
+      aig.foreach_fanin( n, [&]( auto const& f ) {
+        value &= aig.is_complemented( f ) ? ~values[f] : values[f];
+      } );
+      values[n] = value;
+    } );
+    do_not_optimize( values[aig.po_at( 0u )] );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "simulate/sequential_64" )
+{
+  /* the last 32 inputs of a random AIG become registers fed by its outputs */
+  auto const aig = random_aig( 64u, state.size() );
+  sequential<aig_network> seq;
+  node_map<aig_network::signal, aig_network> old2new( aig );
+  old2new[aig.get_constant( false )] = seq.get_constant( false );
+  aig.foreach_pi( [&]( auto const& n, auto i ) {
+    old2new[n] = i < 32u ? seq.create_pi() : seq.create_ro();
+  } );
+  aig.foreach_gate( [&]( auto const& n ) {
+    std::array<aig_network::signal, 2u> children;
+    aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      children[i] = old2new[f] ^ aig.is_complemented( f );
+    } );
+    old2new[n] = seq.create_and( children[0u], children[1u] );
+  } );
+  aig.foreach_po( [&]( auto const& f ) {
+    seq.create_po( old2new[f] ^ aig.is_complemented( f ) );
+  } );
+  for ( auto i = 0u; i < 32u; ++i )
+  {
+    auto const f = aig.po_at( i % aig.num_pos() );
+    seq.create_ri( old2new[f] ^ aig.is_complemented( f ) );
+  }
+
+  sequential_simulator sim( seq );
+  std::vector<uint64_t> inputs( seq.num_pis(), UINT64_C( 0xcafeaffecafeaffe ) );
+
+  state.measure( seq.num_gates(), [&]() {
+    sim.simulate_cycle( inputs );
+    do_not_optimize( sim.value( seq.po_at( 0u ) ) );
+  } );
+}
@@ -0,0 +1,79 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/truth_table_cache.hpp>
+
+#include "micro_benchmark.hpp"
+
+using namespace mockturtle;
+using namespace mockturtle::bench;
+
+MOCKTURTLE_BENCHMARK( "truth_table_cache/insert" )
+{
+  /* inserts functions drawn from a pool of `size / 10` distinct functions */
+  std::vector<kitty::dynamic_truth_table> pool;
+  for ( auto i = 0u; i < std::max( 1u, state.size() / 10u ); ++i )
+  {
+    kitty::dynamic_truth_table tt( 6u );
+    kitty::create_random( tt, i );
+    pool.push_back( tt );
+  }
+  auto const indices = random_indices( state.size(), static_cast<uint32_t>( pool.size() ) );
+
+  state.measure( state.size(), [&]() {
+    truth_table_cache<kitty::dynamic_truth_table> cache;
+    uint64_t sum{ 0u };
+    for ( auto i : indices )
+    {
+      sum += cache.insert( pool[i] );
+    }
+    do_not_optimize( sum );
+  } );
+}
+
+MOCKTURTLE_BENCHMARK( "exact_npn_canonization/4" )
+{
+  /* canonizes `size / 10` random 4-input functions */
+  std::vector<kitty::static_truth_table<4u>> functions( std::max( 1u, state.size() / 10u ) );
+  for ( auto i = 0u; i < functions.size(); ++i )
+  {
+    kitty::create_random( functions[i], i );
+  }
+
+  state.measure( functions.size(), [&]() {
+    uint64_t sum{ 0u };
+    for ( auto const& tt : functions )
+    {
+      sum += std::get<0>( kitty::exact_npn_canonization( tt ) )._bits;
+    }
+    do_not_optimize( sum );
+  } );
+}
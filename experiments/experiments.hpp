@@ -33,10 +33,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -48,6 +52,7 @@
 #include <fmt/format.h>
 #include <mockturtle/io/write_bench.hpp>
 #include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/utils/tracing.hpp>
 #include <nlohmann/json.hpp>
 
 namespace experiments
@@ -96,6 +101,10 @@ private:
       {
         cell = static_cast<std::string>( data );
       }
+      else if ( data.is_number_unsigned() )
+      {
+        cell = std::to_string( static_cast<uint64_t>( data ) );
+      }
       else if ( data.is_number_integer() )
       {
         cell = std::to_string( static_cast<int>( data ) );
@@ -368,6 +377,441 @@ private:
   nlohmann::json data_;
 };
 
+/*! \brief Parameters for performance measurements. */
+struct performance_params
+{
+  /*! \brief Number of runs before the measurements (not recorded). */
+  uint32_t warmup{ 1u };
+
+  /*! \brief Number of measured runs. */
+  uint32_t repetitions{ 5u };
+
+  /*! \brief Significance level of the test for slowdowns. */
+  double significance{ 0.05 };
+
+  /*! \brief Minimum relative slowdown to be reported (e.g., 0.05 for 5%). */
+  double min_slowdown{ 0.05 };
+};
+
+/*! \brief Result of a performance measurement. */
+struct performance_measurement
+{
+  /*! \brief Wall time of each measured run in seconds. */
+  std::vector<double> times;
+
+  /*! \brief Average time per run of each traced phase in seconds.
+   *
+   * Phases are only recorded if mockturtle is compiled with `ENABLE_TRACING`.
+   */
+  std::map<std::string, double> phases;
+
+  /*! \brief Peak resident set size of the runs in KB.
+   *
+   * The largest increase of the resident set size during a measured run
+   * over its size at the start of the run.  Resetting the peak is only
+   * supported on Linux; otherwise, this is the peak resident set size of
+   * the whole process, including earlier benchmarks, and
+   * `peak_rss_cumulative` is true.
+   */
+  uint64_t peak_rss_kb{ 0u };
+
+  /*! \brief Whether `peak_rss_kb` is the peak of the whole process. */
+  bool peak_rss_cumulative{ false };
+
+  /*! \brief Average number of allocations per run.
+   *
+   * Allocations are only counted if `MOCKTURTLE_TRACE_ALLOCATIONS()` is used
+   * in the program.
+   */
+  uint64_t allocations{ 0u };
+
+  /*! \brief Average number of allocated bytes per run. */
+  uint64_t allocated_bytes{ 0u };
+};
+
+namespace detail
+{
+
+inline double mean( std::vector<double> const& values )
+{
+  double sum{ 0.0 };
+  for ( auto v : values )
+  {
+    sum += v;
+  }
+  return values.empty() ? 0.0 : sum / values.size();
+}
+
+inline double variance( std::vector<double> const& values )
+{
+  if ( values.size() < 2u )
+  {
+    return 0.0;
+  }
+
+  auto const m = mean( values );
+  double sum{ 0.0 };
+  for ( auto v : values )
+  {
+    sum += ( v - m ) * ( v - m );
+  }
+  return sum / ( values.size() - 1u );
+}
+
+/* upper critical value of Student's t-distribution (Cornish-Fisher expansion of the normal quantile) */
+inline double t_critical_value( double significance, double dof )
+{
+  double const t = std::sqrt( -2.0 * std::log( significance ) );
+  double const z = t - ( 2.515517 + 0.802853 * t + 0.010328 * t * t ) / ( 1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t );
+  double const z2 = z * z;
+  return z + z * ( z2 + 1.0 ) / ( 4.0 * dof ) + z * ( ( 5.0 * z2 + 16.0 ) * z2 + 3.0 ) / ( 96.0 * dof * dof ) + z * ( ( ( 3.0 * z2 + 19.0 ) * z2 + 17.0 ) * z2 - 15.0 ) / ( 384.0 * dof * dof * dof );
+}
+
+/* reads a field in KB from the status of the process (Linux only) */
+inline uint64_t process_status_kb( std::string const& field )
+{
+#ifdef __linux__
+  std::ifstream in( "/proc/self/status" );
+  std::string line;
+  while ( std::getline( in, line ) )
+  {
+    if ( line.size() > field.size() && line.compare( 0u, field.size(), field ) == 0 && line[field.size()] == ':' )
+    {
+      return std::stoull( line.substr( field.size() + 1u ) );
+    }
+  }
+#else
+  (void)field;
+#endif
+  return 0u;
+}
+
+/* resets the peak resident set size to the current one (Linux only) */
+inline bool reset_peak_rss()
+{
+#ifdef __linux__
+  std::ofstream out( "/proc/self/clear_refs" );
+  out << "5";
+  out.flush();
+  return out.good() && process_status_kb( "VmHWM" ) != 0u;
+#else
+  return false;
+#endif
+}
+
+/* one-sided Welch's t-test for `current` being slower than `previous` */
+inline bool is_significant_slowdown( std::vector<double> const& previous, std::vector<double> const& current, double significance, double min_slowdown )
+{
+  auto const m_prev = mean( previous );
+  auto const m_cur = mean( current );
+  if ( previous.empty() || current.empty() || m_cur <= m_prev * ( 1.0 + min_slowdown ) )
+  {
+    return false;
+  }
+
+  /* not enough samples for a statistical test */
+  if ( previous.size() < 2u || current.size() < 2u )
+  {
+    return true;
+  }
+
+  auto const v_prev = variance( previous ) / previous.size();
+  auto const v_cur = variance( current ) / current.size();
+  if ( v_prev + v_cur == 0.0 )
+  {
+    return true;
+  }
+
+  auto const dof = ( v_prev + v_cur ) * ( v_prev + v_cur ) / ( v_prev * v_prev / ( previous.size() - 1u ) + v_cur * v_cur / ( current.size() - 1u ) );
+  return ( m_cur - m_prev ) / std::sqrt( v_prev + v_cur ) > t_critical_value( significance, dof );
+}
+
+} // namespace detail
+
+/*! \brief Measures the performance of a function.
+ *
+ * Calls `setup()` to create the input and `run( input )` on it, first
+ * `ps.warmup` times without measurements and then `ps.repetitions` times.
+ * Only the calls to `run` are measured, including their peak resident set
+ * size, which is measured for each run separately where supported.
+ */
+template<class Setup, class Run>
+performance_measurement measure_performance( Setup&& setup, Run&& run, performance_params const& ps = {} )
+{
+  using clock = std::chrono::steady_clock;
+  using namespace mockturtle;
+
+  performance_measurement result;
+  auto& recorder = trace_recorder::instance();
+
+  for ( auto i = 0u; i < ps.warmup + ps.repetitions; ++i )
+  {
+    auto input = setup();
+    recorder.clear();
+
+    bool const rss_reset = detail::reset_peak_rss();
+    auto const rss = rss_reset ? detail::process_status_kb( "VmRSS" ) : 0u;
+    auto const allocations = trace_allocation_counters::num_allocations.load();
+    auto const allocated_bytes = trace_allocation_counters::num_bytes.load();
+    auto const begin = clock::now();
+    run( input );
+    auto const end = clock::now();
+
+    if ( i < ps.warmup )
+    {
+      continue;
+    }
+
+    if ( rss_reset )
+    {
+      auto const peak_rss = detail::process_status_kb( "VmHWM" );
+      result.peak_rss_kb = std::max( result.peak_rss_kb, peak_rss > rss ? peak_rss - rss : 0u );
+    }
+    else
+    {
+      result.peak_rss_kb = mockturtle::peak_rss_kb();
+      result.peak_rss_cumulative = true;
+    }
+
+    result.times.push_back( std::chrono::duration<double>( end - begin ).count() );
+    result.allocations += trace_allocation_counters::num_allocations.load() - allocations;
+    result.allocated_bytes += trace_allocation_counters::num_bytes.load() - allocated_bytes;
+    for ( auto const& e : recorder.events() )
+    {
+      if ( !e.is_counter )
+      {
+        result.phases[e.name] += e.duration * 1e-6;
+      }
+    }
+  }
+  recorder.clear();
+
+  if ( ps.repetitions > 0u )
+  {
+    result.allocations /= ps.repetitions;
+    result.allocated_bytes /= ps.repetitions;
+    for ( auto& [_, time] : result.phases )
+    {
+      time /= ps.repetitions;
+    }
+  }
+
+  return result;
+}
+
+/*! \brief Runtime and memory regression tracking.
+ *
+ * Counterpart of `experiment` for performance: it stores the measurements
+ * of each benchmark in the JSON history `<name>_performance.json`, next to
+ * the QoR history of the experiment `<name>`, and compares them to the
+ * previous version using a one-sided Welch's t-test on the run times.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      performance_experiment exp( "lut_mapper" );
+      for ( auto const& benchmark : epfl_benchmarks() )
+      {
+        exp( benchmark, [&]() { return read_benchmark( benchmark ); },
+                        [&]( aig_network& aig ) { lut_map( aig ); } );
+      }
+      exp.save();
+      return exp.compare() ? 0 : 1;
+   \endverbatim
+ */
+class performance_experiment
+{
+public:
+  explicit performance_experiment( std::string_view name, performance_params const& ps = {} )
+      : name_( name ), ps_( ps )
+  {
+#ifndef EXPERIMENTS_PATH
+    filename_ = fmt::format( "{}_performance.json", name );
+#else
+    filename_ = fmt::format( "{}{}_performance.json", EXPERIMENTS_PATH, name );
+#endif
+
+    std::ifstream in( filename_, std::ifstream::in );
+    if ( in.good() )
+    {
+      data_ = nlohmann::json::parse( in );
+    }
+  }
+
+  /*! \brief Measures and records the performance of a benchmark. */
+  template<class Setup, class Run>
+  performance_measurement operator()( std::string const& benchmark, Setup&& setup, Run&& run )
+  {
+    auto const result = measure_performance( setup, run, ps_ );
+
+    nlohmann::json entry;
+    entry["benchmark"] = benchmark;
+    entry["time"] = detail::mean( result.times );
+    entry["time_stddev"] = std::sqrt( detail::variance( result.times ) );
+    entry["times"] = result.times;
+    entry["phases"] = result.phases;
+    entry["peak_rss_kb"] = result.peak_rss_kb;
+    entry["peak_rss_cumulative"] = result.peak_rss_cumulative;
+    entry["allocations"] = result.allocations;
+    entry["allocated_bytes"] = result.allocated_bytes;
+    entries_.push_back( entry );
+
+    return result;
+  }
+
+  void save( std::string_view version = use_github_revision )
+  {
+    std::string version_;
+    version_ = version;
+#ifdef GIT_SHORT_REVISION
+    if ( version == experiments::use_github_revision )
+    {
+      version_ = GIT_SHORT_REVISION;
+    }
+#endif
+
+    if ( !data_.empty() && data_.back()["version"] == version_ )
+    {
+      data_.erase( data_.size() - 1u );
+    }
+
+    data_.push_back( { { "version", version_ },
+                       { "entries", entries_ } } );
+
+    std::ofstream os( filename_, std::ofstream::out );
+    os << data_.dump( 2 ) << "\n";
+  }
+
+  bool table( std::string const& version = {}, std::ostream& os = std::cout ) const
+  {
+    if ( data_.empty() )
+    {
+      fmt::print( "[w] no data available\n" );
+      return false;
+    }
+
+    auto const it = find_version( version, data_.end() - 1 );
+    if ( it == data_.end() )
+    {
+      fmt::print( "[w] version {} not found\n", version );
+      return false;
+    }
+
+    fmt::print( "[i] dataset " );
+    fmt::print( fg( fmt::terminal_color::blue ), "{}\n", ( *it )["version"] );
+    json_table( ( *it )["entries"], { "benchmark", "time", "time_stddev", "peak_rss_kb", "allocations", "allocated_bytes" } ).print( os );
+    print_cumulative_rss_note( ( *it )["entries"], os );
+    return true;
+  }
+
+  /*! \brief Compares the run times of two versions.
+   *
+   * By default, compares the last version to the previous one.  Returns
+   * false if a benchmark is significantly slower in the current version.
+   */
+  bool compare( std::string const& old_version = {},
+                std::string const& current_version = {},
+                std::ostream& os = std::cout ) const
+  {
+    if ( data_.size() < 2u )
+    {
+      fmt::print( "[w] dataset contains less than two entry sets\n" );
+      return true;
+    }
+
+    auto const it_old = find_version( old_version, data_.end() - 2 );
+    auto const it_cur = find_version( current_version, data_.end() - 1 );
+    if ( it_old == data_.end() || it_cur == data_.end() )
+    {
+      fmt::print( "[w] dataset not found\n" );
+      return true;
+    }
+
+    fmt::print( "[i] compare " );
+    fmt::print( fg( fmt::terminal_color::blue ), "{}", ( *it_old )["version"] );
+    fmt::print( " to " );
+    fmt::print( fg( fmt::terminal_color::blue ), "{}\n", ( *it_cur )["version"] );
+
+    nlohmann::json compare_entries;
+    std::vector<std::string> slowdowns;
+    for ( auto const& entry : ( *it_cur )["entries"] )
+    {
+      auto const& entries_old = ( *it_old )["entries"];
+      auto const it = std::find_if( entries_old.begin(), entries_old.end(), [&]( auto const& e ) { return e["benchmark"] == entry["benchmark"]; } );
+      if ( it == entries_old.end() )
+      {
+        continue;
+      }
+
+      auto const times_old = ( *it )["times"].get<std::vector<double>>();
+      auto const times_cur = entry["times"].get<std::vector<double>>();
+      auto const time_old = detail::mean( times_old );
+      auto const time_cur = detail::mean( times_cur );
+      bool const slowdown = detail::is_significant_slowdown( times_old, times_cur, ps_.significance, ps_.min_slowdown );
+      if ( slowdown )
+      {
+        slowdowns.push_back( entry["benchmark"].get<std::string>() );
+      }
+
+      nlohmann::json row;
+      row["benchmark"] = entry["benchmark"];
+      row["time"] = time_old;
+      row["time'"] = time_cur;
+      row["change"] = time_old == 0.0 ? std::string( "-" ) : fmt::format( "{:+.1f}%", ( time_cur / time_old - 1.0 ) * 100.0 );
+      row["peak_rss_kb"] = ( *it )["peak_rss_kb"];
+      row["peak_rss_kb'"] = entry["peak_rss_kb"];
+      row["allocations"] = ( *it )["allocations"];
+      row["allocations'"] = entry["allocations"];
+      row["slowdown"] = slowdown;
+      compare_entries.push_back( row );
+    }
+
+    json_table( compare_entries, { "benchmark", "time", "time'", "change", "peak_rss_kb", "peak_rss_kb'", "allocations", "allocations'", "slowdown" } ).print( os );
+    print_cumulative_rss_note( ( *it_cur )["entries"], os );
+
+    if ( slowdowns.empty() )
+    {
+      os << "[i] no significant slowdowns\n";
+      return true;
+    }
+
+    for ( auto const& benchmark : slowdowns )
+    {
+      os << fmt::format( "[w] benchmark '{}' is significantly slower\n", benchmark );
+    }
+    return false;
+  }
+
+private:
+  static void print_cumulative_rss_note( nlohmann::json const& entries, std::ostream& os )
+  {
+    if ( std::any_of( entries.begin(), entries.end(), []( auto const& e ) { return e.value( "peak_rss_cumulative", false ); } ) )
+    {
+      os << "[w] peak_rss_kb is the peak of the whole process, not of each benchmark\n";
+    }
+  }
+
+  nlohmann::json::const_iterator find_version( std::string const& version, nlohmann::json::const_iterator def ) const
+  {
+    if ( version.empty() )
+    {
+      return def;
+    }
+    return std::find_if( data_.begin(), data_.end(), [&]( auto const& entry ) { return entry["version"] == version; } );
+  }
+
+private:
+  std::string name_;
+  std::string filename_;
+  performance_params ps_;
+  nlohmann::json entries_ = nlohmann::json::array();
+
+  nlohmann::json data_;
+};
+
 // clang-format off
 /* EPFL benchmarks */
 static constexpr uint64_t adder           = 0b0000000000000000000000000000000000000000000000000000000000000001;
@@ -0,0 +1,100 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/algorithms/resubstitution.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/tracing.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <experiments.hpp>
+
+/* count allocations in the measurements */
+MOCKTURTLE_TRACE_ALLOCATIONS()
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  performance_params pps;
+  pps.warmup = 1u;
+  pps.repetitions = 5u;
+
+  performance_experiment exp_lut( "lut_mapper", pps );
+  performance_experiment exp_resub( "aig_resubstitution", pps );
+
+  auto benchmarks = epfl_benchmarks();
+  auto const iwls = iwls_benchmarks();
+  benchmarks.insert( benchmarks.end(), iwls.begin(), iwls.end() );
+
+  for ( auto const& benchmark : benchmarks )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    auto const setup = [&]() { return cleanup_dangling( aig ); };
+
+    exp_lut( benchmark, setup, []( aig_network& ntk ) {
+      lut_map_params ps;
+      ps.cut_enumeration_ps.cut_size = 6u;
+      ps.cut_enumeration_ps.cut_limit = 8u;
+      ps.recompute_cuts = true;
+      ps.area_oriented_mapping = false;
+      ps.cut_expansion = true;
+      lut_map( ntk, ps );
+    } );
+
+    exp_resub( benchmark, setup, []( aig_network& ntk ) {
+      resubstitution_params ps;
+      ps.max_pis = 8u;
+      ps.max_inserts = 2u;
+      depth_view depth_ntk{ ntk };
+      fanout_view fanout_ntk{ depth_ntk };
+      aig_resubstitution2( fanout_ntk, ps );
+    } );
+  }
+
+  exp_lut.save();
+  exp_resub.save();
+  exp_lut.table();
+  exp_resub.table();
+
+  bool const lut_ok = exp_lut.compare();
+  bool const resub_ok = exp_resub.compare();
+  return lut_ok && resub_ok ? 0 : 1;
+}
@@ -32,7 +32,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
 #include <map>
+#include <ostream>
 #include <unordered_map>
 #include <vector>
 
@@ -98,6 +104,7 @@ public:
     Ntk ntk;
     std::vector<uint32_t> input_levels; // input levels
     std::vector<uint32_t> input_perm;   // input permutation so that ntk compute the npn-class
+    std::vector<uint32_t> gate_levels{}; // levels of the nodes of ntk (computed on first use if empty)
   };
 
   aqfp_db(
@@ -120,12 +127,17 @@ public:
   template<typename ComparisonFn>
   mig_structure get_best_replacement( uint64_t f, std::vector<uint32_t> _levels, std::vector<bool> _is_const, ComparisonFn&& comparison_fn )
   {
+    if ( binary.data == nullptr && index_outdated )
+    {
+      build_index();
+    }
+
     /* find the npn class for the function */
-    auto tmp = npndb( f );
-    auto& npntt = std::get<0>( tmp );
-    auto& npnperm = std::get<2>( tmp );
+    auto const npn = npn_transform( f );
+    auto const npntt = npn_class_of( npn );
 
-    if ( db[npntt].empty() )
+    auto const [begin, end] = entry_range( npntt );
+    if ( begin == end )
     {
       assert( false );
       return { {}, {}, false };
@@ -136,20 +148,17 @@ public:
     std::vector<bool> is_const( _levels.size() );
     for ( auto i = 0u; i < levels.size(); i++ )
     {
-      levels[i] = _levels[npnperm[i]];
-      is_const[i] = _is_const[npnperm[i]];
+      levels[i] = _levels[npn_perm_of( npn, i )];
+      is_const[i] = _is_const[npn_perm_of( npn, i )];
     }
 
     double best_cost = std::numeric_limits<double>::infinity();
     uint32_t best_lev = std::numeric_limits<uint32_t>::max();
-    replacement best = db[npntt].begin()->second;
     uint32_t best_ind = 0;
 
-    uint32_t temp_ind = 0;
-    for ( auto it = db[npntt].begin(); it != db[npntt].end(); it++ )
+    for ( auto ind = begin; ind < end; ind++ )
     {
-      const auto& lvl_cfg = it->first;
-      const auto& r = it->second;
+      auto const lvl_cfg = entry_lvl_cfg( ind );
 
       uint32_t max_lev = 0u;
       for ( auto i = 0u; i < levels.size(); i++ )
@@ -167,26 +176,215 @@ public:
         }
       }
 
-      double cost = buffer_count * splitters.at( 1u ) + r.cost;
+      double cost = buffer_count * splitters.at( 1u ) + entry_cost( ind );
 
       if ( comparison_fn( { cost, max_lev }, { best_cost, best_lev } ) )
       {
         best_cost = cost;
         best_lev = max_lev;
-        best = r;
-        best_ind = temp_ind;
+        best_ind = ind - begin;
       }
-      temp_ind++;
     }
 
     usage_stats[{ npntt, best_ind }]++;
-    return compute_replacement_structure( best, f );
+
+    /* the structure only depends on the entry and on the function */
+    auto const key = ( uint64_t( begin + best_ind ) << 16u ) | ( f & 0xffff );
+    auto it = structures.find( key );
+    if ( it == structures.end() )
+    {
+      if ( structures.size() >= max_num_structures )
+      {
+        structures.clear();
+      }
+      it = structures.emplace( key, compute_replacement_structure( entry_replacement( begin + best_ind ), f ) ).first;
+    }
+    return it->second;
   }
 
   /*! \brief Load database from input stream `is`. */
   void load_db( std::istream& is, uint32_t version = 1u )
   {
+    materialize_binary_db();
     load_db( is, db, version );
+    index_outdated = true;
+  }
+
+  /*! \brief Save the database in binary format to output stream `os`.
+   *
+   * Besides the database entries, the binary format contains the NPN
+   * transformation of all 4-input functions and the levels of the nodes of
+   * each entry, which are otherwise computed when first needed. All the
+   * sections have a fixed layout and are 8-byte aligned, such that the
+   * database can be loaded directly from a memory-mapped file using
+   * `load_binary_db( data, size )`. The multi-byte fields use the byte
+   * order of the host.
+   *
+   * Format (all the offsets are relative to the start of the data):
+   * - header: magic `AQFPDB` followed by two null bytes, then as `uint32_t`
+   *   the format version, number of classes, number of entries, and the
+   *   size (in bytes) of the DAG pool
+   * - NPN table: 65536 `uint32_t`, the NPN transformation of each 4-input
+   *   function (bits 0-15: representative, bits 16-20: phase, bits 21-28:
+   *   permutation with 2 bits per input, bit 31: valid)
+   * - class index: for each NPN class in increasing order, the class as
+   *   `uint64_t`, the index of its first entry and its number of entries as
+   *   `uint32_t`
+   * - entries: sorted by class and level configuration, each with the level
+   *   configuration as `uint64_t`, the cost as `double`, and the offset of
+   *   its DAG in the DAG pool as `uint64_t`
+   * - DAG pool: for each entry, as `uint8_t`, the number of inputs followed
+   *   by the input permutation, the number of gates, the number of input
+   *   slots, the zero input, for each gate the number of fanins followed by
+   *   the fanins, and then the levels of all the nodes as `uint32_t`
+   */
+  void save_binary_db( std::ostream& os )
+  {
+    if ( binary.data != nullptr )
+    {
+      os.write( binary.data, dag_pool_pos( binary.num_classes, binary.num_entries ) + binary.dag_pool_size );
+      return;
+    }
+
+    if ( index_outdated )
+    {
+      build_index();
+    }
+
+    std::vector<std::pair<uint64_t, std::map<uint64_t, replacement>*>> classes;
+    for ( auto& [npn_class, entries_for_npn_class] : db )
+    {
+      if ( !entries_for_npn_class.empty() )
+        classes.emplace_back( npn_class, &entries_for_npn_class );
+    }
+    std::sort( classes.begin(), classes.end() );
+
+    std::vector<char> class_index, entry_list, dag_pool;
+    uint32_t num_entries = 0u;
+    for ( auto const& [npn_class, entries_for_npn_class] : classes )
+    {
+      append_binary( class_index, npn_class );
+      append_binary( class_index, num_entries );
+      append_binary( class_index, uint32_t( entries_for_npn_class->size() ) );
+
+      for ( auto& [lvl_cfg, r] : *entries_for_npn_class )
+      {
+        append_binary( entry_list, lvl_cfg );
+        append_binary( entry_list, r.cost );
+        append_binary( entry_list, uint64_t( dag_pool.size() ) );
+        encode_binary_entry( dag_pool, r );
+        ++num_entries;
+      }
+    }
+    dag_pool.resize( ( dag_pool.size() + 7u ) & ~std::size_t( 7u ) );
+
+    std::vector<char> data;
+    data.insert( data.end(), binary_magic, binary_magic + 8 );
+    append_binary( data, binary_version );
+    append_binary( data, uint32_t( classes.size() ) );
+    append_binary( data, num_entries );
+    append_binary( data, uint32_t( dag_pool.size() ) );
+    for ( auto f = 0u; f < ( 1u << 16u ); ++f )
+    {
+      append_binary( data, npn_transform( f ) );
+    }
+    data.insert( data.end(), class_index.begin(), class_index.end() );
+    data.insert( data.end(), entry_list.begin(), entry_list.end() );
+    data.insert( data.end(), dag_pool.begin(), dag_pool.end() );
+
+    os.write( data.data(), data.size() );
+  }
+
+  /*! \brief Load database in binary format from input stream `is`.
+   *
+   * \return false if the data is not a valid binary database
+   */
+  bool load_binary_db( std::istream& is )
+  {
+    std::vector<char> data{ std::istreambuf_iterator<char>( is ), std::istreambuf_iterator<char>() };
+    if ( !db.empty() || binary.data != nullptr )
+    {
+      return load_binary_db( data.data(), data.size() );
+    }
+
+    /* the database is used in place, so it keeps the data */
+    binary_storage = std::move( data );
+    if ( !load_binary_db( binary_storage.data(), binary_storage.size() ) )
+    {
+      binary_storage = {};
+      return false;
+    }
+    return true;
+  }
+
+  /*! \brief Load database in binary format from `size` bytes at `data`.
+   *
+   * If the database is empty, the data is used in place, without copying:
+   * lookups read the NPN table, the class index, and the entries directly
+   * from `data`, and only the DAGs of the selected replacements are
+   * decoded. In this case, `data` (for example, a memory-mapped file) must
+   * remain valid as long as the database is used. Otherwise, the entries
+   * are merged with the current ones, keeping the cheapest replacement for
+   * each class and level configuration, as in `load_db`.
+   *
+   * \return false if the data is not a valid binary database
+   */
+  bool load_binary_db( char const* data, std::size_t size )
+  {
+    std::size_t pos = 0u;
+    uint32_t version, num_classes, num_entries, dag_pool_size;
+    if ( size < header_size || std::memcmp( data, binary_magic, 8 ) != 0 )
+      return false;
+    pos = 8u;
+    read_binary( data, pos, version );
+    read_binary( data, pos, num_classes );
+    read_binary( data, pos, num_entries );
+    read_binary( data, pos, dag_pool_size );
+    if ( version != binary_version )
+      return false;
+
+    auto const class_index_pos = npn_table_pos + ( std::size_t( 1u ) << 16u ) * sizeof( uint32_t );
+    auto const entry_list_pos = class_index_pos + std::size_t( num_classes ) * class_record_size;
+    auto const pool_pos = dag_pool_pos( num_classes, num_entries );
+    if ( size < pool_pos + dag_pool_size )
+      return false;
+
+    /* validate the index and the DAGs without decoding them */
+    pos = class_index_pos;
+    for ( auto c = 0u; c < num_classes; ++c )
+    {
+      uint64_t npn_class;
+      uint32_t first, count;
+      read_binary( data, pos, npn_class );
+      read_binary( data, pos, first );
+      read_binary( data, pos, count );
+      if ( uint64_t( first ) + count > num_entries )
+        return false;
+      if ( c > 0u && npn_class <= binary_class_at( data, c - 1u ) )
+        return false;
+    }
+    pos = entry_list_pos;
+    for ( auto e = 0u; e < num_entries; ++e )
+    {
+      uint64_t dag_offset;
+      pos += sizeof( uint64_t ) + sizeof( double );
+      read_binary( data, pos, dag_offset );
+      if ( dag_offset >= dag_pool_size || !is_binary_entry( data + pool_pos + dag_offset, dag_pool_size - dag_offset ) )
+        return false;
+    }
+
+    if ( db.empty() && binary.data == nullptr )
+    {
+      binary = { data, num_classes, num_entries, dag_pool_size };
+      decoded.clear();
+      structures.clear();
+      return true;
+    }
+
+    materialize_binary_db();
+    merge_binary_db( { data, num_classes, num_entries, dag_pool_size } );
+    index_outdated = true;
+    return true;
   }
 
   /*! \brief Load database from input stream `is`. */
@@ -257,9 +455,19 @@ public:
   template<typename Fn>
   void for_each_db_entry( Fn&& func )
   {
-    for ( const auto& [npn_class, entries_for_npn_class] : db )
+    for ( auto c = 0u; c < binary.num_classes; ++c )
+    {
+      auto const npn_class = binary_class_at( binary.data, c );
+      auto const [begin, end] = binary_class_range( c );
+      for ( auto ind = begin; ind < end; ++ind )
+      {
+        func( npn_class, compute_replacement_structure( entry_replacement( ind ), npn_class ), entry_cost( ind ) );
+      }
+    }
+
+    for ( auto& [npn_class, entries_for_npn_class] : db )
     {
-      for ( const auto& [depth_config, replacement] : entries_for_npn_class )
+      for ( auto& [depth_config, replacement] : entries_for_npn_class )
       {
         func( npn_class, compute_replacement_structure( replacement, npn_class ), replacement.cost );
       }
@@ -267,6 +475,24 @@ public:
   }
 
 private:
+  static constexpr char binary_magic[8] = { 'A', 'Q', 'F', 'P', 'D', 'B', '\0', '\0' };
+  static constexpr uint32_t binary_version = 1u;
+  static constexpr std::size_t header_size = 24u;
+  static constexpr uint32_t npn_valid = 1u << 31u;
+  static constexpr std::size_t npn_table_pos = header_size;
+  static constexpr std::size_t class_record_size = 16u;
+  static constexpr std::size_t entry_record_size = 24u;
+  static constexpr std::size_t max_num_structures = 1u << 16u;
+
+  /* database in binary format, used in place (see `load_binary_db`) */
+  struct binary_db
+  {
+    char const* data{ nullptr };
+    uint32_t num_classes{ 0u };
+    uint32_t num_entries{ 0u };
+    uint32_t dag_pool_size{ 0u };
+  };
+
   std::unordered_map<uint32_t, double> gate_costs;
   std::unordered_map<uint32_t, double> splitters;
   std::unordered_map<uint64_t, std::map<uint64_t, replacement>> db;
@@ -274,6 +500,369 @@ private:
   dag_aqfp_cost_and_depths<Ntk> cc;
   npn_cache npndb;
 
+  /* flat index of `db`: for each 4-input NPN class, the range of its entries
+     sorted by level configuration */
+  bool index_outdated{ true };
+  std::vector<std::pair<uint64_t, replacement*>> entries;
+  std::vector<std::pair<uint32_t, uint32_t>> class_ranges;
+  std::vector<uint32_t> npn_table; // packed NPN transformations of the 4-input functions
+  std::unordered_map<uint64_t, mig_structure> structures; // bounded by `max_num_structures`
+
+  binary_db binary;
+  std::vector<char> binary_storage;                     // owns the data of `binary` if loaded from a stream
+  std::unordered_map<uint32_t, replacement> decoded; // decoded entries of `binary`
+
+  static std::size_t dag_pool_pos( uint32_t num_classes, uint32_t num_entries )
+  {
+    return npn_table_pos + ( std::size_t( 1u ) << 16u ) * sizeof( uint32_t ) + std::size_t( num_classes ) * class_record_size + std::size_t( num_entries ) * entry_record_size;
+  }
+
+  static std::size_t class_record_pos( uint32_t c )
+  {
+    return npn_table_pos + ( std::size_t( 1u ) << 16u ) * sizeof( uint32_t ) + std::size_t( c ) * class_record_size;
+  }
+
+  std::size_t entry_record_pos( uint32_t ind ) const
+  {
+    return class_record_pos( binary.num_classes ) + std::size_t( ind ) * entry_record_size;
+  }
+
+  static uint64_t binary_class_at( char const* data, uint32_t c )
+  {
+    uint64_t npn_class;
+    auto pos = class_record_pos( c );
+    read_binary( data, pos, npn_class );
+    return npn_class;
+  }
+
+  std::pair<uint32_t, uint32_t> binary_class_range( uint32_t c ) const
+  {
+    uint32_t first, count;
+    auto pos = class_record_pos( c ) + sizeof( uint64_t );
+    read_binary( binary.data, pos, first );
+    read_binary( binary.data, pos, count );
+    return { first, first + count };
+  }
+
+  /* range of the entries of the NPN class `npntt` */
+  std::pair<uint32_t, uint32_t> entry_range( uint32_t npntt ) const
+  {
+    if ( binary.data == nullptr )
+    {
+      return class_ranges[npntt];
+    }
+
+    /* binary search in the sorted class index */
+    uint32_t lo = 0u, hi = binary.num_classes;
+    while ( lo < hi )
+    {
+      auto const mid = lo + ( hi - lo ) / 2u;
+      if ( binary_class_at( binary.data, mid ) < npntt )
+        lo = mid + 1u;
+      else
+        hi = mid;
+    }
+    if ( lo == binary.num_classes || binary_class_at( binary.data, lo ) != npntt )
+    {
+      return { 0u, 0u };
+    }
+    return binary_class_range( lo );
+  }
+
+  uint64_t entry_lvl_cfg( uint32_t ind ) const
+  {
+    if ( binary.data == nullptr )
+    {
+      return entries[ind].first;
+    }
+
+    uint64_t lvl_cfg;
+    auto pos = entry_record_pos( ind );
+    read_binary( binary.data, pos, lvl_cfg );
+    return lvl_cfg;
+  }
+
+  double entry_cost( uint32_t ind ) const
+  {
+    if ( binary.data == nullptr )
+    {
+      return entries[ind].second->cost;
+    }
+
+    double cost;
+    auto pos = entry_record_pos( ind ) + sizeof( uint64_t );
+    read_binary( binary.data, pos, cost );
+    return cost;
+  }
+
+  replacement& entry_replacement( uint32_t ind )
+  {
+    if ( binary.data == nullptr )
+    {
+      return *entries[ind].second;
+    }
+
+    auto it = decoded.find( ind );
+    if ( it == decoded.end() )
+    {
+      it = decoded.emplace( ind, decode_binary_record( binary, ind ) ).first;
+    }
+    return it->second;
+  }
+
+  /* decodes entry `ind` of a validated binary database */
+  static replacement decode_binary_record( binary_db const& bin, uint32_t ind )
+  {
+    uint64_t lvl_cfg, dag_offset;
+    replacement r;
+    auto pos = class_record_pos( bin.num_classes ) + std::size_t( ind ) * entry_record_size;
+    read_binary( bin.data, pos, lvl_cfg );
+    read_binary( bin.data, pos, r.cost );
+    read_binary( bin.data, pos, dag_offset );
+
+    [[maybe_unused]] auto const valid = decode_binary_entry( bin.data + dag_pool_pos( bin.num_classes, bin.num_entries ) + dag_offset, bin.dag_pool_size - dag_offset, lvl_cfg, r );
+    assert( valid );
+    return r;
+  }
+
+  /* merges the entries of a validated binary database into `db` */
+  void merge_binary_db( binary_db const& bin )
+  {
+    for ( auto c = 0u; c < bin.num_classes; ++c )
+    {
+      uint32_t first, count;
+      auto pos = class_record_pos( c ) + sizeof( uint64_t );
+      read_binary( bin.data, pos, first );
+      read_binary( bin.data, pos, count );
+
+      auto& entries_for_npn_class = db[binary_class_at( bin.data, c )];
+      for ( auto ind = first; ind < first + count; ++ind )
+      {
+        uint64_t lvl_cfg;
+        auto entry_pos = class_record_pos( bin.num_classes ) + std::size_t( ind ) * entry_record_size;
+        read_binary( bin.data, entry_pos, lvl_cfg );
+
+        auto r = decode_binary_record( bin, ind );
+        if ( !entries_for_npn_class.count( lvl_cfg ) || entries_for_npn_class[lvl_cfg].cost > r.cost )
+        {
+          entries_for_npn_class[lvl_cfg] = std::move( r );
+        }
+      }
+    }
+  }
+
+  /* copies the binary database used in place into `db` */
+  void materialize_binary_db()
+  {
+    if ( binary.data == nullptr )
+    {
+      return;
+    }
+
+    auto const bin = binary;
+    binary = {};
+    merge_binary_db( bin );
+    decoded.clear();
+    structures.clear();
+    binary_storage = {};
+    index_outdated = true;
+  }
+
+  void build_index()
+  {
+    entries.clear();
+    class_ranges.assign( 1u << 16u, { 0u, 0u } );
+    structures.clear();
+
+    std::vector<uint64_t> classes;
+    for ( auto const& [npn_class, entries_for_npn_class] : db )
+    {
+      if ( npn_class < ( 1u << 16u ) )
+        classes.emplace_back( npn_class );
+    }
+    std::sort( classes.begin(), classes.end() );
+
+    for ( auto const& npn_class : classes )
+    {
+      auto const begin = static_cast<uint32_t>( entries.size() );
+      for ( auto& [lvl_cfg, r] : db[npn_class] )
+      {
+        entries.emplace_back( lvl_cfg, &r );
+      }
+      class_ranges[npn_class] = { begin, static_cast<uint32_t>( entries.size() ) };
+    }
+
+    index_outdated = false;
+  }
+
+  /* NPN transformation of the 4-input function `func`, packed as in the binary format */
+  uint32_t npn_transform( uint64_t func )
+  {
+    if ( binary.data != nullptr )
+    {
+      uint32_t npn;
+      auto pos = npn_table_pos + ( func & 0xffff ) * sizeof( uint32_t );
+      read_binary( binary.data, pos, npn );
+      if ( ( npn & npn_valid ) != 0u )
+      {
+        return npn;
+      }
+    }
+
+    if ( npn_table.empty() )
+    {
+      npn_table.resize( 1u << 16u, 0u );
+    }
+
+    auto& npn = npn_table[func & 0xffff];
+    if ( ( npn & npn_valid ) == 0u )
+    {
+      auto const [npntt, npn_inv, npnperm] = npndb( func & 0xffff );
+      npn = npn_valid | static_cast<uint32_t>( npntt & 0xffff ) | ( ( npn_inv & 0x1f ) << 16u );
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        npn |= static_cast<uint32_t>( npnperm[i] & 0x3 ) << ( 21u + 2u * i );
+      }
+    }
+    return npn;
+  }
+
+  static uint32_t npn_class_of( uint32_t npn )
+  {
+    return npn & 0xffff;
+  }
+
+  static uint32_t npn_perm_of( uint32_t npn, uint32_t i )
+  {
+    return ( npn >> ( 21u + 2u * i ) ) & 0x3;
+  }
+
+  std::vector<uint32_t> const& gate_levels_of( replacement& rep )
+  {
+    if ( rep.gate_levels.empty() )
+    {
+      std::vector<uint32_t> levs( 4u );
+      for ( auto i = 0u; i < 4u; i++ )
+      {
+        levs[i] = rep.input_levels[rep.input_perm[i]];
+      }
+      rep.gate_levels = cc( rep.ntk, levs ).second;
+    }
+    return rep.gate_levels;
+  }
+
+  template<typename T>
+  static void append_binary( std::vector<char>& data, T const& value )
+  {
+    char bytes[sizeof( T )];
+    std::memcpy( bytes, &value, sizeof( T ) );
+    data.insert( data.end(), bytes, bytes + sizeof( T ) );
+  }
+
+  template<typename T>
+  static void read_binary( char const* data, std::size_t& pos, T& value )
+  {
+    std::memcpy( &value, data + pos, sizeof( T ) );
+    pos += sizeof( T );
+  }
+
+  void encode_binary_entry( std::vector<char>& data, replacement& rep )
+  {
+    auto const& gate_levels = gate_levels_of( rep );
+    auto const& ntk = rep.ntk;
+
+    data.push_back( static_cast<char>( rep.input_perm.size() ) );
+    for ( auto const& p : rep.input_perm )
+      data.push_back( static_cast<char>( p ) );
+
+    assert( ntk.nodes.size() < 256u );
+    data.push_back( static_cast<char>( ntk.num_gates() ) );
+    data.push_back( static_cast<char>( ntk.input_slots.size() ) );
+    data.push_back( static_cast<char>( ntk.zero_input ) );
+    for ( auto i = 0u; i < ntk.num_gates(); ++i )
+    {
+      data.push_back( static_cast<char>( ntk.nodes[i].size() ) );
+      for ( auto const& fi : ntk.nodes[i] )
+        data.push_back( static_cast<char>( fi ) );
+    }
+
+    assert( gate_levels.size() == ntk.nodes.size() );
+    for ( auto const& l : gate_levels )
+      append_binary( data, l );
+  }
+
+  /* checks that a DAG of the DAG pool fits in `size` bytes, has 4 leaves, and has valid fanins */
+  static bool is_binary_entry( char const* data, std::size_t size )
+  {
+    std::size_t pos = 0u;
+    auto const next = [&]() -> uint32_t {
+      return pos < size ? static_cast<uint8_t>( data[pos++] ) : 0u;
+    };
+
+    /* replacements are computed for functions of 4 variables */
+    auto const num_leaves = next();
+    if ( num_leaves != 4u )
+      return false;
+    for ( auto i = 0u; i < num_leaves; ++i )
+    {
+      if ( next() >= num_leaves )
+        return false;
+    }
+
+    auto const num_gates = next();
+    auto const num_inputs = next();
+    if ( num_gates + num_inputs >= 256u )
+      return false;
+    next(); /* zero input */
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      auto const num_fanins = next();
+      for ( auto j = 0u; j < num_fanins; ++j )
+      {
+        if ( next() >= num_gates + num_inputs )
+          return false;
+      }
+    }
+
+    return pos + ( num_gates + num_inputs ) * sizeof( uint32_t ) <= size;
+  }
+
+  static bool decode_binary_entry( char const* data, std::size_t size, uint64_t lvl_cfg, replacement& rep )
+  {
+    std::size_t pos = 0u;
+    auto const next = [&]() -> uint32_t {
+      return pos < size ? static_cast<uint8_t>( data[pos++] ) : 0u;
+    };
+
+    auto const num_leaves = next();
+    for ( auto i = 0u; i < num_leaves; ++i )
+      rep.input_perm.emplace_back( next() );
+    rep.input_levels = lvl_cfg_to_vec( lvl_cfg, num_leaves );
+
+    auto const num_gates = next();
+    auto const num_inputs = next();
+    rep.ntk.zero_input = next();
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      rep.ntk.nodes.emplace_back();
+      auto const num_fanins = next();
+      for ( auto j = 0u; j < num_fanins; ++j )
+        rep.ntk.nodes.back().emplace_back( next() );
+    }
+    for ( auto i = 0u; i < num_inputs; ++i )
+    {
+      rep.ntk.nodes.emplace_back();
+      rep.ntk.input_slots.emplace_back( rep.ntk.nodes.size() - 1 );
+    }
+
+    if ( pos + rep.ntk.nodes.size() * sizeof( uint32_t ) > size )
+      return false;
+    rep.gate_levels.resize( rep.ntk.nodes.size() );
+    for ( auto& l : rep.gate_levels )
+      read_binary( data, pos, l );
+    return true;
+  }
+
   std::pair<bool, std::vector<uint32_t>> inverter_config_for_func( const std::vector<uint64_t>& input_tt, const Ntk& net, uint64_t func )
   {
     uint32_t num_inputs = net.input_slots.size();
@@ -355,26 +944,19 @@ private:
     return {};
   }
 
-  mig_structure compute_replacement_structure( const replacement& rep, uint64_t func )
+  mig_structure compute_replacement_structure( replacement& rep, uint64_t func )
   {
-    std::vector<uint32_t> levs( 4u );
-    for ( auto i = 0u; i < 4u; i++ )
-    {
-      levs[i] = rep.input_levels[rep.input_perm[i]];
-    }
-
-    auto [new_cost, gate_levels] = cc( rep.ntk, levs );
-    (void)new_cost;
+    auto const& gate_levels = gate_levels_of( rep );
 
-    auto [npntt, npn_inv, npnperm] = npndb( func );
+    auto const npn = npn_transform( func );
 
     std::vector<uint32_t> ind = { 0u, 1u, 2u, 3u };
 
     std::vector<uint32_t> ind_func_from_npn = {
-        ind[npnperm[0]],
-        ind[npnperm[1]],
-        ind[npnperm[2]],
-        ind[npnperm[3]] };
+        ind[npn_perm_of( npn, 0 )],
+        ind[npn_perm_of( npn, 1 )],
+        ind[npn_perm_of( npn, 2 )],
+        ind[npn_perm_of( npn, 3 )] };
 
     std::vector<uint32_t> ind_func_from_dag = {
         ind_func_from_npn[rep.input_perm[0]],
@@ -35,12 +35,14 @@
 
 #include "../../traits.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/parallel_utils.hpp"
 #include "../../views/fanout_view.hpp"
 #include "../../views/topo_view.hpp"
 #include "aqfp_assumptions.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -101,6 +103,17 @@ struct buffer_insertion_params
 
   /*! \brief The maximum size of a chunk. */
   uint32_t max_chunk_size{ 100u };
+
+  /*! \brief Number of threads.
+   *
+   * With more than one thread, `ASAP` and `ALAP_depth` compute the levels of
+   * independent nodes concurrently, wave by wave over the network DAG, and
+   * chunked movement evaluates all chunks concurrently and commits the
+   * improving moves which do not interfere with each other. The level
+   * assignment obtained by scheduling is the same as with one thread, while
+   * the optimized one may differ.
+   */
+  uint32_t num_threads{ 1u };
 };
 
 /*! \brief Insert buffers and splitters for the AQFP technology.
@@ -173,6 +186,17 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
 
+private:
+  struct fanout_information
+  {
+    uint32_t relative_depth{ 0u };
+    std::list<node> fanouts;
+    std::list<uint32_t> extrefs; // IDs of POs (as in `_ntk.foreach_po`)
+    uint32_t num_edges{ 0u };
+  };
+  using fanouts_by_level = std::list<fanout_information>;
+
+public:
   explicit buffer_insertion( Ntk const& ntk, buffer_insertion_params const& ps = {} )
       : _ntk( ntk ), _ps( ps ), _levels( _ntk ), _po_levels( _ntk.num_pos(), 0u ), _timeframes( _ntk ), _fanouts( _ntk ), _num_buffers( _ntk )
   {
@@ -372,8 +396,11 @@ private:
   uint32_t count_buffers( node const& n ) const
   {
     assert( !_outdated && "Please call `update_fanout_info()` first." );
-    auto const& fo_infos = _fanouts[n];
+    return count_buffers( n, _fanouts[n] );
+  }
 
+  uint32_t count_buffers( node const& n, fanouts_by_level const& fo_infos ) const
+  {
     if ( _ntk.fanout_size( n ) == 0u ) /* dangling */
     {
       if ( !_ntk.is_pi( n ) )
@@ -480,8 +507,11 @@ private:
   void insert_fanout( node const& n, node const& fanout )
   {
     assert( _levels[fanout] > _levels[n] );
-    auto const rd = _levels[fanout] - _levels[n];
-    auto& fo_infos = _fanouts[n];
+    insert_fanout( _fanouts[n], _levels[fanout] - _levels[n], fanout );
+  }
+
+  void insert_fanout( fanouts_by_level& fo_infos, uint32_t rd, node const& fanout ) const
+  {
     for ( auto it = fo_infos.begin(); it != fo_infos.end(); ++it )
     {
       if ( it->relative_depth == rd )
@@ -502,8 +532,11 @@ private:
   void insert_extref( node const& n, uint32_t idx )
   {
     assert( _po_levels[idx] > _levels[n] );
-    auto const rd = _po_levels[idx] - _levels[n];
-    auto& fo_infos = _fanouts[n];
+    insert_extref( _fanouts[n], _po_levels[idx] - _levels[n], idx );
+  }
+
+  void insert_extref( fanouts_by_level& fo_infos, uint32_t rd, uint32_t idx ) const
+  {
     for ( auto it = fo_infos.begin(); it != fo_infos.end(); ++it )
     {
       if ( it->relative_depth == rd )
@@ -524,8 +557,12 @@ private:
   template<bool verify = false>
   bool count_edges( node const& n )
   {
-    auto& fo_infos = _fanouts[n];
+    return count_edges<verify>( n, _fanouts[n] );
+  }
 
+  template<bool verify = false>
+  bool count_edges( node const& n, fanouts_by_level& fo_infos ) const
+  {
     if ( fo_infos.size() == 0u || ( fo_infos.size() == 1u && fo_infos.front().num_edges == 1u ) )
     {
       return true;
@@ -649,11 +686,15 @@ public:
   {
     _depth = 0;
     _levels.reset( 0 );
+    if ( _ps.num_threads > 1u )
+    {
+      compute_levels_ASAP_parallel();
+    }
     _ntk.incr_trav_id();
 
     _ntk.foreach_po( [&]( auto const& f, auto i ) {
       auto const no = _ntk.get_node( f );
-      _po_levels[i] = compute_levels_ASAP( no ) + num_splitter_levels( no ) + 1;
+      _po_levels[i] = ( _ps.num_threads > 1u ? _levels[no] : compute_levels_ASAP( no ) ) + num_splitter_levels( no ) + 1;
       if ( ( _po_levels[i] - 1 ) % _ps.assume.num_phases != 0 ) // phase alignment
       {
         _po_levels[i] += _ps.assume.num_phases - ( ( _po_levels[i] - 1 ) % _ps.assume.num_phases );
@@ -771,13 +812,33 @@ public:
     /* compute ALAP */
     _depth = std::numeric_limits<uint32_t>::max() - 1;
     uint32_t min_level = std::numeric_limits<uint32_t>::max() - 1;
-    topo_ntk.foreach_node_reverse( [&]( auto const& n ) {
-      if ( !_ntk.is_constant( n ) && _ntk.fanout_size( n ) > 0 )
+    if ( _ps.num_threads > 1u )
+    {
+      /* nodes in the same wave only depend on the levels of the previous waves */
+      std::vector<uint32_t> min_levels( _ps.num_threads, min_level );
+      for ( auto const& wave : compute_waves<true>( topo_ntk ) )
       {
-        compute_levels_ALAP_depth( f_ntk, n );
-        min_level = std::min( min_level, _levels[n] );
+        parallel_for( _ps.num_threads, wave.size(), [&]( uint64_t i, uint32_t thread_id ) {
+          auto const n = wave[i];
+          if ( !_ntk.is_constant( n ) && _ntk.fanout_size( n ) > 0 )
+          {
+            compute_levels_ALAP_depth( f_ntk, n );
+            min_levels[thread_id] = std::min( min_levels[thread_id], _levels[n] );
+          }
+        } );
       }
-    } );
+      min_level = *std::min_element( min_levels.begin(), min_levels.end() );
+    }
+    else
+    {
+      topo_ntk.foreach_node_reverse( [&]( auto const& n ) {
+        if ( !_ntk.is_constant( n ) && _ntk.fanout_size( n ) > 0 )
+        {
+          compute_levels_ALAP_depth( f_ntk, n );
+          min_level = std::min( min_level, _levels[n] );
+        }
+      } );
+    }
 
     /* move everything down by `delta` */
     uint32_t delta = min_level;
@@ -896,6 +957,77 @@ private:
     return _levels[n] = level + 1;
   }
 
+  /* Same levels as `compute_levels_ASAP` for all the nodes in the TFI of the POs */
+  void compute_levels_ASAP_parallel()
+  {
+    topo_view<Ntk> topo_ntk{ _ntk };
+    for ( auto const& wave : compute_waves<false>( topo_ntk ) )
+    {
+      parallel_for( _ps.num_threads, wave.size(), [&]( uint64_t i, uint32_t ) {
+        auto const n = wave[i];
+        if ( _ntk.is_constant( n ) )
+        {
+          _levels[n] = 0;
+          return;
+        }
+        else if ( _ntk.is_pi( n ) )
+        {
+          _levels[n] = _ps.assume.ci_phases[0];
+          return;
+        }
+
+        uint32_t level{ 0 };
+        _ntk.foreach_fanin( n, [&]( auto const& fi ) {
+          auto const ni = _ntk.get_node( fi );
+          if ( !_ntk.is_constant( ni ) )
+          {
+            level = std::max( level, _levels[ni] + num_splitter_levels( ni ) );
+          }
+        } );
+        _levels[n] = level + 1;
+      } );
+    }
+  }
+
+  /* Partition the nodes of `topo_ntk` into waves, such that the nodes of a wave
+   * only depend on nodes of previous waves: on their fanins if `reverse` is
+   * false, on their fanouts otherwise. */
+  template<bool reverse>
+  std::vector<std::vector<node>> compute_waves( topo_view<Ntk> const& topo_ntk ) const
+  {
+    node_map<uint32_t, Ntk> wave( _ntk, 0u );
+    uint32_t num_waves{ 0u };
+    auto const update_wave = [&]( auto const& n ) {
+      if constexpr ( reverse )
+      {
+        num_waves = std::max( num_waves, wave[n] + 1 );
+        _ntk.foreach_fanin( n, [&]( auto const& fi ) {
+          auto const ni = _ntk.get_node( fi );
+          wave[ni] = std::max( wave[ni], wave[n] + 1 );
+        } );
+      }
+      else
+      {
+        _ntk.foreach_fanin( n, [&]( auto const& fi ) {
+          auto const ni = _ntk.get_node( fi );
+          if ( !_ntk.is_constant( ni ) )
+            wave[n] = std::max( wave[n], wave[ni] + 1 );
+        } );
+        num_waves = std::max( num_waves, wave[n] + 1 );
+      }
+    };
+    if constexpr ( reverse )
+      topo_ntk.foreach_node_reverse( update_wave );
+    else
+      topo_ntk.foreach_node( update_wave );
+
+    std::vector<std::vector<node>> waves( num_waves );
+    topo_ntk.foreach_node( [&]( auto const& n ) {
+      waves[wave[n]].emplace_back( n );
+    } );
+    return waves;
+  }
+
   bool is_acceptable_ci_lvl( uint32_t lvl ) const
   {
     if ( _ps.assume.balance_cios )
@@ -1346,9 +1478,13 @@ public:
     bool updated;
     do
     {
-      updated = find_and_move_chunks();
+      updated = _ps.num_threads > 1u ? move_chunks_parallel( false ) : find_and_move_chunks();
     } while ( updated && _ps.optimization_effort == buffer_insertion_params::until_sat );
-    single_gate_movement();
+
+    if ( _ps.num_threads > 1u )
+      move_chunks_parallel( true );
+    else
+      single_gate_movement();
   }
 
 #pragma region Chunked movement
@@ -1376,6 +1512,15 @@ private:
     int32_t benefits{ 0 };
   };
 
+  /* a level shift of all the members of a chunk and its effect on the fanout information */
+  struct chunk_move
+  {
+    int32_t shift{ 0 };
+    std::vector<uint32_t> pos{}; // POs shifted together with the chunk
+    std::vector<std::pair<node, fanouts_by_level>> fanouts{}; // updated fanout information of the affected nodes
+    int64_t gain{ 0 }; // number of saved buffers
+  };
+
   bool is_ignored( node const& n ) const
   {
     return _ntk.is_constant( n );
@@ -1422,32 +1567,37 @@ private:
 
   void single_gate_movement()
   {
+    count_buffers();
     _ntk.foreach_node( [&]( auto const& n ) {
       if ( is_ignored( n ) || is_fixed( n ) )
         return;
 
-      _ntk.incr_trav_id();
-      chunk c{ _ntk.trav_id() };
-      c.members.emplace_back( n );
-      _ntk.foreach_fanin( n, [&]( auto const& fi ) {
-        auto const ni = _ntk.get_node( fi );
-        if ( !is_ignored( ni )  )
-          c.input_interfaces.push_back( { n, ni } );
-      } );
-      auto const& fanout_info = _fanouts[n];
-      for ( auto it = fanout_info.begin(); it != fanout_info.end(); ++it )
-      {
-        for ( auto it2 = it->fanouts.begin(); it2 != it->fanouts.end(); ++it2 )
-          c.output_interfaces.push_back( { n, *it2 } );
-        for ( auto it2 = it->extrefs.begin(); it2 != it->extrefs.end(); ++it2 )
-          c.po_interfaces.push_back( { n, *it2 } );
-      }
-
+      auto c = single_gate_chunk( n );
       if ( !analyze_chunk_down( c ) )
         analyze_chunk_up( c );
     } );
   }
 
+  chunk single_gate_chunk( node const& n ) const
+  {
+    chunk c{ _ntk.trav_id() };
+    c.members.emplace_back( n );
+    _ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      auto const ni = _ntk.get_node( fi );
+      if ( !is_ignored( ni )  )
+        c.input_interfaces.push_back( { n, ni } );
+    } );
+    auto const& fanout_info = _fanouts[n];
+    for ( auto it = fanout_info.begin(); it != fanout_info.end(); ++it )
+    {
+      for ( auto it2 = it->fanouts.begin(); it2 != it->fanouts.end(); ++it2 )
+        c.output_interfaces.push_back( { n, *it2 } );
+      for ( auto it2 = it->extrefs.begin(); it2 != it->extrefs.end(); ++it2 )
+        c.po_interfaces.push_back( { n, *it2 } );
+    }
+    return c;
+  }
+
   void recruit( node const& n, chunk& c )
   {
     if ( _ntk.visited( n ) == c.id )
@@ -1610,8 +1760,42 @@ private:
 
   bool analyze_chunk_down( chunk c )
   {
-    count_buffers();
-    auto buffers_before = num_buffers();
+    chunk_move move;
+    if ( !evaluate_chunk_down( c, move ) )
+      return false;
+
+    apply_move( c, move );
+    _start_id = _ntk.trav_id();
+    return true;
+  }
+
+  bool analyze_chunk_up( chunk c )
+  {
+    chunk_move move;
+    if ( !evaluate_chunk_up( c, move ) )
+      return false;
+
+    apply_move( c, move );
+    _start_id = _ntk.trav_id();
+    return true;
+  }
+
+  /* Evaluate moving chunk `c` down; returns true if the resulting `move` is legal and saves buffers */
+  bool evaluate_chunk_down( chunk c, chunk_move& move ) const
+  {
+    move = {};
+
+    /* copies of the fanout information of the input interfaces, modified by `pseudo_move` */
+    std::vector<std::pair<node, fanouts_by_level>> pseudo_fanouts;
+    auto const pseudo_fanout_info = [&]( node const& n ) -> fanouts_by_level& {
+      for ( auto& p : pseudo_fanouts )
+      {
+        if ( p.first == n )
+          return p.second;
+      }
+      pseudo_fanouts.emplace_back( n, _fanouts[n] );
+      return pseudo_fanouts.back().second;
+    };
 
     std::set<node> marked_oi;
     for ( auto oi : c.output_interfaces )
@@ -1626,15 +1810,16 @@ private:
     for ( auto ii : c.input_interfaces )
     {
       auto const rd = _levels[ii.c] - _levels[ii.o];
-      auto const lowest = lowest_spot( ii.o );
+      auto& fanout_info = pseudo_fanout_info( ii.o );
+      auto const lowest = lowest_spot( ii.o, fanout_info );
       if ( rd <= lowest )
       {
         c.slack = 0;
         break;
       }
       c.slack = std::min( c.slack, int32_t( rd - lowest ) );
-      pseudo_move( ii.o, ii.c, rd, lowest );
-      if ( _fanouts[ii.o].back().relative_depth == rd && _fanouts[ii.o].back().num_edges == 0 ) // `ii.c` is the last highest fanout of `ii.o`
+      pseudo_move( fanout_info, ii.c, rd, lowest );
+      if ( fanout_info.back().relative_depth == rd && fanout_info.back().num_edges == 0 ) // `ii.c` is the last highest fanout of `ii.o`
       {
         ++c.benefits;
       }
@@ -1685,60 +1870,21 @@ private:
       }
     }
 
-    if ( c.benefits > 0 && c.slack > 0 )
-    {
-      bool legal = true;
-
-      for ( auto m : c.members )
-        _levels[m] -= c.slack;
-      if ( !_ps.assume.balance_cios && c.slack >= _ps.assume.num_phases )
-      {
-        for ( auto poi : c.po_interfaces )
-          _po_levels[poi.o] -= c.slack;
-      }
-      for ( auto m : c.members )
-        update_fanout_info( m );
-      for ( auto ii : c.input_interfaces )
-        legal &= update_fanout_info<true>( ii.o );
-
-      _outdated = true;
-      if ( legal )
-        count_buffers();
-      if ( !legal || num_buffers() >= buffers_before )
-      {
-        /* UNDO */
-        for ( auto m : c.members )
-          _levels[m] += c.slack;
-        if ( !_ps.assume.balance_cios && c.slack >= _ps.assume.num_phases )
-        {
-          for ( auto poi : c.po_interfaces )
-            _po_levels[poi.o] += c.slack;
-        }
-        for ( auto m : c.members )
-          update_fanout_info( m );
-        for ( auto ii : c.input_interfaces )
-          update_fanout_info( ii.o );
-        _outdated = true;
-        return false;
-      }
+    if ( c.benefits <= 0 || c.slack <= 0 )
+      return false;
 
-      _start_id = _ntk.trav_id();
-      return true;
-    }
-    else
+    move.shift = -c.slack;
+    if ( !_ps.assume.balance_cios && c.slack >= _ps.assume.num_phases )
     {
-      /* reset fanout_infos of input_interfaces because num_edges may be modified by pseudo_move */
-      for ( auto ii : c.input_interfaces )
-        update_fanout_info( ii.o );
-      _outdated = true;
-      return false;
+      for ( auto poi : c.po_interfaces )
+        move.pos.emplace_back( poi.o );
     }
+    return evaluate_move( c, move );
   }
 
-  /* relative_depth of the lowest available spot in the fanout tree of n */
-  uint32_t lowest_spot( node const& n ) const
+  /* relative_depth of the lowest available spot in the fanout tree `fanout_info` of n */
+  uint32_t lowest_spot( node const& n, fanouts_by_level const& fanout_info ) const
   {
-    auto const& fanout_info = _fanouts[n];
     assert( fanout_info.size() );
 
     auto it = fanout_info.begin();
@@ -1777,11 +1923,10 @@ private:
     return fanout_info.back().relative_depth + 1;
   }
 
-  /* move `no`, which is a fanout of `n`, from `from_rd` to `to_rd` */
-  void pseudo_move( node const& n, node const& no, uint32_t from_rd, uint32_t to_rd )
+  /* move `no`, which is a fanout in `fanout_info`, from `from_rd` to `to_rd` */
+  void pseudo_move( fanouts_by_level& fanout_info, node const& no, uint32_t from_rd, uint32_t to_rd ) const
   {
     assert( from_rd > to_rd );
-    auto& fanout_info = _fanouts[n];
     auto it = fanout_info.begin();
     for ( ; it != fanout_info.end(); ++it )
     {
@@ -1816,8 +1961,11 @@ private:
     assert( false );
   }
 
-  bool analyze_chunk_up( chunk c )
+  /* Evaluate moving chunk `c` up; returns true if the resulting `move` is legal and saves buffers */
+  bool evaluate_chunk_up( chunk c, chunk_move& move ) const
   {
+    move = {};
+
     for ( auto ii : c.input_interfaces )
     {
       if ( _fanouts[ii.o].back().relative_depth == _levels[ii.c] - _levels[ii.o] ) // is highest fanout
@@ -1893,46 +2041,192 @@ private:
     if ( po_to_move.size() > 0 )
       c.slack -= c.slack % _ps.assume.num_phases;
 
-    if ( c.benefits > 0 && c.slack > 0 )
+    if ( c.benefits <= 0 || c.slack <= 0 )
+      return false;
+
+    move.shift = c.slack;
+    move.pos = po_to_move;
+    return evaluate_move( c, move );
+  }
+
+  /* Compute the fanout information of the nodes affected by shifting the members of `c`
+   * (and the POs in `move.pos`) by `move.shift` levels, without modifying the current state.
+   * Returns true if the resulting assignment is legal and saves buffers. */
+  bool evaluate_move( chunk const& c, chunk_move& move ) const
+  {
+    assert( !_outdated );
+
+    std::vector<node> members( c.members );
+    std::sort( members.begin(), members.end() );
+    auto const new_level = [&]( node const& n ) {
+      return int64_t( _levels[n] ) + ( std::binary_search( members.begin(), members.end(), n ) ? move.shift : 0 );
+    };
+    auto const new_po_level = [&]( uint32_t idx ) {
+      return int64_t( _po_levels[idx] ) + ( std::find( move.pos.begin(), move.pos.end(), idx ) != move.pos.end() ? move.shift : 0 );
+    };
+
+    /* the members and the input interfaces */
+    std::vector<node> affected( members );
+    for ( auto ii : c.input_interfaces )
     {
-      count_buffers();
-      bool legal = true;
-      auto buffers_before = num_buffers();
-
-      for ( auto m : c.members )
-        _levels[m] += c.slack;
-      for ( auto po : po_to_move )
-        _po_levels[po] += c.slack;
-      for ( auto m : c.members )
-        legal &= update_fanout_info<true>( m );
-      for ( auto ii : c.input_interfaces )
-        legal &= update_fanout_info<true>( ii.o );
-
-      _outdated = true;
-      if ( legal )
-        count_buffers();
-      if ( !legal || num_buffers() >= buffers_before )
-      {
-        /* UNDO */
-        for ( auto m : c.members )
-          _levels[m] -= c.slack;
-        for ( auto po : po_to_move )
-          _po_levels[po] -= c.slack;
-        for ( auto m : c.members )
-          update_fanout_info( m );
-        for ( auto ii : c.input_interfaces )
-          update_fanout_info( ii.o );
-        _outdated = true;
-        return false;
+      if ( std::find( affected.begin(), affected.end(), ii.o ) == affected.end() )
+        affected.emplace_back( ii.o );
+    }
+
+    int64_t buffers_before{ 0 }, buffers_after{ 0 };
+    for ( auto const& n : affected )
+    {
+      fanouts_by_level fo_infos;
+      auto const level_n = new_level( n );
+      for ( auto const& fo_info : _fanouts[n] )
+      {
+        for ( auto const& fo : fo_info.fanouts )
+        {
+          auto const level_fo = new_level( fo );
+          if ( level_fo <= level_n )
+            return false;
+          insert_fanout( fo_infos, uint32_t( level_fo - level_n ), fo );
+        }
+        for ( auto const& idx : fo_info.extrefs )
+        {
+          auto const level_po = new_po_level( idx );
+          if ( level_po <= level_n )
+            return false;
+          insert_extref( fo_infos, uint32_t( level_po - level_n ), idx );
+        }
       }
+      if ( !count_edges<true>( n, fo_infos ) )
+        return false;
 
-      _start_id = _ntk.trav_id();
-      return true;
+      buffers_before += _num_buffers[n];
+      buffers_after += count_buffers( n, fo_infos );
+      move.fanouts.emplace_back( n, std::move( fo_infos ) );
     }
-    else
+
+    move.gain = buffers_before - buffers_after;
+    return move.gain > 0;
+  }
+
+  /* Commit a move evaluated by `evaluate_move` */
+  void apply_move( chunk const& c, chunk_move& move )
+  {
+    for ( auto n : c.members )
+      _levels[n] += move.shift;
+    for ( auto po : move.pos )
+      _po_levels[po] += move.shift;
+    for ( auto& [n, fo_infos] : move.fanouts )
     {
-      return false;
+      _fanouts[n] = std::move( fo_infos );
+      _num_buffers[n] = count_buffers( n );
+    }
+  }
+
+  /* Chunked (or single-gate) movement in rounds: the chunks are formed from the
+   * seeds, evaluated concurrently, and the improving moves are committed in node
+   * order if they do not interfere with a move committed before in the same round.
+   * The chunks of the interfering moves, as well as the chunks next to a committed
+   * move, are formed again and re-evaluated in the next round. */
+  bool move_chunks_parallel( bool single_gates )
+  {
+    count_buffers();
+
+    std::vector<node> seeds;
+    _ntk.foreach_node( [&]( auto const& n ) {
+      if ( !is_ignored( n ) && !is_fixed( n ) )
+        seeds.emplace_back( n );
+    } );
+
+    bool updated = false;
+    std::vector<chunk> chunks;
+    std::vector<chunk_move> moves;
+    while ( !seeds.empty() )
+    {
+      chunks.clear();
+      if ( single_gates )
+      {
+        for ( auto const& n : seeds )
+          chunks.emplace_back( single_gate_chunk( n ) );
+      }
+      else
+      {
+        _start_id = _ntk.trav_id();
+        for ( auto const& n : seeds )
+        {
+          if ( _ntk.visited( n ) > _start_id ) /* belongs to a chunk */
+            continue;
+
+          _ntk.incr_trav_id();
+          chunk c{ _ntk.trav_id() };
+          recruit( n, c );
+          if ( c.members.size() > _ps.max_chunk_size )
+            continue; /* skip */
+          cleanup_interfaces( c );
+          chunks.emplace_back( std::move( c ) );
+        }
+      }
+
+      moves.assign( chunks.size(), {} );
+      std::vector<uint8_t> improving( chunks.size(), 0u );
+      parallel_for( _ps.num_threads, chunks.size(), [&]( uint64_t i, uint32_t ) {
+        improving[i] = evaluate_chunk_down( chunks[i], moves[i] ) || evaluate_chunk_up( chunks[i], moves[i] );
+      } );
+
+      /* commit the non-interfering moves */
+      _ntk.incr_trav_id();
+      auto const committed = _ntk.trav_id();
+      std::vector<uint8_t> revisit( chunks.size(), 0u );
+      for ( auto i = 0u; i < chunks.size(); ++i )
+      {
+        if ( !improving[i] )
+          continue;
+
+        auto const& c = chunks[i];
+        bool interferes = false;
+        foreach_footprint( c, [&]( node const& n ) {
+          interferes |= _ntk.visited( n ) == committed;
+        } );
+        if ( interferes )
+        {
+          revisit[i] = 1u;
+          continue;
+        }
+
+        foreach_footprint( c, [&]( node const& n ) {
+          _ntk.set_visited( n, committed );
+        } );
+        apply_move( c, moves[i] );
+        updated = true;
+      }
+
+      /* the evaluation of the chunks next to a committed move is outdated */
+      seeds.clear();
+      for ( auto i = 0u; i < chunks.size(); ++i )
+      {
+        if ( !revisit[i] && !improving[i] )
+        {
+          foreach_footprint( chunks[i], [&]( node const& n ) {
+            revisit[i] |= _ntk.visited( n ) == committed;
+          } );
+        }
+        if ( revisit[i] )
+          seeds.emplace_back( chunks[i].members.front() );
+      }
+      _start_id = _ntk.trav_id();
     }
+
+    return updated;
+  }
+
+  /* Nodes whose level or fanout information are read or modified when moving `c` */
+  template<typename Fn>
+  void foreach_footprint( chunk const& c, Fn&& fn ) const
+  {
+    for ( auto const& n : c.members )
+      fn( n );
+    for ( auto const& ii : c.input_interfaces )
+      fn( ii.o );
+    for ( auto const& oi : c.output_interfaces )
+      fn( oi.o );
   }
 #pragma endregion
 
@@ -1942,15 +2236,6 @@ private:
 #pragma endregion
 
 private:
-  struct fanout_information
-  {
-    uint32_t relative_depth{ 0u };
-    std::list<node> fanouts;
-    std::list<uint32_t> extrefs; // IDs of POs (as in `_ntk.foreach_po`)
-    uint32_t num_edges{ 0u };
-  };
-  using fanouts_by_level = std::list<fanout_information>;
-
   Ntk const& _ntk;
   buffer_insertion_params _ps;
   bool _outdated{ true };
@@ -49,6 +49,7 @@
 
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/depth_view.hpp"
@@ -74,6 +75,14 @@ struct balancing_params
   /*! \brief Optimize only on critical path. */
   bool only_on_critical_path{ false };
 
+  /*! \brief Number of threads to precompute decompositions.
+   *
+   * If larger than 1, the precomputation function given to `balancing` (see
+   * `rebalancing_precompute_function_t`) is called concurrently on all
+   * distinct cut functions before the network is rebuilt.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Show progress. */
   bool progress{ false };
 
@@ -91,10 +100,14 @@ struct balancing_stats
   /*! \brief Cut enumeration run-time. */
   cut_enumeration_stats cut_enumeration_st;
 
+  /*! \brief Run-time to precompute decompositions. */
+  stopwatch<>::duration time_precompute{};
+
   /*! \brief Prints report. */
   void report() const
   {
     fmt::print( "[i] total time             = {:>5.2f} secs\n", to_seconds( time_total ) );
+    fmt::print( "[i] precomputation time    = {:>5.2f} secs\n", to_seconds( time_precompute ) );
     fmt::print( "[i] Cut enumeration stats\n" );
     cut_enumeration_st.report();
   }
@@ -106,9 +119,10 @@ namespace detail
 template<class Ntk, class CostFn>
 struct balancing_impl
 {
-  balancing_impl( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, balancing_params const& ps, balancing_stats& st )
+  balancing_impl( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, rebalancing_precompute_function_t const& precompute_fn, balancing_params const& ps, balancing_stats& st )
       : ntk_( ntk ),
         rebalancing_fn_( rebalancing_fn ),
+        precompute_fn_( precompute_fn ),
         ps_( ps ),
         st_( st )
   {
@@ -138,6 +152,13 @@ struct balancing_impl
     stopwatch<> t( st_.time_total );
     const auto cuts = cut_enumeration<Ntk, true>( ntk_, ps_.cut_enumeration_ps, &st_.cut_enumeration_st );
 
+    if ( ps_.num_threads > 1u && precompute_fn_ )
+    {
+      call_with_stopwatch( st_.time_precompute, [&]() {
+        precompute_decompositions( cuts, depth_ntk );
+      } );
+    }
+
     uint32_t current_level{};
     const auto size = ntk_.size();
     progress_bar pbar{ ntk_.size(), "balancing |{0}| node = {1:>4} / " + std::to_string( size ) + "   current level = {2}", ps_.progress };
@@ -192,9 +213,47 @@ struct balancing_impl
     return cleanup_dangling( dest );
   }
 
+private:
+  template<class Cuts>
+  void precompute_decompositions( Cuts const& cuts, std::shared_ptr<depth_view<Ntk, CostFn>> const& depth_ntk )
+  {
+    /* collect cuts with distinct functions */
+    std::vector<typename Cuts::cut_t const*> func_cuts;
+    std::vector<bool> visited;
+    ntk_.foreach_gate( [&]( auto const& n ) {
+      if ( ps_.only_on_critical_path && !depth_ntk->is_on_critical_path( n ) )
+      {
+        return;
+      }
+
+      for ( auto& cut : cuts.cuts( ntk_.node_to_index( n ) ) )
+      {
+        auto const func_id = ( *cut )->func_id;
+        if ( cut->size() == 1u || func_id < 2u )
+        {
+          continue;
+        }
+        if ( func_id >= visited.size() )
+        {
+          visited.resize( func_id + 1u );
+        }
+        if ( !visited[func_id] )
+        {
+          visited[func_id] = true;
+          func_cuts.push_back( &( *cut ) );
+        }
+      }
+    } );
+
+    parallel_for( ps_.num_threads, func_cuts.size(), [&]( uint64_t i, uint32_t ) {
+      precompute_fn_( cuts.truth_table( *func_cuts[i] ) );
+    } );
+  }
+
 private:
   Ntk const& ntk_;
   rebalancing_function_t<Ntk> const& rebalancing_fn_;
+  rebalancing_precompute_function_t const& precompute_fn_;
   balancing_params const& ps_;
   balancing_stats& st_;
 };
@@ -288,6 +347,10 @@ private:
  * when the `only_on_critical_path` parameter is assigned true.  Note that the
  * size for rewriting candidates is computed by the rebalancing function and
  * may not correspond to the cost given by CostFn.
+ *
+ * The optional precomputation function is called concurrently on the distinct
+ * cut functions if `ps.num_threads` is larger than 1, e.g., to fill the cache
+ * of decompositions of the rebalancing function.
  *
    \verbatim embed:rst
 
@@ -300,11 +363,12 @@ private:
       sop_rebalancing<aig_network> balance_fn;
       balancing_params ps;
       ps.cut_enumeration_ps.cut_size = 6u;
-      const auto balanced_aig = balancing( aig, {balance_fn}, ps );
+      ps.num_threads = 4u;
+      const auto balanced_aig = balancing( aig, {balance_fn}, balance_fn.precompute_function(), ps );
    \endverbatim
  */
 template<class Ntk, class CostFn = unit_cost<Ntk>>
-Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn = {}, balancing_params const& ps = {}, balancing_stats* pst = nullptr )
+Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, rebalancing_precompute_function_t const& precompute_fn, balancing_params const& ps = {}, balancing_stats* pst = nullptr )
 {
   static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not method" );
@@ -321,7 +385,7 @@ Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn
   static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
 
   balancing_stats st;
-  const auto dest = detail::balancing_impl<Ntk, CostFn>{ ntk, rebalancing_fn, ps, st }.run();
+  const auto dest = detail::balancing_impl<Ntk, CostFn>{ ntk, rebalancing_fn, precompute_fn, ps, st }.run();
 
   if ( pst )
   {
@@ -335,6 +399,30 @@ Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn
   return dest;
 }
 
+/*! \brief Balancing of a logic network
+ *
+ * Balancing without precomputation function.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      const auto aig = ...;
+
+      sop_rebalancing<aig_network> balance_fn;
+      balancing_params ps;
+      ps.cut_enumeration_ps.cut_size = 6u;
+      const auto balanced_aig = balancing( aig, {balance_fn}, ps );
+   \endverbatim
+ */
+template<class Ntk, class CostFn = unit_cost<Ntk>>
+Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn = {}, balancing_params const& ps = {}, balancing_stats* pst = nullptr )
+{
+  return balancing<Ntk, CostFn>( ntk, rebalancing_fn, rebalancing_precompute_function_t{}, ps, pst );
+}
+
 /*! \brief SOP balancing of a logic network
  *
  * This function implements an LUT-based SOP balancing algorithm.
@@ -366,13 +454,23 @@ Ntk sop_balancing( Ntk const& ntk, lut_map_params const& ps = {}, lut_map_stats*
   mps.verbose = false;
   lut_map_stats st;
 
+  /* the decomposition reuses the covers computed during mapping */
+  sop_rebalancing<Ntk> balance_fn;
+  balance_fn.both_phases_ = true;
+  if ( mps.decompositions )
+  {
+    balance_fn.cache = mps.decompositions;
+  }
+  else
+  {
+    mps.decompositions = balance_fn.cache;
+  }
+
   /* perform SOP-driven mapping */
   mapping_view<Ntk, true> map_ntk{ ntk };
   lut_map_inplace<decltype( map_ntk ), true>( map_ntk, mps, &st );
 
   /* decompose mapping */
-  sop_rebalancing<Ntk> balance_fn;
-  balance_fn.both_phases_ = true;
   const auto dest = call_with_stopwatch( st.time_total, [&]() {
     return detail::balancing_decomp_impl<Ntk>{ map_ntk, balance_fn }.run();
   } );
@@ -420,13 +518,23 @@ Ntk esop_balancing( Ntk const& ntk, lut_map_params const& ps = {}, lut_map_stats
   mps.verbose = false;
   lut_map_stats st;
 
+  /* the decomposition reuses the covers computed during mapping */
+  esop_rebalancing<Ntk> balance_fn;
+  balance_fn.both_phases = true;
+  if ( mps.decompositions )
+  {
+    balance_fn.cache = mps.decompositions;
+  }
+  else
+  {
+    mps.decompositions = balance_fn.cache;
+  }
+
   /* perform ESOP-driven mapping */
   mapping_view<Ntk, true> map_ntk{ ntk };
   lut_map_inplace<decltype( map_ntk ), true>( map_ntk, mps, &st );
 
   /* decompose mapping */
-  esop_rebalancing<Ntk> balance_fn;
-  balance_fn.both_phases = true;
   const auto dest = call_with_stopwatch( st.time_total, [&]() {
     return detail::balancing_decomp_impl<Ntk>{ map_ntk, balance_fn }.run();
   } );
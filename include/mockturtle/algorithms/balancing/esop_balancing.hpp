@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_map>
@@ -232,68 +233,53 @@ private:
   std::vector<kitty::cube> create_sop_form( kitty::dynamic_truth_table const& func, bool& inverted ) const
   {
     stopwatch<> t( time_sop );
-    inverted = false;
 
-    if ( auto it = sop_hash_.find( func ); it != sop_hash_.end() )
+    if ( auto sop = cache->find( func, both_phases, inverted ); sop )
     {
       sop_cache_hits++;
-      return it->second;
-    }
-
-    if ( both_phases )
-    {
-      if ( auto it = sop_hash_.find( ~func ); it != sop_hash_.end() )
-      {
-        inverted = true;
-        sop_cache_hits++;
-        return it->second;
-      }
+      return *sop;
     }
 
     sop_cache_misses++;
-    std::vector<kitty::cube> sop = mockturtle::exorcism( func );
-
-    if ( both_phases )
-    {
-      std::vector<kitty::cube> n_sop = mockturtle::exorcism( ~func );
+    return compute_sop_form( func, inverted );
+  }
 
-      if ( n_sop.size() < sop.size() )
-      {
-        inverted = true;
-        return sop_hash_[~func] = n_sop;
-      }
-      else if ( n_sop.size() == sop.size() )
-      {
-        /* compute literal cost */
-        uint32_t lit = 0, n_lit = 0;
-        for ( auto const& c : sop )
-        {
-          lit += c.num_literals();
-        }
-        for ( auto const& c : n_sop )
-        {
-          n_lit += c.num_literals();
-        }
+  std::vector<kitty::cube> compute_sop_form( kitty::dynamic_truth_table const& func, bool& inverted ) const
+  {
+    auto sop = cheaper_phase_cover( func, both_phases, []( auto const& f ) { return mockturtle::exorcism( f ); }, inverted );
+    cache->insert( inverted ? ~func : func, sop );
+    return sop;
+  }
 
-        if ( n_lit < lit )
-        {
-          inverted = true;
-          return sop_hash_[~func] = n_sop;
-        }
-      }
+public:
+  /*! \brief Computes and caches the ESOP of `function`.
+   *
+   * This method only accesses the cache and can be called concurrently.
+   */
+  void precompute( kitty::dynamic_truth_table const& function ) const
+  {
+    bool inverted;
+    if ( !cache->find( function, both_phases, inverted ) )
+    {
+      compute_sop_form( function, inverted );
     }
-
-    return sop_hash_[func] = sop;
   }
 
-private:
-  mutable std::unordered_map<kitty::dynamic_truth_table, std::vector<kitty::cube>, kitty::hash<kitty::dynamic_truth_table>> sop_hash_;
+  /*! \brief Returns the precomputation function to use along with this function in `balancing`. */
+  rebalancing_precompute_function_t precompute_function() const
+  {
+    /* the copy shares the cache */
+    return [fn = *this]( kitty::dynamic_truth_table const& function ) { fn.precompute( function ); };
+  }
 
 public:
   bool both_phases{ false };
   bool spp_optimization{ false };
   bool mux_optimization{ false };
 
+  /*! \brief Cache of ESOPs, shared by the copies of this function. */
+  std::shared_ptr<decomposition_cache> cache{ std::make_shared<decomposition_cache>() };
+
 public:
   mutable uint32_t sop_cache_hits{};
   mutable uint32_t sop_cache_misses{};
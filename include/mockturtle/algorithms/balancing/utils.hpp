@@ -34,7 +34,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <vector>
+
+#include <kitty/cube.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/operations.hpp>
+#include <parallel_hashmap/phmap.h>
 
 #include "../../traits.hpp"
 
@@ -65,6 +77,14 @@ using rebalancing_function_callback_t = std::function<void( arrival_time_pair<Nt
 template<class Ntk>
 using rebalancing_function_t = std::function<void( Ntk&, kitty::dynamic_truth_table const&, std::vector<arrival_time_pair<Ntk>> const&, uint32_t, uint32_t, rebalancing_function_callback_t<Ntk> const& )>;
 
+/*! \brief Precomputation function for `rebalancing_function_t`.
+ *
+ * Optionally provided along with a rebalancing function, it is called on the
+ * functions of the cuts before the network is rebuilt, e.g., to fill a cache of
+ * decompositions.  It is called concurrently from multiple threads.
+ */
+using rebalancing_precompute_function_t = std::function<void( kitty::dynamic_truth_table const& )>;
+
 template<class Ntk>
 struct arrival_time_compare
 {
@@ -77,4 +97,124 @@ struct arrival_time_compare
 template<class Ntk>
 using arrival_time_queue = std::priority_queue<arrival_time_pair<Ntk>, std::vector<arrival_time_pair<Ntk>>, arrival_time_compare<Ntk>>;
 
+/*! \brief Computes the two-level cover of the cheaper phase of a function.
+ *
+ * Computes the cover of `function` using `decompose`.  If `both_phases` is
+ * true, the cover of its complement is returned instead if it has fewer cubes,
+ * or as many cubes and fewer literals, in which case `inverted` is set to true.
+ */
+template<class DecomposeFn>
+std::vector<kitty::cube> cheaper_phase_cover( kitty::dynamic_truth_table const& function, bool both_phases, DecomposeFn&& decompose, bool& inverted )
+{
+  inverted = false;
+  std::vector<kitty::cube> cover = decompose( function );
+
+  if ( both_phases )
+  {
+    std::vector<kitty::cube> n_cover = decompose( ~function );
+
+    if ( n_cover.size() < cover.size() )
+    {
+      inverted = true;
+      return n_cover;
+    }
+    else if ( n_cover.size() == cover.size() )
+    {
+      /* compute literal cost */
+      uint32_t lit = 0, n_lit = 0;
+      for ( auto const& c : cover )
+      {
+        lit += c.num_literals();
+      }
+      for ( auto const& c : n_cover )
+      {
+        n_lit += c.num_literals();
+      }
+
+      if ( n_lit < lit )
+      {
+        inverted = true;
+        return n_cover;
+      }
+    }
+  }
+
+  return cover;
+}
+
+/*! \brief Concurrent cache of two-level decompositions.
+ *
+ * Maps functions to a two-level cover (e.g., an ISOP or an ESOP).  A cover
+ * may be stored for the complement of a function if it is the cheaper phase.
+ * All methods can be called concurrently from multiple threads.  The cache is
+ * shared by the copies of the rebalancing functions that own it, such that it
+ * can be reused across several calls to `balancing`.
+ */
+class decomposition_cache
+{
+public:
+  using cover_t = std::vector<kitty::cube>;
+
+  /*! \brief Looks up the cover of `function`.
+   *
+   * If `both_phases` is true, the complement of `function` is looked up as
+   * well, in which case `inverted` is set to true if the cover implements the
+   * complement.
+   */
+  std::optional<cover_t> find( kitty::dynamic_truth_table const& function, bool both_phases, bool& inverted ) const
+  {
+    cover_t cover;
+    inverted = false;
+    if ( _map.if_contains( function, [&]( auto const& v ) { cover = v; } ) )
+    {
+      ++_hits;
+      return cover;
+    }
+    if ( both_phases && _map.if_contains( ~function, [&]( auto const& v ) { cover = v; } ) )
+    {
+      inverted = true;
+      ++_hits;
+      return cover;
+    }
+    ++_misses;
+    return std::nullopt;
+  }
+
+  /*! \brief Stores the cover of `function`. */
+  void insert( kitty::dynamic_truth_table const& function, cover_t const& cover )
+  {
+    _map.try_emplace_l(
+        function, []( auto& ) {}, cover );
+  }
+
+  /*! \brief Number of stored covers. */
+  uint64_t size() const
+  {
+    return _map.size();
+  }
+
+  /*! \brief Number of successful lookups. */
+  uint64_t hits() const
+  {
+    return _hits;
+  }
+
+  /*! \brief Number of failed lookups. */
+  uint64_t misses() const
+  {
+    return _misses;
+  }
+
+private:
+  phmap::parallel_flat_hash_map<kitty::dynamic_truth_table, cover_t,
+                                kitty::hash<kitty::dynamic_truth_table>,
+                                std::equal_to<kitty::dynamic_truth_table>,
+                                std::allocator<std::pair<const kitty::dynamic_truth_table, cover_t>>,
+                                4, std::mutex>
+      _map;
+
+  mutable std::atomic<uint64_t> _hits{ 0 };
+  mutable std::atomic<uint64_t> _misses{ 0 };
+};
+
 } // namespace mockturtle
\ No newline at end of file
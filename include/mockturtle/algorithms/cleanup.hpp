@@ -37,17 +37,27 @@
 #include "../networks/crossed.hpp"
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../views/topo_view.hpp"
 
 #include <kitty/operations.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <limits>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace mockturtle
 {
 
+class aig_network;
+class xag_network;
+class mig_network;
+class xmg_network;
+
 namespace detail
 {
 
@@ -229,6 +239,177 @@ void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator beg
   } );
 }
 
+template<typename NtkSrc, typename NtkDest>
+static constexpr bool has_bulk_cleanup_v = std::is_same_v<NtkSrc, NtkDest> &&
+                                           ( std::is_same_v<NtkSrc, aig_network> || std::is_same_v<NtkSrc, xag_network> ||
+                                             std::is_same_v<NtkSrc, mig_network> || std::is_same_v<NtkSrc, xmg_network> );
+
+/* Copies the live gates of a structurally hashed network directly between the storages.
+ *
+ * The gates are created in the same order as by `cleanup_dangling_impl`
+ * (depth-first order from the outputs, as in `topo_view`), hence the result
+ * is the same, but the fanin literals are rewritten and hashed in parallel,
+ * and the structural hash table is filled without creating the nodes one by
+ * one.  The inputs of `dest` must have been created.  Returns false, leaving
+ * `dest` in an unspecified state, if a gate would be simplified when created
+ * with `clone_node` (e.g., it has a constant or twice the same fanin, or it
+ * is structurally equivalent to another gate).
+ */
+template<typename Ntk>
+bool cleanup_dangling_bulk_impl( Ntk const& ntk, Ntk& dest, node_map<signal<Ntk>, Ntk>& old_to_new, uint32_t num_threads = 1u )
+{
+  constexpr uint64_t unvisited = std::numeric_limits<uint64_t>::max();
+  constexpr uint64_t in_progress = unvisited - 1u;
+  constexpr uint64_t chunk_size = 4096u;
+  constexpr bool has_xor_gates = std::is_same_v<Ntk, xag_network> || std::is_same_v<Ntk, xmg_network>;
+  constexpr bool has_maj_gates = std::is_same_v<Ntk, mig_network> || std::is_same_v<Ntk, xmg_network>;
+  constexpr bool allows_constant_fanins = has_maj_gates;
+
+  auto const& nodes = ntk._storage->nodes;
+  auto& dest_storage = *dest._storage;
+  assert( dest.num_pis() == ntk.num_pis() && dest.size() == ntk.num_pis() + 1u );
+
+  /* children are in increasing order, except for XOR gates of XAGs and XOR3 gates of XMGs */
+  auto const is_xor = [&]( auto const& node ) {
+    return has_xor_gates && node.children[0].index > node.children[1].index;
+  };
+
+  /* new literals (index and output complement) of the constant and the inputs */
+  std::vector<uint64_t> new_literal( nodes.size(), unvisited );
+  new_literal[0] = 0u;
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    new_literal[n] = ( i + 1u ) << 1u;
+  } );
+
+  /* live gates in depth-first order from the outputs; the output complement
+   * of a gate follows from the complemented edges normalization of `create_xor`,
+   * `create_maj`, and `create_xor3`, and depends on the fanins */
+  std::vector<uint64_t> order;
+  std::vector<std::pair<uint64_t, uint32_t>> stack;
+  uint64_t next_index = dest.size();
+  ntk.foreach_po( [&]( auto const& f ) {
+    if ( new_literal[f.index] != unvisited )
+    {
+      return;
+    }
+
+    new_literal[f.index] = in_progress;
+    stack.emplace_back( f.index, 0u );
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back().first;
+      auto const& old_node = nodes[n];
+      if ( auto& i = stack.back().second; i < old_node.children.size() )
+      {
+        auto const child = old_node.children[i++].index;
+        if ( new_literal[child] == unvisited )
+        {
+          new_literal[child] = in_progress;
+          stack.emplace_back( child, 0u );
+        }
+        continue;
+      }
+
+      bool complement{ false };
+      if ( has_maj_gates || is_xor( old_node ) )
+      {
+        uint32_t num_complemented{ 0u };
+        for ( auto const& c : old_node.children )
+        {
+          num_complemented += ( new_literal[c.index] & 1u ) ^ c.weight;
+        }
+        complement = is_xor( old_node ) ? ( num_complemented & 1u ) : ( num_complemented >= 2u );
+      }
+
+      new_literal[n] = ( next_index++ << 1u ) | complement;
+      order.push_back( n );
+      stack.pop_back();
+    }
+  } );
+
+  /* rewrite the fanin literals and hash the gates */
+  auto const offset = dest.size();
+  auto const num_chunks = ( order.size() + chunk_size - 1u ) / chunk_size;
+  std::vector<std::size_t> hashes( order.size() );
+  std::atomic<bool> simplifies{ false };
+  dest_storage.nodes.resize( offset + order.size() );
+
+  parallel_for( num_threads, num_chunks, [&]( uint64_t chunk, uint32_t ) {
+    auto const end = std::min<uint64_t>( order.size(), ( chunk + 1u ) * chunk_size );
+    for ( auto k = chunk * chunk_size; k < end; ++k )
+    {
+      auto const& old_node = nodes[order[k]];
+      auto& node = dest_storage.nodes[offset + k];
+      auto const xor_gate = is_xor( old_node );
+      auto const complement = static_cast<bool>( new_literal[order[k]] & 1u );
+      for ( auto i = 0u; i < node.children.size(); ++i )
+      {
+        auto const literal = new_literal[old_node.children[i].index] ^ old_node.children[i].weight;
+        node.children[i] = { literal >> 1u, xor_gate ? 0u : ( ( literal & 1u ) ^ complement ) };
+      }
+
+      if ( xor_gate )
+      {
+        std::sort( node.children.begin(), node.children.end(), []( auto const& a, auto const& b ) { return a.index > b.index; } );
+      }
+      else
+      {
+        std::sort( node.children.begin(), node.children.end(), []( auto const& a, auto const& b ) { return a.index < b.index; } );
+      }
+
+      for ( auto i = 0u; i < node.children.size(); ++i )
+      {
+        if ( ( !allows_constant_fanins && node.children[i].index == 0u ) || ( i > 0u && node.children[i].index == node.children[i - 1u].index ) )
+        {
+          simplifies = true;
+        }
+      }
+
+      hashes[k] = dest_storage.hash.hash( node );
+      old_to_new[order[k]] = dest.make_signal( offset + k ) ^ complement;
+    }
+  } );
+
+  if ( simplifies )
+  {
+    return false;
+  }
+
+  /* structural hash table and reference counters */
+  dest_storage.hash.reserve( order.size() );
+  for ( auto k = 0u; k < order.size(); ++k )
+  {
+    if ( k + 8u < order.size() )
+    {
+      dest_storage.hash.prefetch_hash( hashes[k + 8u] );
+    }
+
+    auto const& node = dest_storage.nodes[offset + k];
+    bool inserted{ false };
+    dest_storage.hash.lazy_emplace_with_hash( node, hashes[k], [&]( auto const& ctor ) {
+      inserted = true;
+      ctor( node, offset + k );
+    } );
+    if ( !inserted )
+    {
+      return false;
+    }
+
+    for ( auto const& c : node.children )
+    {
+      dest_storage.nodes[c.index].data[0].h1++;
+    }
+  }
+
+  /* constant and inputs */
+  old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
+  ntk.foreach_pi( [&]( auto const& n ) {
+    old_to_new[n] = dest.make_signal( new_literal[n] >> 1u );
+  } );
+
+  return true;
+}
+
 template<typename NtkSrc, typename NtkDest, typename LeavesIterator>
 void cleanup_dangling_with_crossings_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end, node_map<signal<NtkDest>, NtkSrc>& old_to_new )
 {
@@ -527,6 +708,10 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSrc const& ntk, NtkDest& dest,
  * `remove_redundant_POs` is true, redundant POs, i.e. POs connected to a PI or
  * constant, are also omitted. The network types of the source and destination
  * network are the same.
+ *
+ * For AIGs, XAGs, MIGs, and XMGs, the fanins of the gates are rewritten in
+ * parallel using `num_threads` threads.  The default is serial, as this
+ * method is often called from algorithms that are already multi-threaded.
  *
    \verbatim embed:rst
 
@@ -552,7 +737,7 @@ std::vector<signal<NtkDest>> cleanup_dangling( NtkSrc const& ntk, NtkDest& dest,
  * - `is_constant`
  */
 template<class NtkSrc, class NtkDest = NtkSrc>
-[[nodiscard]] NtkDest cleanup_dangling( NtkSrc const& ntk, bool remove_dangling_PIs = false, bool remove_redundant_POs = false )
+[[nodiscard]] NtkDest cleanup_dangling( NtkSrc const& ntk, bool remove_dangling_PIs = false, bool remove_redundant_POs = false, uint32_t num_threads = 1u )
 {
   static_assert( is_network_type_v<NtkSrc>, "NtkSrc is not a network type" );
   static_assert( is_network_type_v<NtkDest>, "NtkDest is not a network type" );
@@ -570,6 +755,25 @@ template<class NtkSrc, class NtkDest = NtkSrc>
   static_assert( has_create_not_v<NtkDest>, "NtkDest does not implement the create_not method" );
   static_assert( has_is_complemented_v<NtkSrc>, "NtkDest does not implement the is_complemented method" );
 
+  /* fast path for structurally hashed networks */
+  if constexpr ( detail::has_bulk_cleanup_v<NtkSrc, NtkDest> )
+  {
+    if ( !remove_dangling_PIs )
+    {
+      NtkDest dest;
+
+      std::vector<signal<NtkDest>> cis;
+      detail::clone_inputs( ntk, dest, cis );
+
+      node_map<signal<NtkDest>, NtkSrc> old_to_new( ntk );
+      if ( detail::cleanup_dangling_bulk_impl( ntk, dest, old_to_new, num_threads ) )
+      {
+        detail::clone_outputs( ntk, dest, old_to_new, remove_redundant_POs );
+        return dest;
+      }
+    }
+  }
+
   NtkDest dest;
 
   std::vector<signal<NtkDest>> cis;
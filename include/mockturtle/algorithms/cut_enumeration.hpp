@@ -41,6 +41,7 @@
 #include <cstdint>
 #include <iostream>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -50,7 +51,9 @@
 
 #include "../traits.hpp"
 #include "../utils/cuts.hpp"
+#include "../utils/choice_classes.hpp"
 #include "../utils/mixed_radix.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/truth_table_cache.hpp"
 
@@ -76,6 +79,17 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{ false };
 
+  /*! \brief Number of threads (only used by `fast_cut_enumeration`).
+   *
+   * With more than one thread, the nodes are processed in waves of nodes
+   * whose fanins are in previous waves, and the cuts of the nodes in a wave
+   * are computed concurrently.  The resulting cuts are the same, but the
+   * literals of their truth tables in the cache may differ.  Cuts are
+   * computed serially if the update of the cut data reads truth tables
+   * (see `cut_data_uses_truth_table`).
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 
@@ -142,10 +156,36 @@ struct cut_enumeration_update_cut
   }
 };
 
+/*! \brief Whether updating the cut data reads the truth tables of the new cuts.
+ *
+ * `fast_cut_enumeration` only computes cuts concurrently if this is false,
+ * as the truth tables of the new cuts are inserted into the cache after the
+ * cuts of all nodes in a wave have been computed.  Cut data types are
+ * assumed to read them, unless this trait is specialized.
+ */
+template<typename CutData>
+struct cut_data_uses_truth_table : std::true_type
+{
+};
+
+template<>
+struct cut_data_uses_truth_table<empty_cut_data> : std::false_type
+{
+};
+
+template<typename CutData>
+inline constexpr bool cut_data_uses_truth_table_v = cut_data_uses_truth_table<CutData>::value;
+
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
+network_cuts<Ntk, ComputeTruth, CutData> choice_cut_enumeration( Ntk const& ntk, choice_classes<Ntk> const& choices, cut_enumeration_params const& ps = {}, cut_enumeration_stats* pst = nullptr );
+
 namespace detail
 {
 template<typename Ntk, bool ComputeTruth, typename CutData>
 class cut_enumeration_impl;
+
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class choice_cut_enumeration_impl;
 }
 /*! \endcond */
 
@@ -250,6 +290,12 @@ private:
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
 
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend class detail::choice_cut_enumeration_impl;
+
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend network_cuts<_Ntk, _ComputeTruth, _CutData> choice_cut_enumeration( _Ntk const& ntk, choice_classes<_Ntk> const& choices, cut_enumeration_params const& ps, cut_enumeration_stats* pst );
+
 private:
   void add_zero_cut( uint32_t index )
   {
@@ -614,6 +660,270 @@ network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_en
   return res;
 }
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class choice_cut_enumeration_impl
+{
+public:
+  using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
+  using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+
+  explicit choice_cut_enumeration_impl( Ntk const& ntk, choice_classes<Ntk> const& choices, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
+      : ntk( ntk ),
+        choices( choices ),
+        ps( ps ),
+        st( st ),
+        cuts( cuts )
+  {
+    assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
+  }
+
+public:
+  void run()
+  {
+    stopwatch t( st.time_total );
+
+    for ( auto const& n : choices.topological_order() )
+    {
+      const auto index = ntk.node_to_index( n );
+
+      if ( ps.very_verbose )
+      {
+        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+      }
+
+      if ( ntk.is_constant( n ) )
+      {
+        cuts.add_zero_cut( index );
+      }
+      else if ( ntk.is_ci( n ) )
+      {
+        cuts.add_unit_cut( index );
+      }
+      else
+      {
+        merge_cuts( n );
+      }
+    }
+  }
+
+private:
+  uint32_t compute_truth_table( node<Ntk> const& n, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  {
+    stopwatch t( st.time_truth_table );
+
+    std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
+    for ( auto i = 0u; i < vcuts.size(); ++i )
+    {
+      /* the fanin is expressed with the cut of its representative */
+      tt[i] = kitty::extend_to( cuts._truth_tables[( *vcuts[i] )->func_id ^ static_cast<uint32_t>( phases[i] )], res.size() );
+      const auto supp = cuts.compute_truth_table_support( *vcuts[i], res );
+      kitty::expand_inplace( tt[i], supp );
+    }
+
+    auto tt_res = ntk.compute( n, tt.begin(), tt.end() );
+
+    if ( ps.minimize_truth_table )
+    {
+      const auto support = kitty::min_base_inplace( tt_res );
+      if ( support.size() != res.size() )
+      {
+        auto tt_res_shrink = shrink_to( tt_res, static_cast<unsigned>( support.size() ) );
+        std::vector<uint32_t> leaves_before( res.begin(), res.end() );
+        std::vector<uint32_t> leaves_after( support.size() );
+
+        auto it_support = support.begin();
+        auto it_leaves = leaves_after.begin();
+        while ( it_support != support.end() )
+        {
+          *it_leaves++ = leaves_before[*it_support++];
+        }
+        res.set_leaves( leaves_after.begin(), leaves_after.end() );
+        return cuts._truth_tables.insert( tt_res_shrink );
+      }
+    }
+
+    return cuts._truth_tables.insert( tt_res );
+  }
+
+  void merge_cuts( node<Ntk> const& n )
+  {
+    const auto index = ntk.node_to_index( n );
+
+    uint32_t pairs{ 1 };
+    std::vector<uint32_t> cut_sizes;
+    lcuts.clear();
+    phases.clear();
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const child = ntk.get_node( f );
+      lcuts.push_back( &cuts.cuts( ntk.node_to_index( choices.representative( child ) ) ) );
+      phases.push_back( choices.phase( child ) );
+      cut_sizes.push_back( static_cast<uint32_t>( lcuts.back()->size() ) );
+      pairs *= cut_sizes.back();
+    } );
+
+    const auto fanin = cut_sizes.size();
+    auto& rcuts = cuts.cuts( index );
+    rcuts.clear();
+
+    if ( fanin > 0 && fanin <= ps.fanin_limit )
+    {
+      cut_t new_cut, tmp_cut;
+
+      std::vector<cut_t const*> vcuts( fanin );
+
+      cuts._total_tuples += pairs;
+      foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
+        auto it = vcuts.begin();
+        auto i = 0u;
+        while ( begin != end )
+        {
+          *it++ = &( ( *lcuts[i++] )[*begin++] );
+        }
+
+        new_cut = *vcuts[0];
+        for ( i = 1; i < fanin; ++i )
+        {
+          tmp_cut = new_cut;
+          if ( !vcuts[i]->merge( tmp_cut, new_cut, ps.cut_size ) )
+          {
+            return true; /* continue */
+          }
+        }
+
+        if ( rcuts.is_dominated( new_cut ) )
+        {
+          return true; /* continue */
+        }
+
+        if constexpr ( ComputeTruth )
+        {
+          new_cut->func_id = compute_truth_table( n, vcuts, new_cut );
+        }
+
+        cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, n );
+
+        rcuts.insert( new_cut );
+
+        return true;
+      } );
+    }
+
+    /* add the cuts of the other members of the class, which precede the representative */
+    if ( choices.has_choices( n ) )
+    {
+      choices.foreach_choice( n, [&]( auto const& m, bool phase ) {
+        if ( m == n )
+        {
+          return;
+        }
+
+        auto const& mcuts = cuts.cuts( ntk.node_to_index( m ) );
+        for ( auto const& cut : mcuts )
+        {
+          /* skip the unit cut of the member */
+          if ( cut->size() == 1u && *cut->begin() == ntk.node_to_index( m ) )
+          {
+            continue;
+          }
+
+          if ( rcuts.is_dominated( *cut ) )
+          {
+            continue;
+          }
+
+          cut_t new_cut = *cut;
+
+          if constexpr ( ComputeTruth )
+          {
+            new_cut->func_id = ( *cut )->func_id ^ static_cast<uint32_t>( phase );
+          }
+
+          cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, n );
+
+          rcuts.insert( new_cut );
+        }
+      } );
+    }
+
+    /* limit the maximum number of cuts */
+    rcuts.limit( ps.cut_limit - 1 );
+
+    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+
+    cuts.add_unit_cut( index );
+  }
+
+private:
+  Ntk const& ntk;
+  choice_classes<Ntk> const& choices;
+  cut_enumeration_params const& ps;
+  cut_enumeration_stats& st;
+  network_cuts<Ntk, ComputeTruth, CutData>& cuts;
+
+  std::vector<cut_set_t*> lcuts;
+  std::vector<bool> phases;
+};
+} /* namespace detail */
+/*! \endcond */
+
+/*! \brief Cut enumeration with structural choices.
+ *
+ * This function enumerates the cuts of a network together with its
+ * structural choices, e.g., the ones computed by `functional_choices`.  The
+ * nodes are traversed in the topological order of the choice network.  The
+ * cuts of a node are merged from the cuts of the representatives of its
+ * fanins, such that their leaves are always representatives.  The cut set of
+ * a representative additionally contains the cuts of the other members of
+ * its class (with complemented truth tables for members in opposite phase),
+ * such that a mapper can choose among the structures of all members by only
+ * looking at the representatives.
+ *
+ * Cuts are computed for all nodes in the topological order of `choices`,
+ * including the dead nodes that are members of classes.  The parameters,
+ * cut data, and truth tables are the same as for `cut_enumeration`.
+ *
+ * **Required network functions:**
+ * - `is_constant`
+ * - `is_ci`
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_fanin`
+ * - `compute` for `kitty::dynamic_truth_table` (if `ComputeTruth` is true)
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+network_cuts<Ntk, ComputeTruth, CutData> choice_cut_enumeration( Ntk const& ntk, choice_classes<Ntk> const& choices, cut_enumeration_params const& ps, cut_enumeration_stats* pst )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
+
+  cut_enumeration_stats st;
+  network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
+  detail::choice_cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, choices, ps, st, res );
+  p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return res;
+}
+
 /* forward declarations */
 /*! \cond PRIVATE */
 template<typename Ntk, uint32_t NumVars, bool ComputeTruth, typename CutData>
@@ -791,40 +1101,138 @@ public:
   {
     stopwatch t( st.time_total );
 
-    ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+    if ( ps.num_threads > 1u && !( ComputeTruth && cut_data_uses_truth_table_v<CutData> ) )
+    {
+      run_parallel();
+      return;
+    }
 
-      if ( ps.very_verbose )
+    merge_state ms;
+    ntk.foreach_node( [&]( auto node ) {
+      compute_cuts( node, ms );
+    } );
+    add_statistics( ms );
+  }
+
+private:
+  /* data of a thread computing cuts */
+  struct merge_state
+  {
+    std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+
+    /* if not null, the truth tables of the new cuts are stored here and
+       their `func_id` is their position, instead of inserting them into the
+       truth table cache */
+    std::vector<kitty::static_truth_table<NumVars>>* pending{ nullptr };
+    uint32_t num_merged{ 0 }; /* number of cuts obtained by merging for the current node */
+
+    uint32_t total_tuples{ 0 };
+    std::size_t total_cuts{ 0 };
+    stopwatch<>::duration time_truth_table{ 0 };
+  };
+
+  void compute_cuts( node<Ntk> const& node, merge_state& ms )
+  {
+    const auto index = ntk.node_to_index( node );
+    ms.num_merged = 0;
+
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_ci( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+        merge_cuts2( index, ms );
       }
+      else
+      {
+        merge_cuts( index, ms );
+      }
+    }
+  }
 
-      if ( ntk.is_constant( node ) )
+  void add_statistics( merge_state const& ms )
+  {
+    cuts._total_tuples += ms.total_tuples;
+    cuts._total_cuts += ms.total_cuts;
+    st.time_truth_table += ms.time_truth_table;
+  }
+
+  void run_parallel()
+  {
+    /* group nodes into waves such that the fanins of a node are in previous waves */
+    std::vector<uint32_t> wave_of( ntk.size(), 0u );
+    std::vector<std::vector<node<Ntk>>> waves;
+    ntk.foreach_node( [&]( auto node ) {
+      uint32_t wave{ 0 };
+      if ( !ntk.is_constant( node ) && !ntk.is_ci( node ) )
       {
-        cuts.add_zero_cut( index );
+        ntk.foreach_fanin( node, [&]( auto const& f ) {
+          wave = std::max( wave, wave_of[ntk.node_to_index( ntk.get_node( f ) )] + 1 );
+        } );
       }
-      else if ( ntk.is_ci( node ) )
+      wave_of[ntk.node_to_index( node )] = wave;
+      if ( waves.size() <= wave )
       {
-        cuts.add_unit_cut( index );
+        waves.resize( wave + 1 );
       }
-      else
+      waves[wave].push_back( node );
+    } );
+
+    std::vector<merge_state> states( ps.num_threads );
+    std::vector<std::vector<kitty::static_truth_table<NumVars>>> pending;
+    std::vector<uint32_t> num_merged;
+    for ( auto const& wave : waves )
+    {
+      pending.resize( std::max( pending.size(), wave.size() ) );
+      num_merged.assign( wave.size(), 0u );
+
+      /* small waves are not worth starting threads */
+      const auto num_threads = wave.size() < 64u ? 1u : ps.num_threads;
+      parallel_for( num_threads, wave.size(), [&]( uint64_t i, uint32_t thread_id ) {
+        auto& ms = states[thread_id];
+        pending[i].clear();
+        ms.pending = &pending[i];
+        compute_cuts( wave[i], ms );
+        num_merged[i] = ms.num_merged;
+      } );
+
+      /* insert the truth tables in node order */
+      if constexpr ( ComputeTruth )
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
+        for ( auto i = 0u; i < wave.size(); ++i )
         {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
+          auto j = 0u;
+          for ( auto& cut : cuts.cuts( ntk.node_to_index( wave[i] ) ) )
+          {
+            if ( j++ == num_merged[i] )
+              break;
+            ( *cut )->func_id = cuts._truth_tables.insert( pending[i][( *cut )->func_id] );
+          }
         }
       }
-    } );
+    }
+
+    for ( auto const& ms : states )
+    {
+      add_statistics( ms );
+    }
   }
 
-private:
-  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
+  uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res, merge_state& ms )
   {
-    stopwatch t( st.time_truth_table );
+    stopwatch t( ms.time_truth_table );
 
     std::vector<kitty::static_truth_table<NumVars>> tt( vcuts.size() );
     auto i = 0;
@@ -856,15 +1264,21 @@ private:
       }
     }
 
+    if ( ms.pending )
+    {
+      ms.pending->push_back( tt_res );
+      return static_cast<uint32_t>( ms.pending->size() - 1 );
+    }
     return cuts._truth_tables.insert( tt_res );
   }
 
-  void merge_cuts2( uint32_t index )
+  void merge_cuts2( uint32_t index, merge_state& ms )
   {
+    auto& lcuts = ms.lcuts;
     const auto fanin = 2;
 
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &lcuts]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -876,7 +1290,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    ms.total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -895,7 +1309,7 @@ private:
         {
           vcuts[0] = c1;
           vcuts[1] = c2;
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, ms );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, index );
@@ -907,7 +1321,8 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    ms.total_cuts += rcuts.size();
+    ms.num_merged = static_cast<uint32_t>( rcuts.size() );
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -915,11 +1330,12 @@ private:
     }
   }
 
-  void merge_cuts( uint32_t index )
+  void merge_cuts( uint32_t index, merge_state& ms )
   {
+    auto& lcuts = ms.lcuts;
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes, &lcuts]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -938,7 +1354,7 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      ms.total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -968,7 +1384,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut, ms );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -991,7 +1407,7 @@ private:
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, { cut }, new_cut );
+          new_cut->func_id = compute_truth_table( index, { cut }, new_cut, ms );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -1003,7 +1419,8 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    ms.total_cuts += static_cast<uint32_t>( rcuts.size() );
+    ms.num_merged = static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -1013,8 +1430,6 @@ private:
   cut_enumeration_params const& ps;
   cut_enumeration_stats& st;
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts;
-
-  std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
 };
 } /* namespace detail */
 /*! \endcond */
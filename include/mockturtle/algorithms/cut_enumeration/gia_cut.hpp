@@ -64,6 +64,11 @@ bool operator<( cut_type<ComputeTruth, cut_enumeration_gia_cut> const& c1, cut_t
   return c1.size() < c2.size();
 }
 
+template<>
+struct cut_data_uses_truth_table<cut_enumeration_gia_cut> : std::false_type
+{
+};
+
 template<>
 struct cut_enumeration_update_cut<cut_enumeration_gia_cut>
 {
@@ -67,6 +67,11 @@ bool operator<( cut_type<ComputeTruth, cut_enumeration_tech_map_cut> const& c1,
   return c1->data.flow < c2->data.flow - eps;
 }
 
+template<>
+struct cut_data_uses_truth_table<cut_enumeration_tech_map_cut> : std::false_type
+{
+};
+
 template<>
 struct cut_enumeration_update_cut<cut_enumeration_tech_map_cut>
 {
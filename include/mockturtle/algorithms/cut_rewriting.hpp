@@ -33,7 +33,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <optional>
@@ -46,6 +48,7 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cut_view.hpp"
@@ -101,6 +104,17 @@ struct cut_rewriting_params
   /*! \brief If true, candidates are only accepted if they do not increase logic level of node. */
   bool preserve_depth{ false };
 
+  /*! \brief Number of threads used to generate candidates.
+   *
+   * Only used by `cut_rewriting_with_compatibility_graph`.  If larger than 1,
+   * the rewriting function is called concurrently on scratch networks and must
+   * therefore be safe to call from multiple threads (e.g., `xag_npn_resynthesis`,
+   * but not `exact_resynthesis` or `mig_npn_resynthesis`).  The result does not
+   * depend on the number of threads.  Rewriting with don't cares is always
+   * performed by a single thread.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Show progress. */
   bool progress{ false };
 
@@ -185,6 +199,22 @@ public:
     --_num_vertices;
   }
 
+  /*! \brief Sets the adjacent vertices of all vertices at once.
+   *
+   * The adjacency relation must be symmetric and irreflexive.
+   */
+  void set_adjacency( std::vector<std::set<uint32_t>> adjacent )
+  {
+    assert( adjacent.size() == _weights.size() );
+    _adjacent = std::move( adjacent );
+    _num_edges = 0u;
+    for ( auto const& a : _adjacent )
+    {
+      _num_edges += a.size();
+    }
+    _num_edges /= 2u;
+  }
+
   bool has_vertex( uint32_t vertex ) const
   {
     return _weights[vertex] >= 0;
@@ -288,6 +318,32 @@ struct cut_enumeration_cut_rewriting_cut
   int32_t gain{ -1 };
 };
 
+/* collects the gates of a cut without using the traversal ids of the network,
+ * such that it can be called concurrently; the collected gates serve as the
+ * visited set, as cuts only contain a few gates */
+template<typename Ntk>
+void collect_cut_gates( Ntk const& ntk, node<Ntk> const& root, std::vector<uint32_t> const& leaves, std::vector<node<Ntk>>& stack, std::vector<uint32_t>& gates )
+{
+  stack.clear();
+  stack.push_back( root );
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    stack.pop_back();
+
+    const auto index = ntk.node_to_index( n );
+    if ( ntk.is_constant( n ) ||
+         std::find( leaves.begin(), leaves.end(), index ) != leaves.end() ||
+         std::find( gates.begin(), gates.end(), index ) != gates.end() )
+      continue;
+
+    gates.push_back( index );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      stack.push_back( ntk.get_node( f ) );
+    } );
+  }
+}
+
 template<typename Ntk, bool ComputeTruth>
 std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_graph( Ntk const& ntk, network_cuts<Ntk, ComputeTruth, cut_enumeration_cut_rewriting_cut> const& cuts, cut_rewriting_params const& ps )
 {
@@ -303,6 +359,11 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
   std::vector<cut_addr> vertex_to_cut_addr;
   std::vector<std::vector<uint32_t>> cut_addr_to_vertex( cuts.nodes_size() );
 
+  /* in the multi-threaded case, the leaves of the candidates are collected
+   * first and their conflicts are computed afterwards */
+  const bool parallel = ps.num_threads > 1u;
+  std::vector<std::vector<uint32_t>> vertex_leaves;
+
   ntk.clear_visited();
 
   ntk.foreach_node( [&]( auto const& n, auto index ) {
@@ -328,17 +389,24 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
       if ( ( *cut )->data.gain < ( ps.allow_zero_gain ? 0 : 1 ) )
         continue;
 
-      std::vector<node<Ntk>> leaves;
-      for ( auto leaf_index : *cut )
+      if ( parallel )
       {
-        leaves.push_back( ntk.index_to_node( leaf_index ) );
+        vertex_leaves.emplace_back( cut->begin(), cut->end() );
+      }
+      else
+      {
+        std::vector<node<Ntk>> leaves;
+        for ( auto leaf_index : *cut )
+        {
+          leaves.push_back( ntk.index_to_node( leaf_index ) );
+        }
+        cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ) );
+        dcut.foreach_gate( [&]( auto const& n2 ) {
+          // if ( dcut.is_constant( n2 ) || dcut.is_pi( n2 ) )
+          //   return;
+          conflicts[ntk.node_to_index( n2 )].emplace_back( n, cctr );
+        } );
       }
-      cut_view<Ntk> dcut( ntk, leaves, ntk.make_signal( n ) );
-      dcut.foreach_gate( [&]( auto const& n2 ) {
-        // if ( dcut.is_constant( n2 ) || dcut.is_pi( n2 ) )
-        //   return;
-        conflicts[ntk.node_to_index( n2 )].emplace_back( n, cctr );
-      } );
 
       auto v = g.add_vertex( ( *cut )->data.gain );
       assert( v == vertex_to_cut_addr.size() );
@@ -349,6 +417,46 @@ std::tuple<graph, std::vector<std::pair<node<Ntk>, uint32_t>>> network_cuts_grap
     }
   } );
 
+  if ( parallel )
+  {
+    const auto num_vertices = vertex_to_cut_addr.size();
+
+    /* gates of each candidate */
+    std::vector<std::vector<uint32_t>> gates( num_vertices );
+    std::vector<std::vector<node<Ntk>>> stacks( ps.num_threads );
+    parallel_for( ps.num_threads, num_vertices, [&]( uint64_t v, uint32_t thread_id ) {
+      collect_cut_gates( ntk, vertex_to_cut_addr[v].first, vertex_leaves[v], stacks[thread_id], gates[v] );
+    } );
+
+    /* candidates containing each gate */
+    std::vector<std::vector<uint32_t>> gate_to_vertices( cuts.nodes_size() );
+    for ( auto v = 0u; v < num_vertices; ++v )
+    {
+      for ( auto gate : gates[v] )
+      {
+        gate_to_vertices[gate].push_back( v );
+      }
+    }
+
+    /* two candidates are in conflict if they share a gate */
+    std::vector<std::set<uint32_t>> adjacent( num_vertices );
+    parallel_for( ps.num_threads, num_vertices, [&]( uint64_t v, uint32_t ) {
+      for ( auto gate : gates[v] )
+      {
+        for ( auto w : gate_to_vertices[gate] )
+        {
+          if ( w != v )
+          {
+            adjacent[v].insert( w );
+          }
+        }
+      }
+    } );
+    g.set_adjacency( std::move( adjacent ) );
+
+    return { g, vertex_to_cut_addr };
+  }
+
   for ( auto n = 0u; n < conflicts.size(); ++n )
   {
     for ( auto j = 1u; j < conflicts[n].size(); ++j )
@@ -420,97 +528,93 @@ public:
     const auto size = ntk.size();
     auto max_total_gain = 0u;
     progress_bar pbar{ ntk.size(), "cut_rewriting |{0}| node = {1:>4}@{2:>2} / " + std::to_string( size ) + "   comm. gain = {3}", ps.progress };
-    ntk.foreach_node( [&]( auto const& n, auto index ) {
-      /* stop once all original nodes were visited */
-      if ( index >= size )
-        return false;
-
-      /* do not iterate over constants or PIs */
-      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
-        return true;
 
-      /* skip cuts with small MFFC */
-      if ( mffc_size( ntk, n ) == 1 )
-        return true;
-
-      /* foreach cut */
-      for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    bool candidates_generated{ false };
+    if constexpr ( has_parallel_candidates )
+    {
+      if ( ps.num_threads > 1u && !ps.use_dont_cares )
       {
-        /* skip trivial cuts */
-        if ( cut->size() < ps.min_cand_cut_size )
-          continue;
+        generate_candidates_parallel( cuts, best_replacements, size, max_total_gain, pbar );
+        candidates_generated = true;
+      }
+    }
 
-        const auto tt = cuts.truth_table( *cut );
-        assert( cut->size() == static_cast<unsigned>( tt.num_vars() ) );
+    if ( !candidates_generated )
+    {
+      ntk.foreach_node( [&]( auto const& n, auto index ) {
+        /* stop once all original nodes were visited */
+        if ( index >= size )
+          return false;
 
-        pbar( index, ntk.node_to_index( n ), best_replacements[n].size(), max_total_gain );
+        /* do not iterate over constants or PIs */
+        if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+          return true;
 
-        std::vector<signal<Ntk>> children;
-        for ( auto l : *cut )
-        {
-          children.push_back( ntk.make_signal( ntk.index_to_node( l ) ) );
-        }
+        /* skip cuts with small MFFC */
+        if ( mffc_size( ntk, n ) == 1 )
+          return true;
 
-        int32_t value = recursive_deref<Ntk, NodeCostFn>( ntk, n );
+        /* foreach cut */
+        for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
         {
-          stopwatch t( st.time_rewriting );
-          int32_t best_gain{ -1 };
-
-          const auto on_signal = [&]( auto const& f_new ) {
-            auto [v, contains] = recursive_ref_contains( ntk.get_node( f_new ), n );
-            recursive_deref<Ntk, NodeCostFn>( ntk, ntk.get_node( f_new ) );
+          /* skip trivial cuts */
+          if ( cut->size() < ps.min_cand_cut_size )
+            continue;
 
-            int32_t gain = contains ? -1 : value - v;
+          const auto tt = cuts.truth_table( *cut );
+          assert( cut->size() == static_cast<unsigned>( tt.num_vars() ) );
 
-            if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
-            {
-              if ( best_gain == -1 )
-              {
-                ( *cut )->data.gain = best_gain = gain;
-                best_replacements[n].push_back( f_new );
-              }
-              else if ( gain > best_gain )
-              {
-                ( *cut )->data.gain = best_gain = gain;
-                best_replacements[n].back() = f_new;
-              }
-            }
+          pbar( index, ntk.node_to_index( n ), best_replacements[n].size(), max_total_gain );
 
-            return true;
-          };
+          std::vector<signal<Ntk>> children;
+          for ( auto l : *cut )
+          {
+            children.push_back( ntk.make_signal( ntk.index_to_node( l ) ) );
+          }
 
-          if ( ps.use_dont_cares )
+          int32_t value = recursive_deref<Ntk, NodeCostFn>( ntk, n );
           {
-            if constexpr ( has_rewrite_with_dont_cares_v<Ntk, RewritingFn, decltype( children.begin() )> )
+            stopwatch t( st.time_rewriting );
+            int32_t best_gain{ -1 };
+
+            const auto on_signal = [&]( auto const& f_new ) {
+              evaluate_candidate( n, f_new, value, best_gain, ( *cut )->data.gain, best_replacements[n] );
+              return true;
+            };
+
+            if ( ps.use_dont_cares )
             {
-              std::vector<node<Ntk>> pivots;
-              for ( auto const& c : children )
+              if constexpr ( has_rewrite_with_dont_cares_v<Ntk, RewritingFn, decltype( children.begin() )> )
+              {
+                std::vector<node<Ntk>> pivots;
+                for ( auto const& c : children )
+                {
+                  pivots.push_back( ntk.get_node( c ) );
+                }
+                rewriting_fn( ntk, cuts.truth_table( *cut ), satisfiability_dont_cares( ntk, pivots ), children.begin(), children.end(), on_signal );
+              }
+              else
               {
-                pivots.push_back( ntk.get_node( c ) );
+                rewriting_fn( ntk, cuts.truth_table( *cut ), children.begin(), children.end(), on_signal );
               }
-              rewriting_fn( ntk, cuts.truth_table( *cut ), satisfiability_dont_cares( ntk, pivots ), children.begin(), children.end(), on_signal );
             }
             else
             {
               rewriting_fn( ntk, cuts.truth_table( *cut ), children.begin(), children.end(), on_signal );
             }
-          }
-          else
-          {
-            rewriting_fn( ntk, cuts.truth_table( *cut ), children.begin(), children.end(), on_signal );
-          }
 
-          if ( best_gain > 0 )
-          {
-            max_total_gain += best_gain;
+            if ( best_gain > 0 )
+            {
+              max_total_gain += best_gain;
+            }
           }
-        }
 
-        recursive_ref<Ntk, NodeCostFn>( ntk, n );
-      }
+          recursive_ref<Ntk, NodeCostFn>( ntk, n );
+        }
 
-      return true;
-    } );
+        return true;
+      } );
+    }
 
     stopwatch t2( st.time_mis );
     auto [g, map] = network_cuts_graph( ntk, cuts, ps );
@@ -555,6 +659,216 @@ public:
   }
 
 private:
+  using scratch_network = typename Ntk::base_type;
+  using leaves_iterator = typename std::vector<signal<Ntk>>::iterator;
+
+  static constexpr bool has_parallel_candidates = has_clone_node_v<Ntk> &&
+                                                  std::is_default_constructible_v<scratch_network> &&
+                                                  std::is_same_v<signal<Ntk>, signal<scratch_network>> &&
+                                                  std::is_invocable_v<RewritingFn&, scratch_network&, kitty::dynamic_truth_table const&, leaves_iterator const&, leaves_iterator const&, std::function<bool( signal<Ntk> const& )>>;
+
+  /* scratch network of a thread, the PIs of which are leaves of cuts; it is
+   * rebuilt after each batch of nodes */
+  struct scratch_state
+  {
+    scratch_network ntk;
+    std::vector<signal<Ntk>> old_to_new; /* signal of each scratch node in the network */
+  };
+
+  /* candidates of a node */
+  struct scratch_candidates
+  {
+    uint32_t thread_id{ 0u };
+    std::vector<uint32_t> cut_ends; /* size of the scratch network before and after each cut */
+    std::vector<std::vector<signal<Ntk>>> signals;
+  };
+
+  /* Candidates are generated concurrently for batches of nodes in per-thread
+   * scratch networks.  The nodes created by the rewriting function are then
+   * copied into the network in node order, such that the network is modified
+   * as if the rewriting function had been called on it directly: every node
+   * that is reused in a scratch network has been created for a node that
+   * precedes in the order and has already been copied. */
+  template<class Cuts>
+  void generate_candidates_parallel( Cuts const& cuts, node_map<std::vector<signal<Ntk>>, Ntk>& best_replacements, uint32_t size, uint32_t& max_total_gain, progress_bar& pbar )
+  {
+    /* reference counters are restored after each cut, hence MFFCs can be computed beforehand */
+    std::vector<node<Ntk>> nodes;
+    ntk.foreach_node( [&]( auto const& n, auto index ) {
+      if ( index >= size )
+        return false;
+
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) || mffc_size( ntk, n ) == 1 )
+        return true;
+
+      nodes.push_back( n );
+      return true;
+    } );
+
+    std::vector<scratch_state> states( ps.num_threads );
+    constexpr uint32_t batch_size = 1024u;
+    std::vector<scratch_candidates> batch;
+    for ( auto first = 0u; first < nodes.size(); first += batch_size )
+    {
+      const auto num_nodes = std::min<uint32_t>( batch_size, static_cast<uint32_t>( nodes.size() ) - first );
+      batch.clear();
+      batch.resize( num_nodes );
+      for ( auto& state : states )
+      {
+        reset_scratch_state( state );
+      }
+
+      call_with_stopwatch( st.time_rewriting, [&]() {
+        parallel_for( ps.num_threads, num_nodes, [&]( uint64_t i, uint32_t thread_id ) {
+          batch[i].thread_id = thread_id;
+          generate_candidates( cuts, nodes[first + i], states[thread_id], batch[i] );
+        } );
+      } );
+
+      for ( auto i = 0u; i < num_nodes; ++i )
+      {
+        insert_candidates( cuts, nodes[first + i], states[batch[i].thread_id], batch[i], best_replacements, max_total_gain, pbar );
+      }
+    }
+  }
+
+  void reset_scratch_state( scratch_state& state ) const
+  {
+    auto& scratch = state.ntk;
+    scratch = scratch_network{};
+    state.old_to_new.assign( scratch.size(), signal<Ntk>{} );
+    state.old_to_new[scratch.node_to_index( scratch.get_node( scratch.get_constant( false ) ) )] = ntk.get_constant( false );
+    if ( scratch.get_node( scratch.get_constant( true ) ) != scratch.get_node( scratch.get_constant( false ) ) )
+    {
+      state.old_to_new[scratch.node_to_index( scratch.get_node( scratch.get_constant( true ) ) )] = ntk.get_constant( true );
+    }
+  }
+
+  template<class Cuts>
+  void generate_candidates( Cuts const& cuts, node<Ntk> const& n, scratch_state& state, scratch_candidates& cands ) const
+  {
+    auto& scratch = state.ntk;
+    auto const& set = cuts.cuts( ntk.node_to_index( n ) );
+
+    /* PIs of the leaves of the cuts of this node */
+    std::vector<std::pair<uint32_t, uint32_t>> leaf_to_pi;
+    const auto pi_of = [&]( uint32_t leaf ) {
+      const auto it = std::find_if( leaf_to_pi.begin(), leaf_to_pi.end(), [&]( auto const& p ) { return p.first == leaf; } );
+      return it == leaf_to_pi.end() ? 0u : it->second;
+    };
+
+    for ( auto const& cut : set )
+    {
+      if ( cut->size() < ps.min_cand_cut_size )
+        continue;
+
+      for ( auto l : *cut )
+      {
+        if ( pi_of( l ) == 0u )
+        {
+          const auto pi = scratch.get_node( scratch.create_pi() );
+          leaf_to_pi.emplace_back( l, scratch.node_to_index( pi ) );
+          state.old_to_new.resize( scratch.size() );
+          state.old_to_new[scratch.node_to_index( pi )] = ntk.make_signal( ntk.index_to_node( l ) );
+        }
+      }
+    }
+    cands.cut_ends.push_back( scratch.size() );
+
+    for ( auto const& cut : set )
+    {
+      if ( cut->size() < ps.min_cand_cut_size )
+        continue;
+
+      std::vector<signal<Ntk>> children;
+      for ( auto l : *cut )
+      {
+        children.push_back( scratch.make_signal( scratch.index_to_node( pi_of( l ) ) ) );
+      }
+
+      auto& signals = cands.signals.emplace_back();
+      rewriting_fn( scratch, cuts.truth_table( *cut ), children.begin(), children.end(), [&]( auto const& f_new ) {
+        signals.push_back( f_new );
+        return true;
+      } );
+      cands.cut_ends.push_back( scratch.size() );
+    }
+  }
+
+  template<class Cuts>
+  void insert_candidates( Cuts const& cuts, node<Ntk> const& n, scratch_state& state, scratch_candidates const& cands, node_map<std::vector<signal<Ntk>>, Ntk>& best_replacements, uint32_t& max_total_gain, progress_bar& pbar )
+  {
+    auto const& scratch = state.ntk;
+    auto& old_to_new = state.old_to_new;
+    old_to_new.resize( scratch.size() );
+
+    const auto map_signal = [&]( auto const& f ) {
+      const auto s = old_to_new[scratch.node_to_index( scratch.get_node( f ) )];
+      return scratch.is_complemented( f ) ? ntk.create_not( s ) : s;
+    };
+
+    auto ctr = 0u;
+    for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      if ( cut->size() < ps.min_cand_cut_size )
+        continue;
+
+      pbar( ntk.node_to_index( n ), ntk.node_to_index( n ), best_replacements[n].size(), max_total_gain );
+
+      int32_t value = recursive_deref<Ntk, NodeCostFn>( ntk, n );
+      {
+        stopwatch t( st.time_rewriting );
+
+        /* copy the nodes created by the rewriting function for this cut */
+        for ( auto i = cands.cut_ends[ctr]; i < cands.cut_ends[ctr + 1]; ++i )
+        {
+          const auto s = scratch.index_to_node( i );
+          std::vector<signal<Ntk>> children;
+          scratch.foreach_fanin( s, [&]( auto const& f ) {
+            children.push_back( map_signal( f ) );
+          } );
+          old_to_new[i] = ntk.clone_node( scratch, s, children );
+        }
+
+        int32_t best_gain{ -1 };
+        for ( auto const& f : cands.signals[ctr] )
+        {
+          evaluate_candidate( n, map_signal( f ), value, best_gain, ( *cut )->data.gain, best_replacements[n] );
+        }
+
+        if ( best_gain > 0 )
+        {
+          max_total_gain += best_gain;
+        }
+      }
+
+      recursive_ref<Ntk, NodeCostFn>( ntk, n );
+      ++ctr;
+    }
+  }
+
+  void evaluate_candidate( node<Ntk> const& n, signal<Ntk> const& f_new, int32_t value, int32_t& best_gain, int32_t& cut_gain, std::vector<signal<Ntk>>& replacements )
+  {
+    auto [v, contains] = recursive_ref_contains( ntk.get_node( f_new ), n );
+    recursive_deref<Ntk, NodeCostFn>( ntk, ntk.get_node( f_new ) );
+
+    int32_t gain = contains ? -1 : value - v;
+
+    if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
+    {
+      if ( best_gain == -1 )
+      {
+        cut_gain = best_gain = gain;
+        replacements.push_back( f_new );
+      }
+      else if ( gain > best_gain )
+      {
+        cut_gain = best_gain = gain;
+        replacements.back() = f_new;
+      }
+    }
+  }
+
   std::pair<int32_t, bool> recursive_ref_contains( node<Ntk> const& n, node<Ntk> const& repl )
   {
     /* terminate? */
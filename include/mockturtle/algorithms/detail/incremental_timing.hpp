@@ -0,0 +1,246 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file incremental_timing.hpp
+  \brief Incremental required time propagation for mappers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../../traits.hpp"
+
+namespace mockturtle::detail
+{
+
+/*! \brief Incremental required time propagation over a cover.
+ *
+ * Keeps track of the fanins of each node in the current cover of a mapper
+ * and of a key describing how the node is implemented (selected matches,
+ * phases, ...).  When the key or the fanins of a node change, the node and
+ * its old and new fanins are scheduled for an update.  Scheduled nodes are
+ * processed in decreasing level order using a level-bucketed worklist: the
+ * required time of a node is recomputed from its fanouts in the cover and,
+ * only if it changed, its fanins are scheduled as well.
+ *
+ * The required times are stored by the mapper, which provides the function
+ * recomputing them.  The levels must be such that the fanins of a node in
+ * the cover have a lower level than the node, e.g., the depth of the nodes
+ * in the subject graph.  Before the first update, and every time the
+ * required times are changed outside of `update`, the mapper must compute
+ * all the required times from scratch and call `validate`.
+ */
+template<typename Key>
+class incremental_required_times
+{
+public:
+  incremental_required_times() = default;
+
+  explicit incremental_required_times( std::vector<uint32_t> levels )
+      : _levels( std::move( levels ) ),
+        _keys( _levels.size() ),
+        _fanins( _levels.size() ),
+        _fanouts( _levels.size() ),
+        _queued( _levels.size(), false )
+  {
+    uint32_t max_level = 0;
+    for ( auto l : _levels )
+    {
+      max_level = std::max( max_level, l );
+    }
+    _buckets.resize( max_level + 1 );
+  }
+
+  /*! \brief Returns whether the required times are up to date. */
+  bool is_valid() const
+  {
+    return _valid;
+  }
+
+  /*! \brief Declares that the required times have been recomputed. */
+  void validate()
+  {
+    clear_worklist();
+    _valid = true;
+  }
+
+  /*! \brief Declares that the required times must be recomputed. */
+  void invalidate()
+  {
+    _valid = false;
+  }
+
+  /*! \brief Records the implementation of a node in the cover.
+   *
+   * Unused nodes must be recorded with an empty range of fanins.  Returns
+   * true if the implementation of the node changed.
+   */
+  template<typename Iterator>
+  bool set_node( uint32_t index, Key const& key, Iterator begin, Iterator end )
+  {
+    auto& fanins = _fanins[index];
+    if ( key == _keys[index] && std::equal( fanins.begin(), fanins.end(), begin, end ) )
+    {
+      return false;
+    }
+
+    mark( index );
+    for ( auto f : fanins )
+    {
+      mark( f );
+      auto& fanouts = _fanouts[f];
+      auto it = std::find( fanouts.begin(), fanouts.end(), index );
+      *it = fanouts.back();
+      fanouts.pop_back();
+    }
+
+    _keys[index] = key;
+    fanins.assign( begin, end );
+    for ( auto f : fanins )
+    {
+      mark( f );
+      _fanouts[f].push_back( index );
+    }
+
+    return true;
+  }
+
+  /*! \brief Records a node that is not used in the cover. */
+  bool set_unused( uint32_t index )
+  {
+    uint32_t const* none = nullptr;
+    return set_node( index, Key{}, none, none );
+  }
+
+  /*! \brief Schedules the required time of a node for an update. */
+  void mark( uint32_t index )
+  {
+    if ( _queued[index] )
+      return;
+
+    _queued[index] = true;
+    _buckets[_levels[index]].push_back( index );
+    _top_level = std::max( _top_level, _levels[index] + 1 );
+  }
+
+  /*! \brief Calls `fn` on each fanout of a node in the cover.
+   *
+   * A fanout is visited once for each occurrence of the node among its
+   * fanins.
+   */
+  template<typename Fn>
+  void foreach_fanout( uint32_t index, Fn&& fn ) const
+  {
+    for ( auto f : _fanouts[index] )
+    {
+      fn( f );
+    }
+  }
+
+  /*! \brief Updates the required times of the scheduled nodes.
+   *
+   * Calls `recompute( index )` on the scheduled nodes in decreasing level
+   * order.  The function must recompute the required time of the node from
+   * its fanouts and return true if it changed.  Returns the number of nodes
+   * that have been recomputed.
+   */
+  template<typename Fn>
+  uint32_t update( Fn&& recompute )
+  {
+    uint32_t num_updates = 0;
+    while ( _top_level > 0 )
+    {
+      auto& bucket = _buckets[--_top_level];
+      for ( auto i = 0u; i < bucket.size(); ++i )
+      {
+        const auto index = bucket[i];
+        _queued[index] = false;
+        ++num_updates;
+        if ( recompute( index ) )
+        {
+          for ( auto f : _fanins[index] )
+          {
+            mark( f );
+          }
+        }
+      }
+      bucket.clear();
+    }
+    return num_updates;
+  }
+
+private:
+  void clear_worklist()
+  {
+    while ( _top_level > 0 )
+    {
+      auto& bucket = _buckets[--_top_level];
+      for ( auto index : bucket )
+      {
+        _queued[index] = false;
+      }
+      bucket.clear();
+    }
+  }
+
+private:
+  std::vector<uint32_t> _levels;
+  std::vector<Key> _keys;
+  std::vector<std::vector<uint32_t>> _fanins;
+  std::vector<std::vector<uint32_t>> _fanouts;
+
+  std::vector<std::vector<uint32_t>> _buckets;
+  std::vector<bool> _queued;
+  uint32_t _top_level{ 0 };
+  bool _valid{ false };
+};
+
+/*! \brief Computes levels for incremental required time propagation.
+ *
+ * Returns the depth of each node in the network, indexed by node index.
+ * Nodes are visited in the given topological order.
+ */
+template<typename Ntk>
+std::vector<uint32_t> compute_timing_levels( Ntk const& ntk, std::vector<node<Ntk>> const& topo_order )
+{
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  for ( auto const& n : topo_order )
+  {
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      continue;
+
+    auto& level = levels[ntk.node_to_index( n )];
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] + 1 );
+    } );
+  }
+  return levels;
+}
+
+} // namespace mockturtle::detail
@@ -32,8 +32,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
+#include "../../traits.hpp"
+#include "../sequential_simulation.hpp"
 #include "../simulation.hpp"
 
 #include <kitty/bit_operations.hpp>
@@ -42,10 +46,33 @@
 namespace mockturtle::detail
 {
 
+/*! \brief Switching Activity of a sequential network.
+ *
+ * This function computes the toggle rate of each node in the
+ * network by cycle-based simulation of random input sequences,
+ * starting from the initial values of the registers.  The
+ * samples are distributed over traces of 16 transitions.
+ *
+ * \param ntk Sequential network
+ * \param simulation_size Number of simulation samples
+ */
+template<typename Ntk>
+std::vector<float> sequential_switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
+{
+  sequential_simulation_params ps;
+  ps.num_words = std::max( 1u, simulation_size / ( 64u * 16u ) );
+
+  sequential_simulator<Ntk> sim( ntk, ps );
+  sim.simulate_random_cycles( 17u );
+  return sim.switching_activity();
+}
+
 /*! \brief Switching Activity.
  *
  * This function computes the switching activity for each node
- * in the network by performing random simulation.
+ * in the network by performing random simulation.  Networks
+ * with registers are simulated cycle by cycle (see
+ * `sequential_switching_activity`).
  *
  * \param ntk Network
  * \param simulation_size Number of simulation bits
@@ -53,6 +80,14 @@ namespace mockturtle::detail
 template<typename Ntk>
 std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
 {
+  if constexpr ( has_foreach_ro_v<Ntk> && ( is_aig_like_v<typename Ntk::base_type> || std::is_same_v<typename Ntk::base_type, klut_network> ) )
+  {
+    if ( ntk.num_registers() > 0u )
+    {
+      return sequential_switching_activity( ntk, simulation_size );
+    }
+  }
+
   std::vector<float> sw_map( ntk.size() );
   partial_simulator sim( ntk.num_pis(), simulation_size );
 
@@ -54,6 +54,7 @@
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/cell_view.hpp"
 #include "../views/choice_view.hpp"
@@ -131,6 +132,12 @@ struct emap_params
   /*! \brief Number of patterns for switching activity computation. */
   uint32_t switching_activity_patterns{ 2048u };
 
+  /*! \brief Custom switching activity of each node (e.g., from `sequential_simulator`).
+   *
+   * If empty, the switching activity is computed by random simulation.
+   */
+  std::vector<float> switching_activity{};
+
   /*! \brief Compute area-oriented alternative matches */
   bool use_match_alternatives{ true };
 
@@ -227,6 +234,16 @@ struct cut_enumeration_emap_multi_cut
   uint64_t id{ 0 };
 };
 
+} /* namespace detail */
+
+template<>
+struct cut_data_uses_truth_table<detail::cut_enumeration_emap_multi_cut> : std::false_type
+{
+};
+
+namespace detail
+{
+
 enum class emap_cut_sort_type
 {
   DELAY = 0,
@@ -801,13 +818,14 @@ public:
         st( st ),
         node_match( ntk.size() ),
         node_tuple_match( ntk.size() ),
-        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
+        switch_activity( !ps.eswp_rounds ? std::vector<float>( 0 ) : ( ps.switching_activity.empty() ? switching_activity( ntk, ps.switching_activity_patterns ) : ps.switching_activity ) ),
         cuts( ntk.size() )
   {
     std::memset( node_tuple_match.data(), 0, sizeof( multioutput_info ) * ntk.size() );
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
     tmp_visited.reserve( 100 );
+    assert( !ps.eswp_rounds || switch_activity.size() == ntk.size() );
   }
 
   explicit emap_impl( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, std::vector<float> const& switch_activity, emap_params const& ps, emap_stats& st )
@@ -828,6 +846,7 @@ public:
 
   cell_view<block_network> run_block()
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_block_network();
@@ -886,6 +905,7 @@ public:
 
   binding_view<klut_network> run_klut()
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_map_network();
@@ -944,6 +964,7 @@ public:
 
   binding_view<klut_network> run_node_map()
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_map_network();
@@ -1028,6 +1049,7 @@ private:
   template<bool DO_AREA>
   bool compute_mapping_match()
   {
+    MOCKTURTLE_TRACE_SCOPE( DO_AREA ? "emap/match_area" : "emap/match_delay" );
     bool warning_box = false;
 
     for ( auto const& n : topo_order )
@@ -1251,6 +1273,7 @@ private:
     }
 
     cuts_total += rcuts.size();
+    MOCKTURTLE_TRACE_COUNT( "emap/cuts", rcuts.size() );
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1356,12 +1379,14 @@ private:
     }
 
     cuts_total += rcuts.size();
+    MOCKTURTLE_TRACE_COUNT( "emap/cuts", rcuts.size() );
 
     add_unit_cut( index );
   }
 
   bool compute_struct_match()
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap/struct_match" );
     if ( ps.matching_mode == emap_params::boolean )
       return true;
 
@@ -1498,6 +1523,7 @@ private:
     }
 
     cuts_total += rcuts.size();
+    MOCKTURTLE_TRACE_COUNT( "emap/cuts", rcuts.size() );
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1512,6 +1538,7 @@ private:
   template<bool DO_AREA>
   bool compute_mapping_match_node()
   {
+    MOCKTURTLE_TRACE_SCOPE( DO_AREA ? "emap/match_area" : "emap/match_delay" );
     for ( auto const& n : topo_order )
     {
       auto const index = ntk.node_to_index( n );
@@ -1612,6 +1639,7 @@ private:
   template<bool DO_AREA>
   bool compute_mapping()
   {
+    MOCKTURTLE_TRACE_SCOPE( DO_AREA ? "emap/area_flow" : "emap/delay" );
     for ( auto const& n : topo_order )
     {
       uint32_t index = ntk.node_to_index( n );
@@ -1694,6 +1722,7 @@ private:
   template<bool SwitchActivity>
   bool compute_mapping_exact_reversed()
   {
+    MOCKTURTLE_TRACE_SCOPE( SwitchActivity ? "emap/exact_switching" : "emap/exact_area" );
     for ( auto it = topo_order.rbegin(); it != topo_order.rend(); ++it )
     {
       if ( ntk.is_constant( *it ) || ntk.is_pi( *it ) )
@@ -4187,6 +4216,7 @@ private:
 
   void finalize_cover( binding_view<klut_network>& res, klut_map& old2new )
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap/finalize" );
     uint32_t multioutput_count = 0;
 
     for ( auto const& n : topo_order )
@@ -4292,6 +4322,7 @@ private:
 
   void finalize_cover_block( cell_view<block_network>& res, block_map& old2new )
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap/finalize" );
     uint32_t multioutput_count = 0;
 
     /* get standard cells */
@@ -5037,6 +5068,7 @@ private:
   /* Experimental code */
   void compute_multioutput_match()
   {
+    MOCKTURTLE_TRACE_SCOPE( "emap/multioutput" );
     stopwatch t( st.time_multioutput );
 
     if ( library.num_multioutput_gates() == 0 )
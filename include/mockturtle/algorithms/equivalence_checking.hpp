@@ -42,6 +42,7 @@
 #include "../traits.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/tracing.hpp"
 #include "../networks/klut.hpp"
 #include "cnf.hpp"
 
@@ -117,6 +118,7 @@ public:
 
   std::optional<bool> run()
   {
+    MOCKTURTLE_TRACE_SCOPE( "equivalence_checking" );
     stopwatch<> t( st_.time_total );
 
     percy::bsat_wrapper solver;
@@ -147,7 +149,11 @@ public:
       } )[0];
     }
 
-    const auto res = solver.solve( &output, &output + 1, ps_.conflict_limit );
+    MOCKTURTLE_TRACE_COUNT( "equivalence_checking/sat_calls", 1 );
+    const auto res = [&]() {
+      MOCKTURTLE_TRACE_SCOPE( "equivalence_checking/sat" );
+      return solver.solve( &output, &output + 1, ps_.conflict_limit );
+    }();
 
     switch ( res )
     {
@@ -186,12 +192,17 @@ public:
 
   std::optional<bool> run()
   {
+    MOCKTURTLE_TRACE_SCOPE( "equivalence_checking" );
     stopwatch<> t( st_.time_total );
 
     bill::solver<Solver> solver;
     bill::lit_type output = convert_to_cnf( miter_, solver );
 
-    const auto res = solver.solve( {output}, ps_.conflict_limit );
+    MOCKTURTLE_TRACE_COUNT( "equivalence_checking/sat_calls", 1 );
+    const auto res = [&]() {
+      MOCKTURTLE_TRACE_SCOPE( "equivalence_checking/sat" );
+      return solver.solve( { output }, ps_.conflict_limit );
+    }();
 
     switch ( res )
     {
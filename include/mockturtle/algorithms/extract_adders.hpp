@@ -126,6 +126,16 @@ struct cut_enumeration_fa_cut
   bool is_xor{ false };
 };
 
+} /* namespace detail */
+
+template<>
+struct cut_data_uses_truth_table<detail::cut_enumeration_fa_cut> : std::false_type
+{
+};
+
+namespace detail
+{
+
 template<class Ntk>
 class extract_adders_impl
 {
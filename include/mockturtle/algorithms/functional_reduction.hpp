@@ -33,8 +33,10 @@
 
 #pragma once
 
+#include "../utils/choice_classes.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/fanout_view.hpp"
 
 #include <bill/sat/interface/abc_bsat2.hpp>
@@ -155,12 +157,20 @@ public:
     }
   }
 
+  /*! \brief Records the proven equivalences between nodes before substituting them. */
+  void record_equivalences( std::vector<std::pair<node, signal>>& equivalences )
+  {
+    _equivalences = &equivalences;
+  }
+
   void run()
   {
+    MOCKTURTLE_TRACE_SCOPE( "functional_reduction" );
     stopwatch t( st.time_total );
 
     /* first simulation: the whole circuit; from 0 bits. */
     call_with_stopwatch( st.time_sim, [&]() {
+      MOCKTURTLE_TRACE_SCOPE( "functional_reduction/simulation" );
       simulate_nodes<Ntk>( ntk, tts, sim, true );
     } );
 
@@ -181,6 +191,7 @@ public:
 private:
   void substitute_constants()
   {
+    MOCKTURTLE_TRACE_SCOPE( "functional_reduction/constants" );
     progress_bar pbar{ ntk.size(), "FR-const |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
 
     auto zero = sim.compute_constant( false );
@@ -206,6 +217,7 @@ private:
       /* update progress bar */
       candidates++;
 
+      MOCKTURTLE_TRACE_COUNT( "functional_reduction/sat_calls", 1 );
       const auto res = call_with_stopwatch( st.time_sat, [&]() {
         return validator.validate( n, const_value );
       } );
@@ -222,6 +234,7 @@ private:
       }
       else /* UNSAT, constant verified */
       {
+        MOCKTURTLE_TRACE_COUNT( "functional_reduction/reductions", 1 );
         ++st.num_reduction;
         ++st.num_const_accepts;
         /* update network */
@@ -233,6 +246,7 @@ private:
 
   void substitute_equivalent_nodes()
   {
+    MOCKTURTLE_TRACE_SCOPE( "functional_reduction/equivalences" );
     progress_bar pbar{ ntk.size(), "FR-equ |{0}| node = {1:>4}   cand = {2:>4}", ps.progress };
     ntk.foreach_gate( [&]( auto const& root, auto i ) {
       pbar( i, i, candidates );
@@ -331,6 +345,7 @@ private:
     /* update progress bar */
     candidates++;
 
+    MOCKTURTLE_TRACE_COUNT( "functional_reduction/sat_calls", 1 );
     const auto res = call_with_stopwatch( st.time_sat, [&]() {
       return validator.validate( root, g );
     } );
@@ -349,9 +364,14 @@ private:
     }
     else /* UNSAT, equivalent node verified */
     {
+      MOCKTURTLE_TRACE_COUNT( "functional_reduction/reductions", 1 );
       ++st.num_reduction;
       ++st.num_equ_accepts;
       /* update network */
+      if ( _equivalences )
+      {
+        _equivalences->emplace_back( root, g );
+      }
       ntk.substitute_node( root, g );
       return false; /* break `foreach_transitive_fanin` */
     }
@@ -359,6 +379,7 @@ private:
 
   void found_cex()
   {
+    MOCKTURTLE_TRACE_COUNT( "functional_reduction/counterexamples", 1 );
     ++st.num_cex;
     sim.add_pattern( validator.cex );
 
@@ -438,6 +459,7 @@ private:
   validator_t validator;
 
   uint32_t candidates{ 0 };
+  std::vector<std::pair<node, signal>>* _equivalences{ nullptr };
 }; /* functional_reduction_impl */
 
 } /* namespace detail */
@@ -485,4 +507,60 @@ void functional_reduction( Ntk& ntk, functional_reduction_params const& ps = {},
   }
 }
 
+/*! \brief Functional reduction with structural choices.
+ *
+ * Runs functional reduction and keeps the substituted nodes as structural
+ * choices of the nodes they are equivalent to.  The substituted nodes are
+ * dead in the returned network, but their structure is kept in its storage,
+ * such that the returned choices can be used for choice-aware cut
+ * enumeration (`choice_cut_enumeration`).  The network must not
+ * be cleaned up while the choices are used.
+ *
+ * Equivalences to constants are substituted without choices.
+ */
+template<class Ntk>
+choice_classes<Ntk> functional_choices( Ntk& ntk, functional_reduction_params const& ps = {}, functional_reduction_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
+  static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_substitute_node_v<Ntk>, "Ntk does not implement the substitute_node method" );
+  static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+
+  validator_params vps;
+  vps.max_clauses = ps.max_clauses;
+  vps.conflict_limit = ps.conflict_limit;
+
+  std::vector<std::pair<node<Ntk>, signal<Ntk>>> equivalences;
+  {
+    using fanout_view_t = fanout_view<Ntk>;
+    fanout_view_t fanout_view{ ntk };
+
+    functional_reduction_stats st;
+    detail::functional_reduction_impl p( fanout_view, ps, vps, st );
+    p.record_equivalences( equivalences );
+    p.run();
+
+    if ( ps.verbose )
+    {
+      st.report();
+    }
+
+    if ( pst )
+    {
+      *pst = st;
+    }
+  }
+
+  return choice_classes<Ntk>( ntk, equivalences );
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
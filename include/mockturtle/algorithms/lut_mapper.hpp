@@ -36,6 +36,8 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -52,14 +54,17 @@
 #include "../utils/cuts.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/tracing.hpp"
 #include "../utils/truth_table_cache.hpp"
 #include "../views/choice_view.hpp"
 #include "../views/mapping_view.hpp"
 #include "../views/mffc_view.hpp"
 #include "../views/topo_view.hpp"
+#include "balancing/utils.hpp"
 #include "cleanup.hpp"
 #include "collapse_mapped.hpp"
 #include "cut_enumeration.hpp"
+#include "detail/incremental_timing.hpp"
 #include "exorcism.hpp"
 #include "simulation.hpp"
 
@@ -127,6 +132,14 @@ struct lut_map_params
   /*! \brief Depth optimization by balancing ESOPs */
   bool esop_balancing{ false };
 
+  /*! \brief Cache of ISOPs or ESOPs for balancing (optional).
+   *
+   * If set, the covers for `sop_balancing` or `esop_balancing` are looked
+   * up in and stored into this cache, which can be shared with the cache of
+   * `sop_rebalancing` or `esop_rebalancing` respectively.
+   */
+  std::shared_ptr<decomposition_cache> decompositions{};
+
   /*! \brief Maximum number variables for cost function caching */
   uint32_t cost_cache_vars{ 3u };
 
@@ -620,6 +633,7 @@ public:
   using isop_cache = std::vector<sop_t>;
   using cubes_queue_t = std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>;
   using lut_info = std::pair<kitty::dynamic_truth_table, std::vector<signal<klut_network>>>;
+  using timing_t = incremental_required_times<uint64_t>;
 
 public:
   explicit lut_map_impl( Ntk& ntk, lut_map_params const& ps, lut_map_stats& st )
@@ -660,6 +674,7 @@ public:
 
   klut_network run()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map" );
     stopwatch t( st.time_total );
 
     /* compute and save topological order */
@@ -674,6 +689,7 @@ public:
 
   void run_inplace()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map" );
     stopwatch t( st.time_total );
 
     /* compute and save topological order */
@@ -701,6 +717,7 @@ private:
     /* init the data structure */
     init_nodes();
     init_cuts();
+    init_timing();
 
     /* compute mapping for depth or area */
     if ( !ps.area_oriented_mapping )
@@ -787,6 +804,15 @@ private:
     } );
   }
 
+  void init_timing()
+  {
+    timing = timing_t( compute_timing_levels( ntk, topo_order ) );
+    timing_outputs.assign( ntk.size(), false );
+    ntk.foreach_co( [&]( auto const& s ) {
+      timing_outputs[ntk.node_to_index( ntk.get_node( s ) )] = true;
+    } );
+  }
+
   void init_cuts()
   {
     /* init constant cut */
@@ -803,6 +829,7 @@ private:
   template<bool DO_AREA, bool ELA>
   void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
   {
+    MOCKTURTLE_TRACE_SCOPE( ELA ? "lut_map/exact_area" : ( DO_AREA ? "lut_map/area_flow" : "lut_map/delay" ) );
     cuts_total = 0;
     for ( auto const& n : topo_order )
     {
@@ -875,6 +902,7 @@ private:
 
   void compute_share_mapping( lut_cut_sort_type const sort, bool first )
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/area_share" );
     /* reset required times and references except for POs */
     compute_share_mapping_init( first );
 
@@ -890,6 +918,10 @@ private:
       update_cut_data_share( *it, sort );
     }
 
+    /* record the new cover, the required times are recomputed from scratch in the next round */
+    record_cover();
+    timing.invalidate();
+
     /* propagate correct arrival times and compute stats */
     propagate_arrival_times();
 
@@ -902,6 +934,7 @@ private:
   template<bool ELA>
   void expand_cuts()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/cut_expansion" );
     /* cut expansion is not yet compatible with truth table computation */
     if constexpr ( StoreFunction )
       return;
@@ -966,9 +999,13 @@ private:
 
       /* continue if not referenced in the cover */
       if ( node_match[index].map_refs == 0u )
+      {
+        timing.set_unused( index );
         continue;
+      }
 
       auto& best_cut = cuts[index][0];
+      timing.set_node( index, ( static_cast<uint64_t>( best_cut->data.lut_delay ) << 1 ) | 1u, best_cut.begin(), best_cut.end() );
 
       if constexpr ( !ELA )
       {
@@ -984,16 +1021,39 @@ private:
     ++iteration;
   }
 
-  void compute_required_time()
+  /* records the current cover for the incremental update of the required times */
+  void record_cover()
   {
-    for ( auto i = 0u; i < node_match.size(); ++i )
+    for ( auto const& n : topo_order )
     {
-      node_match[i].required = UINT32_MAX >> 1;
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        continue;
+
+      const auto index = ntk.node_to_index( n );
+      if ( node_match[index].map_refs == 0u )
+      {
+        timing.set_unused( index );
+        continue;
+      }
+
+      auto const& best_cut = cuts[index][0];
+      timing.set_node( index, ( static_cast<uint64_t>( best_cut->data.lut_delay ) << 1 ) | 1u, best_cut.begin(), best_cut.end() );
     }
+  }
 
+  void compute_required_time()
+  {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/required_times" );
     /* return in case of area_oriented_mapping */
     if ( iteration == 0 || ps.area_oriented_mapping )
+    {
+      for ( auto i = 0u; i < node_match.size(); ++i )
+      {
+        node_match[i].required = UINT32_MAX >> 1;
+      }
+      timing.invalidate();
       return;
+    }
 
     uint32_t required = delay;
 
@@ -1017,6 +1077,25 @@ private:
       }
     }
 
+    /* in case of decomposition cost, the required times are recomputed */
+    bool incremental = true;
+    if constexpr ( StoreFunction )
+    {
+      incremental = !ps.sop_balancing && !ps.esop_balancing;
+    }
+
+    /* update only the cones in which the cover changed */
+    if ( incremental && timing.is_valid() && required == timing_required )
+    {
+      timing.update( [this]( uint32_t index ) { return recompute_required_time( index ); } );
+      return;
+    }
+
+    for ( auto i = 0u; i < node_match.size(); ++i )
+    {
+      node_match[i].required = UINT32_MAX >> 1;
+    }
+
     /* set the required time at POs */
     ntk.foreach_co( [&]( auto const& s ) {
       const auto index = ntk.node_to_index( ntk.get_node( s ) );
@@ -1049,6 +1128,28 @@ private:
         node_match[leaf].required = std::min( node_match[leaf].required, node_match[index].required - cuts[index][0]->data.lut_delay );
       }
     }
+
+    timing_required = required;
+    if ( incremental )
+    {
+      timing.validate();
+    }
+  }
+
+  /* recomputes the required time of a node from its fanouts in the cover */
+  bool recompute_required_time( uint32_t index )
+  {
+    uint32_t required = timing_outputs[index] ? timing_required : UINT32_MAX >> 1;
+
+    timing.foreach_fanout( index, [&]( uint32_t f ) {
+      required = std::min( required, node_match[f].required - cuts[f][0]->data.lut_delay );
+    } );
+
+    if ( required == node_match[index].required )
+      return false;
+
+    node_match[index].required = required;
+    return true;
   }
 
   void propagate_arrival_times()
@@ -1227,6 +1328,7 @@ private:
     }
 
     cuts_total += rcuts.size();
+    MOCKTURTLE_TRACE_COUNT( "lut_map/cuts", rcuts.size() );
 
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_enumeration_ps.cut_limit );
@@ -1395,6 +1497,7 @@ private:
     }
 
     cuts_total += rcuts.size();
+    MOCKTURTLE_TRACE_COUNT( "lut_map/cuts", rcuts.size() );
 
     /* replace the new best cut with previous one */
     if ( preprocess && rcuts[0]->data.delay > node_data.required )
@@ -2116,6 +2219,7 @@ private:
 
   void compute_mffcs_mapping()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/collapse_mffcs" );
     ntk.clear_mapping();
 
     /* map POs */
@@ -2249,6 +2353,7 @@ private:
 #pragma region Dump network
   klut_network create_lut_network()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/derive" );
     /* specialized method: does not support buffer/inverter sweeping */
     if ( StoreFunction && ps.cut_enumeration_ps.minimize_truth_table )
     {
@@ -2504,6 +2609,7 @@ private:
 
   void derive_mapping()
   {
+    MOCKTURTLE_TRACE_SCOPE( "lut_map/derive" );
     ntk.clear_mapping();
 
     for ( auto const& n : topo_order )
@@ -2595,49 +2701,25 @@ private:
 
     assert( func_id == isops.size() );
 
-    sop_t sop, sop_n;
-    if ( ps.sop_balancing )
+    auto const& tt = truth_tables[func_id << 1u];
+    bool inverted;
+    std::optional<sop_t> cached;
+    if ( ps.decompositions )
     {
-      sop = kitty::isop( truth_tables[func_id << 1u] );
+      cached = ps.decompositions->find( tt, both_phases, inverted );
     }
-    else
+
+    sop_t sop;
+    if ( cached )
     {
-      sop = exorcism( truth_tables[func_id << 1u] );
+      sop = std::move( *cached );
     }
-
-    if ( both_phases )
+    else
     {
-      sop_t n_sop;
-      if ( ps.sop_balancing )
-      {
-        n_sop = kitty::isop( ~truth_tables[func_id << 1u] );
-      }
-      else
+      sop = cheaper_phase_cover( tt, both_phases, [&]( auto const& f ) { return ps.sop_balancing ? kitty::isop( f ) : exorcism( f ); }, inverted );
+      if ( ps.decompositions )
       {
-        n_sop = exorcism( ~truth_tables[func_id << 1u] );
-      }
-
-      if ( n_sop.size() < sop.size() )
-      {
-        sop.swap( n_sop );
-      }
-      else if ( n_sop.size() == sop.size() )
-      {
-        /* compute literal cost */
-        uint32_t lit = 0, n_lit = 0;
-        for ( auto const& c : sop )
-        {
-          lit += c.num_literals();
-        }
-        for ( auto const& c : n_sop )
-        {
-          n_lit += c.num_literals();
-        }
-
-        if ( n_lit < lit )
-        {
-          sop.swap( n_sop );
-        }
+        ps.decompositions->insert( inverted ? ~tt : tt, sop );
       }
     }
 
@@ -2843,6 +2925,10 @@ private:
   std::vector<uint32_t> tmp_visited;
   std::vector<node_lut> node_match;
 
+  timing_t timing;                  /* incremental required times */
+  std::vector<bool> timing_outputs; /* nodes driving a CO */
+  uint32_t timing_required{ 0 };    /* required time at the COs */
+
   std::vector<cut_set_t> cuts;  /* compressed representation of cuts */
   cut_merge_t lcuts;            /* cut merger container */
   tt_cache truth_tables;        /* cut truth tables */
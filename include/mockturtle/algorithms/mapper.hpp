@@ -43,6 +43,7 @@
 #include "../networks/sequential.hpp"
 #include "../networks/xag.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
 #include "../views/binding_view.hpp"
@@ -54,6 +55,7 @@
 #include "cut_enumeration.hpp"
 #include "cut_enumeration/exact_map_cut.hpp"
 #include "cut_enumeration/tech_map_cut.hpp"
+#include "detail/incremental_timing.hpp"
 #include "detail/mffc_utils.hpp"
 #include "detail/switching_activity.hpp"
 #include "reconv_cut.hpp"
@@ -114,6 +116,13 @@ struct map_params
   /*! \brief Window size for don't cares calculation. */
   uint32_t window_size{ 12u };
 
+  /*! \brief Number of threads for cut enumeration and matching.
+   *
+   * The mapping result does not depend on the number of threads.  Matching
+   * with don't cares is always performed on a single thread.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -174,6 +183,23 @@ struct cut_match_tech
   std::array<uint8_t, 2> negations{ 0, 0 };
 };
 
+/* implementation of a node in the cover, used to update the required times */
+template<typename Gate>
+struct cover_timing_key
+{
+  Gate const* gates[2] = { nullptr, nullptr };
+  uint32_t cuts[2] = { 0u, 0u };
+  uint8_t phases[2] = { 0u, 0u };
+  /* bits 0 and 1: phases in use, bit 2: same match */
+  uint8_t config{ 0u };
+
+  bool operator==( cover_timing_key const& other ) const
+  {
+    return gates[0] == other.gates[0] && gates[1] == other.gates[1] && cuts[0] == other.cuts[0] && cuts[1] == other.cuts[1] &&
+           phases[0] == other.phases[0] && phases[1] == other.phases[1] && config == other.config;
+  }
+};
+
 template<unsigned NInputs>
 struct node_match_tech
 {
@@ -201,6 +227,13 @@ struct node_match_tech
   float flows[3];
 };
 
+inline cut_enumeration_params cut_enumeration_params_of( map_params const& ps )
+{
+  cut_enumeration_params cps = ps.cut_enumeration_ps;
+  cps.num_threads = std::max( cps.num_threads, ps.num_threads );
+  return cps;
+}
+
 template<class Ntk, unsigned CutSize, typename CutData, unsigned NInputs, classification_type Configuration>
 class tech_map_impl
 {
@@ -211,6 +244,7 @@ public:
   using klut_map = std::unordered_map<uint32_t, std::array<signal<klut_network>, 2>>;
   using map_ntk_t = binding_view<klut_network>;
   using seq_map_ntk_t = binding_view<sequential<klut_network>>;
+  using timing_t = incremental_required_times<cover_timing_key<supergate<NInputs>>>;
 
 public:
   explicit tech_map_impl( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, map_params const& ps, map_stats& st )
@@ -221,7 +255,7 @@ public:
         node_match( ntk.size() ),
         matches(),
         switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
-        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, cut_enumeration_params_of( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -235,7 +269,7 @@ public:
         node_match( ntk.size() ),
         matches(),
         switch_activity( switch_activity ),
-        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, cut_enumeration_params_of( ps ), &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -372,76 +406,112 @@ private:
         node_data.arrival[1] = lib_inv_delay;
       }
     } );
+
+    init_timing();
+  }
+
+  void init_timing()
+  {
+    timing = timing_t( compute_timing_levels( ntk, top_order ) );
+    timing_outputs.assign( ntk.size(), 0u );
+    ntk.foreach_co( [&]( auto const& s ) {
+      timing_outputs[ntk.node_to_index( ntk.get_node( s ) )] |= ntk.is_complemented( s ) ? 2u : 1u;
+    } );
   }
 
   void compute_matches()
   {
     /* match gates */
+    if ( ps.num_threads > 1u )
+    {
+      /* the matches of a node only depend on its cuts */
+      std::vector<node<Ntk>> gates;
+      gates.reserve( ntk.num_gates() );
+      ntk.foreach_gate( [&]( auto const& n ) {
+        gates.push_back( n );
+      } );
+
+      std::vector<std::vector<cut_match_tech<NInputs>>> gate_matches( gates.size() );
+      parallel_for( ps.num_threads, gates.size(), [&]( uint64_t i, uint32_t ) {
+        gate_matches[i] = compute_node_matches( ntk.node_to_index( gates[i] ) );
+      } );
+
+      for ( auto i = 0u; i < gates.size(); ++i )
+      {
+        matches[ntk.node_to_index( gates[i] )] = std::move( gate_matches[i] );
+      }
+      return;
+    }
+
     ntk.foreach_gate( [&]( auto const& n ) {
       const auto index = ntk.node_to_index( n );
+      matches[index] = compute_node_matches( index );
+    } );
+  }
 
-      std::vector<cut_match_tech<NInputs>> node_matches;
+  std::vector<cut_match_tech<NInputs>> compute_node_matches( uint32_t index )
+  {
+    std::vector<cut_match_tech<NInputs>> node_matches;
 
-      auto i = 0u;
-      for ( auto& cut : cuts.cuts( index ) )
+    auto i = 0u;
+    for ( auto& cut : cuts.cuts( index ) )
+    {
+      /* ignore unit cut */
+      if ( cut->size() == 1 && *cut->begin() == index )
       {
-        /* ignore unit cut */
-        if ( cut->size() == 1 && *cut->begin() == index )
-        {
-          ( *cut )->data.ignore = true;
-          continue;
-        }
-        if ( cut->size() > NInputs )
-        {
-          /* Ignore cuts too big to be mapped using the library */
-          ( *cut )->data.ignore = true;
-          continue;
-        }
-        const auto tt = cuts.truth_table( *cut );
-        const auto fe = kitty::extend_to<6>( tt );
-        auto fe_canon = fe;
+        ( *cut )->data.ignore = true;
+        continue;
+      }
+      if ( cut->size() > NInputs )
+      {
+        /* Ignore cuts too big to be mapped using the library */
+        ( *cut )->data.ignore = true;
+        continue;
+      }
+      const auto tt = cuts.truth_table( *cut );
+      const auto fe = kitty::extend_to<6>( tt );
+      auto fe_canon = fe;
 
-        uint8_t negations_pos = 0;
-        uint8_t negations_neg = 0;
+      uint8_t negations_pos = 0;
+      uint8_t negations_neg = 0;
 
-        /* match positive polarity */
-        if constexpr ( Configuration == classification_type::p_configurations )
-        {
-          auto canon = kitty::exact_n_canonization( fe );
-          fe_canon = std::get<0>( canon );
-          negations_pos = std::get<1>( canon );
-        }
-        auto const supergates_pos = library.get_supergates( fe_canon );
+      /* match positive polarity */
+      if constexpr ( Configuration == classification_type::p_configurations )
+      {
+        auto canon = kitty::exact_n_canonization( fe );
+        fe_canon = std::get<0>( canon );
+        negations_pos = std::get<1>( canon );
+      }
+      auto const supergates_pos = library.get_supergates( fe_canon );
 
-        /* match negative polarity */
-        if constexpr ( Configuration == classification_type::p_configurations )
-        {
-          auto canon = kitty::exact_n_canonization( ~fe );
-          fe_canon = std::get<0>( canon );
-          negations_neg = std::get<1>( canon );
-        }
-        else
-        {
-          fe_canon = ~fe;
-        }
-        auto const supergates_neg = library.get_supergates( fe_canon );
+      /* match negative polarity */
+      if constexpr ( Configuration == classification_type::p_configurations )
+      {
+        auto canon = kitty::exact_n_canonization( ~fe );
+        fe_canon = std::get<0>( canon );
+        negations_neg = std::get<1>( canon );
+      }
+      else
+      {
+        fe_canon = ~fe;
+      }
+      auto const supergates_neg = library.get_supergates( fe_canon );
 
-        if ( supergates_pos != nullptr || supergates_neg != nullptr )
-        {
-          cut_match_tech<NInputs> match{ { supergates_pos, supergates_neg }, { negations_pos, negations_neg } };
+      if ( supergates_pos != nullptr || supergates_neg != nullptr )
+      {
+        cut_match_tech<NInputs> match{ { supergates_pos, supergates_neg }, { negations_pos, negations_neg } };
 
-          node_matches.push_back( match );
-          ( *cut )->data.match_index = i++;
-        }
-        else
-        {
-          /* Ignore not matched cuts */
-          ( *cut )->data.ignore = true;
-        }
+        node_matches.push_back( match );
+        ( *cut )->data.match_index = i++;
+      }
+      else
+      {
+        /* Ignore not matched cuts */
+        ( *cut )->data.ignore = true;
       }
+    }
 
-      matches[index] = node_matches;
-    } );
+    return node_matches;
   }
 
   template<bool DO_AREA>
@@ -606,7 +676,10 @@ private:
 
       /* continue if not referenced in the cover */
       if ( node_match[index].map_refs[2] == 0u )
+      {
+        record_cover( index );
         continue;
+      }
 
       unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
 
@@ -618,6 +691,8 @@ private:
         return false;
       }
 
+      record_cover( index );
+
       if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
       {
         if constexpr ( !ELA )
@@ -678,14 +753,16 @@ private:
 
   void compute_required_time()
   {
-    for ( auto i = 0u; i < node_match.size(); ++i )
-    {
-      node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<double>::max();
-    }
-
     /* return in case of `skip_delay_round` */
     if ( iteration == 0 )
+    {
+      for ( auto i = 0u; i < node_match.size(); ++i )
+      {
+        node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<double>::max();
+      }
+      timing.invalidate();
       return;
+    }
 
     auto required = delay;
 
@@ -703,6 +780,18 @@ private:
       }
     }
 
+    /* update only the cones in which the cover changed */
+    if ( timing.is_valid() && required == timing_required )
+    {
+      timing.update( [this]( uint32_t index ) { return recompute_required_time( index ); } );
+      return;
+    }
+
+    for ( auto i = 0u; i < node_match.size(); ++i )
+    {
+      node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<double>::max();
+    }
+
     /* set the required time at POs */
     ntk.foreach_co( [&]( auto const& s ) {
       const auto index = ntk.node_to_index( ntk.get_node( s ) );
@@ -763,6 +852,100 @@ private:
         }
       }
     }
+
+    timing_required = required;
+    timing.validate();
+  }
+
+  /* recomputes the required time of a node from its fanouts in the cover */
+  bool recompute_required_time( uint32_t index )
+  {
+    auto& node_data = node_match[index];
+    double required[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+
+    if ( timing_outputs[index] & 1u )
+      required[0] = timing_required;
+    if ( timing_outputs[index] & 2u )
+      required[1] = timing_required;
+
+    timing.foreach_fanout( index, [&]( uint32_t f ) {
+      auto const& fanout_data = node_match[f];
+      const unsigned use_phase = fanout_data.best_supergate[0] == nullptr ? 1u : 0u;
+
+      if ( fanout_data.same_match || fanout_data.map_refs[use_phase] > 0 )
+        leaf_required_time( index, f, use_phase, required );
+
+      if ( !fanout_data.same_match && fanout_data.map_refs[use_phase ^ 1] > 0 )
+        leaf_required_time( index, f, use_phase ^ 1, required );
+    } );
+
+    /* propagate required time over the output inverter if present */
+    const auto n = ntk.index_to_node( index );
+    if ( !ntk.is_ci( n ) && !ntk.is_constant( n ) && node_data.map_refs[2] != 0 )
+    {
+      const unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      if ( node_data.same_match && node_data.map_refs[use_phase ^ 1] > 0 )
+      {
+        required[use_phase] = std::min( required[use_phase], required[use_phase ^ 1] - lib_inv_delay );
+      }
+    }
+
+    if ( required[0] == node_data.required[0] && required[1] == node_data.required[1] )
+      return false;
+
+    node_data.required[0] = required[0];
+    node_data.required[1] = required[1];
+    return true;
+  }
+
+  /* updates the required time of a leaf using the match of a phase of its fanout */
+  void leaf_required_time( uint32_t leaf_index, uint32_t index, unsigned phase, double ( &required )[2] )
+  {
+    auto const& node_data = node_match[index];
+    auto const& supergate = node_data.best_supergate[phase];
+    auto ctr = 0u;
+    for ( auto leaf : cuts.cuts( index )[node_data.best_cut[phase]] )
+    {
+      if ( leaf == leaf_index )
+      {
+        auto leaf_phase = ( node_data.phase[phase] >> ctr ) & 1;
+        required[leaf_phase] = std::min( required[leaf_phase], node_data.required[phase] - supergate->tdelay[ctr] );
+      }
+      ++ctr;
+    }
+  }
+
+  /* records the implementation of a node in the cover for timing updates */
+  void record_cover( uint32_t index )
+  {
+    auto const& node_data = node_match[index];
+    cover_timing_key<supergate<NInputs>> key;
+    timing_leaves.clear();
+
+    if ( node_data.map_refs[2] != 0u )
+    {
+      const unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
+        key.config |= 1u << use_phase;
+      if ( node_data.map_refs[use_phase ^ 1] > 0 )
+        key.config |= 1u << ( use_phase ^ 1 );
+      if ( node_data.same_match )
+        key.config |= 4u;
+
+      for ( auto phase = 0u; phase < 2u; ++phase )
+      {
+        if ( ( ( key.config >> phase ) & 1 ) == 0 || ( node_data.same_match && phase != use_phase ) )
+          continue;
+
+        auto const& cut = cuts.cuts( index )[node_data.best_cut[phase]];
+        key.gates[phase] = node_data.best_supergate[phase];
+        key.cuts[phase] = node_data.best_cut[phase];
+        key.phases[phase] = node_data.phase[phase];
+        timing_leaves.insert( timing_leaves.end(), cut.begin(), cut.end() );
+      }
+    }
+
+    timing.set_node( index, key, timing_leaves.begin(), timing_leaves.end() );
   }
 
   template<bool DO_AREA>
@@ -1697,6 +1880,11 @@ private:
   match_map matches;
   std::vector<float> switch_activity;
   network_cuts_t cuts;
+
+  timing_t timing;
+  std::vector<uint8_t> timing_outputs;
+  std::vector<uint32_t> timing_leaves;
+  double timing_required{ 0 };
 };
 
 } /* namespace detail */
@@ -1887,6 +2075,7 @@ public:
   static constexpr uint32_t max_window_size = 12;
   using network_cuts_t = fast_network_cuts<Ntk, CutSize, true, CutData>;
   using cut_t = typename network_cuts_t::cut_t;
+  using timing_t = incremental_required_times<cover_timing_key<exact_supergate<NtkDest, NInputs>>>;
 
 public:
   explicit exact_map_impl( Ntk& ntk, exact_library<NtkDest, NInputs> const& library, map_params const& ps, map_stats& st )
@@ -1897,7 +2086,7 @@ public:
         lib_database( library.get_database() ),
         node_match( ntk.size() ),
         matches(),
-        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps ) )
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, cut_enumeration_params_of( ps ) ) )
   {
     std::tie( lib_inv_area, lib_inv_delay ) = library.get_inverter_info();
   }
@@ -1999,69 +2188,105 @@ private:
         node_data.arrival[1] = lib_inv_delay;
       }
     } );
+
+    init_timing();
+  }
+
+  void init_timing()
+  {
+    timing = timing_t( compute_timing_levels( ntk, top_order ) );
+    timing_outputs.assign( ntk.size(), 0u );
+    ntk.foreach_co( [&]( auto const& s ) {
+      timing_outputs[ntk.node_to_index( ntk.get_node( s ) )] |= ntk.is_complemented( s ) ? 2u : 1u;
+    } );
   }
 
   void compute_matches()
   {
     /* match gates */
+    if ( ps.num_threads > 1u )
+    {
+      /* the matches of a node only depend on its cuts */
+      std::vector<node<Ntk>> gates;
+      gates.reserve( ntk.num_gates() );
+      ntk.foreach_gate( [&]( auto const& n ) {
+        gates.push_back( n );
+      } );
+
+      std::vector<std::vector<cut_match_t<NtkDest, NInputs>>> gate_matches( gates.size() );
+      parallel_for( ps.num_threads, gates.size(), [&]( uint64_t i, uint32_t ) {
+        gate_matches[i] = compute_node_matches( ntk.node_to_index( gates[i] ) );
+      } );
+
+      for ( auto i = 0u; i < gates.size(); ++i )
+      {
+        matches[ntk.node_to_index( gates[i] )] = std::move( gate_matches[i] );
+      }
+      return;
+    }
+
     ntk.foreach_gate( [&]( auto const& n ) {
       const auto index = ntk.node_to_index( n );
+      matches[index] = compute_node_matches( index );
+    } );
+  }
 
-      std::vector<cut_match_t<NtkDest, NInputs>> node_matches;
+  std::vector<cut_match_t<NtkDest, NInputs>> compute_node_matches( uint32_t index )
+  {
+    std::vector<cut_match_t<NtkDest, NInputs>> node_matches;
 
-      auto i = 0u;
-      for ( auto& cut : cuts.cuts( index ) )
+    auto i = 0u;
+    for ( auto& cut : cuts.cuts( index ) )
+    {
+      /* ignore unit cut */
+      if ( cut->size() == 1 && *cut->begin() == index )
       {
-        /* ignore unit cut */
-        if ( cut->size() == 1 && *cut->begin() == index )
-        {
-          ( *cut )->data.ignore = true;
-          continue;
-        }
+        ( *cut )->data.ignore = true;
+        continue;
+      }
 
-        if ( cut->size() > NInputs )
-        {
-          /* Ignore cuts too big to be mapped using the library */
-          ( *cut )->data.ignore = true;
-          continue;
-        }
+      if ( cut->size() > NInputs )
+      {
+        /* Ignore cuts too big to be mapped using the library */
+        ( *cut )->data.ignore = true;
+        continue;
+      }
 
-        /* match the cut using canonization and get the gates */
-        const auto tt = cuts.truth_table( *cut );
-        const auto fe = kitty::extend_to<NInputs>( tt );
-        const auto config = kitty::exact_npn_canonization( fe );
-        auto const supergates_npn = library.get_supergates( std::get<0>( config ) );
-        auto const supergates_npn_neg = library.get_supergates( ~std::get<0>( config ) );
+      /* match the cut using canonization and get the gates */
+      const auto tt = cuts.truth_table( *cut );
+      const auto fe = kitty::extend_to<NInputs>( tt );
+      const auto config = kitty::exact_npn_canonization( fe );
+      auto const supergates_npn = library.get_supergates( std::get<0>( config ) );
+      auto const supergates_npn_neg = library.get_supergates( ~std::get<0>( config ) );
 
-        if ( supergates_npn != nullptr || supergates_npn_neg != nullptr )
-        {
-          auto neg = std::get<1>( config );
-          auto perm = std::get<2>( config );
-          uint8_t phase = ( neg >> NInputs ) & 1;
-          cut_match_t<NtkDest, NInputs> match;
+      if ( supergates_npn != nullptr || supergates_npn_neg != nullptr )
+      {
+        auto neg = std::get<1>( config );
+        auto perm = std::get<2>( config );
+        uint8_t phase = ( neg >> NInputs ) & 1;
+        cut_match_t<NtkDest, NInputs> match;
 
-          match.supergates[phase] = supergates_npn;
-          match.supergates[phase ^ 1] = supergates_npn_neg;
+        match.supergates[phase] = supergates_npn;
+        match.supergates[phase ^ 1] = supergates_npn_neg;
 
-          /* store permutations and negations */
-          match.negation = 0;
-          for ( auto j = 0u; j < perm.size() && j < NInputs; ++j )
-          {
-            match.permutation[perm[j]] = j;
-            match.negation |= ( ( neg >> perm[j] ) & 1 ) << j;
-          }
-          node_matches.push_back( match );
-          ( *cut )->data.match_index = i++;
-        }
-        else
+        /* store permutations and negations */
+        match.negation = 0;
+        for ( auto j = 0u; j < perm.size() && j < NInputs; ++j )
         {
-          /* Ignore not matched cuts */
-          ( *cut )->data.ignore = true;
+          match.permutation[perm[j]] = j;
+          match.negation |= ( ( neg >> perm[j] ) & 1 ) << j;
         }
+        node_matches.push_back( match );
+        ( *cut )->data.match_index = i++;
       }
+      else
+      {
+        /* Ignore not matched cuts */
+        ( *cut )->data.ignore = true;
+      }
+    }
 
-      matches[index] = node_matches;
-    } );
+    return node_matches;
   }
 
   void compute_matches_dc()
@@ -2419,7 +2644,10 @@ private:
       }
 
       if ( node_match[index].map_refs[2] == 0u )
+      {
+        record_cover( index );
         continue;
+      }
 
       auto& node_data = node_match[index];
       unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
@@ -2432,6 +2660,8 @@ private:
         return false;
       }
 
+      record_cover( index );
+
       if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
       {
         if constexpr ( !ELA )
@@ -2493,14 +2723,16 @@ private:
 
   void compute_required_time()
   {
-    for ( auto i = 0u; i < node_match.size(); ++i )
-    {
-      node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<float>::max();
-    }
-
     /* return in case of `skip_delay_round` */
     if ( iteration == 0 )
+    {
+      for ( auto i = 0u; i < node_match.size(); ++i )
+      {
+        node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<float>::max();
+      }
+      timing.invalidate();
       return;
+    }
 
     auto required = delay;
 
@@ -2518,6 +2750,18 @@ private:
       }
     }
 
+    /* update only the cones in which the cover changed */
+    if ( timing.is_valid() && required == timing_required )
+    {
+      timing.update( [this]( uint32_t index ) { return recompute_required_time( index ); } );
+      return;
+    }
+
+    for ( auto i = 0u; i < node_match.size(); ++i )
+    {
+      node_match[i].required[0] = node_match[i].required[1] = std::numeric_limits<float>::max();
+    }
+
     /* set the required time at POs */
     ntk.foreach_co( [&]( auto const& s ) {
       const auto index = ntk.node_to_index( ntk.get_node( s ) );
@@ -2580,6 +2824,102 @@ private:
         }
       }
     }
+
+    timing_required = required;
+    timing.validate();
+  }
+
+  /* recomputes the required time of a node from its fanouts in the cover */
+  bool recompute_required_time( uint32_t index )
+  {
+    auto& node_data = node_match[index];
+    double required[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+
+    if ( timing_outputs[index] & 1u )
+      required[0] = timing_required;
+    if ( timing_outputs[index] & 2u )
+      required[1] = timing_required;
+
+    timing.foreach_fanout( index, [&]( uint32_t f ) {
+      auto const& fanout_data = node_match[f];
+      const unsigned use_phase = fanout_data.best_supergate[0] == nullptr ? 1u : 0u;
+
+      if ( fanout_data.same_match || fanout_data.map_refs[use_phase] > 0 )
+        leaf_required_time( index, f, use_phase, required );
+
+      if ( !fanout_data.same_match && fanout_data.map_refs[use_phase ^ 1] > 0 )
+        leaf_required_time( index, f, use_phase ^ 1, required );
+    } );
+
+    /* propagate required time over the output inverter if present */
+    const auto n = ntk.index_to_node( index );
+    if ( !ntk.is_ci( n ) && !ntk.is_constant( n ) && node_data.map_refs[2] != 0 )
+    {
+      const unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      if ( node_data.same_match && node_data.map_refs[use_phase ^ 1] > 0 )
+      {
+        required[use_phase] = std::min( required[use_phase], required[use_phase ^ 1] - lib_inv_delay );
+      }
+    }
+
+    if ( required[0] == node_data.required[0] && required[1] == node_data.required[1] )
+      return false;
+
+    node_data.required[0] = required[0];
+    node_data.required[1] = required[1];
+    return true;
+  }
+
+  /* updates the required time of a leaf using the match of a phase of its fanout */
+  void leaf_required_time( uint32_t leaf_index, uint32_t index, unsigned phase, double ( &required )[2] )
+  {
+    auto const& node_data = node_match[index];
+    auto const& best_cut = cuts.cuts( index )[node_data.best_cut[phase]];
+    auto const& match = matches[index][best_cut->data.match_index];
+    auto const& supergate = node_data.best_supergate[phase];
+    auto ctr = 0u;
+    for ( auto leaf : best_cut )
+    {
+      if ( leaf == leaf_index )
+      {
+        auto leaf_phase = ( node_data.phase[phase] >> match.permutation[ctr] ) & 1;
+        required[leaf_phase] = std::min( required[leaf_phase], node_data.required[phase] - supergate->tdelay[match.permutation[ctr]] );
+      }
+      ++ctr;
+    }
+  }
+
+  /* records the implementation of a node in the cover for timing updates */
+  void record_cover( uint32_t index )
+  {
+    auto const& node_data = node_match[index];
+    cover_timing_key<exact_supergate<NtkDest, NInputs>> key;
+    timing_leaves.clear();
+
+    if ( node_data.map_refs[2] != 0u )
+    {
+      const unsigned use_phase = node_data.best_supergate[0] == nullptr ? 1u : 0u;
+      if ( node_data.same_match || node_data.map_refs[use_phase] > 0 )
+        key.config |= 1u << use_phase;
+      if ( node_data.map_refs[use_phase ^ 1] > 0 )
+        key.config |= 1u << ( use_phase ^ 1 );
+      if ( node_data.same_match )
+        key.config |= 4u;
+
+      for ( auto phase = 0u; phase < 2u; ++phase )
+      {
+        if ( ( ( key.config >> phase ) & 1 ) == 0 || ( node_data.same_match && phase != use_phase ) )
+          continue;
+
+        auto const& cut = cuts.cuts( index )[node_data.best_cut[phase]];
+        key.gates[phase] = node_data.best_supergate[phase];
+        key.cuts[phase] = node_data.best_cut[phase];
+        key.phases[phase] = node_data.phase[phase];
+        timing_leaves.insert( timing_leaves.end(), cut.begin(), cut.end() );
+      }
+    }
+
+    timing.set_node( index, key, timing_leaves.begin(), timing_leaves.end() );
   }
 
   template<bool DO_AREA>
@@ -3399,6 +3739,11 @@ private:
   std::vector<node_match_t<NtkDest, NInputs>> node_match;
   std::unordered_map<uint32_t, std::vector<cut_match_t<NtkDest, NInputs>>> matches;
   network_cuts_t cuts;
+
+  timing_t timing;
+  std::vector<uint8_t> timing_outputs;
+  std::vector<uint32_t> timing_leaves;
+  double timing_required{ 0 };
 };
 
 } /* namespace detail */
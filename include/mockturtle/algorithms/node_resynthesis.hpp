@@ -35,14 +35,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "../traits.hpp"
+#include "../utils/concurrent_network_builder.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/topo_view.hpp"
+#include "cleanup.hpp"
 
 #include <fmt/format.h>
+#include <kitty/hash.hpp>
 
 namespace mockturtle
 {
@@ -54,6 +64,19 @@ namespace mockturtle
  */
 struct node_resynthesis_params
 {
+  /*! \brief Number of threads used to resynthesize node functions.
+   *
+   * If larger than 1, the algorithm runs in two phases.  First, the distinct
+   * node functions are collected and resynthesized concurrently, each one
+   * into a small scratch network.  Then, the output network is rebuilt by
+   * instantiating the scratch networks in topological order.  For AIGs,
+   * XAGs, MIGs, and XMGs, the nodes of each level are instantiated
+   * concurrently with a `concurrent_network_builder`, otherwise serially.
+   * The resynthesis function must be safe to be called concurrently in this
+   * mode (e.g., no cache should be passed to `exact_resynthesis`).
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -68,9 +91,30 @@ struct node_resynthesis_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
+  /*! \brief Runtime for the concurrent resynthesis of node functions. */
+  stopwatch<>::duration time_resynthesis{ 0 };
+
+  /*! \brief Number of distinct node functions (two-phase mode only). */
+  uint32_t num_functions{ 0 };
+
+  /*! \brief Several threads were requested, but the serial mode was used.
+   *
+   * The two-phase mode needs scratch networks, hence `NtkDest` must be
+   * default constructible.
+   */
+  bool serial_fallback{ false };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( num_functions > 0 )
+    {
+      std::cout << fmt::format( "[i] resynthesized {} distinct functions in {:>5.2f} secs\n", num_functions, to_seconds( time_resynthesis ) );
+    }
+    if ( serial_fallback )
+    {
+      std::cout << "[w] the destination network is not default constructible, node functions were resynthesized serially\n";
+    }
   }
 };
 
@@ -128,36 +172,22 @@ public:
     }
 
     /* map nodes */
-    topo_view ntk_topo{ ntk };
-    ntk_topo.foreach_node( [&]( auto n ) {
-      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
-        return;
-
-      std::vector<signal<NtkDest>> children;
-      ntk.foreach_fanin( n, [&]( auto const& f ) {
-        children.push_back( ntk.is_complemented( f ) ? ntk_dest.create_not( node2new[f] ) : node2new[f] );
-      } );
-
-      bool performed_resyn = false;
-      resynthesis_fn( ntk_dest, ntk.node_function( n ), children.begin(), children.end(), [&]( auto const& f ) {
-        node2new[n] = f;
-
-        if constexpr ( has_has_name_v<NtkSource> && has_get_name_v<NtkSource> && has_set_name_v<NtkDest> )
-        {
-          if ( ntk.has_name( ntk.make_signal( n ) ) )
-            ntk_dest.set_name( f, ntk.get_name( ntk.make_signal( n ) ) );
-        }
-
-        performed_resyn = true;
-        return false;
-      } );
-
-      if ( !performed_resyn )
+    if constexpr ( std::is_default_constructible_v<NtkDest> )
+    {
+      if ( ps.num_threads > 1u )
       {
-        fmt::print( "[e] could not perform resynthesis for node {} in node_resynthesis\n", ntk.node_to_index( n ) );
-        std::abort();
+        map_nodes_two_phase( node2new );
       }
-    } );
+      else
+      {
+        map_nodes( node2new );
+      }
+    }
+    else
+    {
+      st.serial_fallback = ps.num_threads > 1u;
+      map_nodes( node2new );
+    }
 
     /* map primary outputs */
     ntk.foreach_po( [&]( auto const& f, auto index ) {
@@ -196,6 +226,197 @@ public:
     return ntk_dest;
   }
 
+private:
+  void map_nodes( node_map<signal<NtkDest>, NtkSource>& node2new )
+  {
+    topo_view ntk_topo{ ntk };
+    ntk_topo.foreach_node( [&]( auto n ) {
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+
+      std::vector<signal<NtkDest>> children;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        children.push_back( ntk.is_complemented( f ) ? ntk_dest.create_not( node2new[f] ) : node2new[f] );
+      } );
+
+      bool performed_resyn = false;
+      resynthesis_fn( ntk_dest, ntk.node_function( n ), children.begin(), children.end(), [&]( auto const& f ) {
+        node2new[n] = f;
+        set_node_name( n, f );
+
+        performed_resyn = true;
+        return false;
+      } );
+
+      if ( !performed_resyn )
+      {
+        fmt::print( "[e] could not perform resynthesis for node {} in node_resynthesis\n", ntk.node_to_index( n ) );
+        std::abort();
+      }
+    } );
+  }
+
+  void map_nodes_two_phase( node_map<signal<NtkDest>, NtkSource>& node2new )
+  {
+    using function_t = std::decay_t<decltype( ntk.node_function( ntk.get_node( ntk.get_constant( false ) ) ) )>;
+
+    /* phase 1a: collect distinct functions of the nodes reachable from the outputs */
+    std::vector<node<NtkSource>> gates;
+    std::vector<function_t> functions;
+    std::unordered_map<function_t, uint32_t, kitty::hash<function_t>> function_to_index;
+    node_map<uint32_t, NtkSource> node_to_function( ntk );
+
+    topo_view ntk_topo{ ntk };
+    ntk_topo.foreach_node( [&]( auto n ) {
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+
+      gates.push_back( n );
+      auto const tt = ntk.node_function( n );
+      auto const [it, inserted] = function_to_index.emplace( tt, static_cast<uint32_t>( functions.size() ) );
+      if ( inserted )
+      {
+        functions.push_back( tt );
+      }
+      node_to_function[n] = it->second;
+    } );
+    st.num_functions = static_cast<uint32_t>( functions.size() );
+
+    /* phase 1b: resynthesize each function into a scratch network with fresh inputs */
+    std::vector<NtkDest> scratch( functions.size() );
+    std::vector<uint8_t> solved( functions.size(), 0u );
+
+    call_with_stopwatch( st.time_resynthesis, [&]() {
+      parallel_for( ps.num_threads, functions.size(), [&]( uint64_t index, uint32_t ) {
+        auto& sntk = scratch[index];
+        std::vector<signal<NtkDest>> leaves( functions[index].num_vars() );
+        std::generate( leaves.begin(), leaves.end(), [&]() { return sntk.create_pi(); } );
+
+        resynthesis_fn( sntk, functions[index], leaves.begin(), leaves.end(), [&]( auto const& f ) {
+          sntk.create_po( f );
+          solved[index] = 1u;
+          return false;
+        } );
+
+        if constexpr ( has_concurrent_network_builder_v<NtkDest> )
+        {
+          /* keep the gates in the fanin cone of the output, in topological order */
+          sntk = cleanup_dangling( sntk );
+        }
+      } );
+    } );
+
+    for ( auto const& n : gates )
+    {
+      if ( !solved[node_to_function[n]] )
+      {
+        fmt::print( "[e] could not perform resynthesis for node {} in node_resynthesis\n", ntk.node_to_index( n ) );
+        std::abort();
+      }
+    }
+
+    /* phase 2: rebuild the network */
+    if constexpr ( has_concurrent_network_builder_v<NtkDest> )
+    {
+      rebuild_concurrently( gates, node_to_function, scratch, node2new );
+    }
+    else
+    {
+      for ( auto const& n : gates )
+      {
+        std::vector<signal<NtkDest>> children;
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          children.push_back( ntk.is_complemented( f ) ? ntk_dest.create_not( node2new[f] ) : node2new[f] );
+        } );
+
+        auto const f = cleanup_dangling( scratch[node_to_function[n]], ntk_dest, children.begin(), children.end() ).front();
+        node2new[n] = f;
+        set_node_name( n, f );
+      }
+    }
+  }
+
+  /* instantiates the scratch networks level by level, the nodes of a level concurrently */
+  void rebuild_concurrently( std::vector<node<NtkSource>> const& gates, node_map<uint32_t, NtkSource> const& node_to_function,
+                             std::vector<NtkDest> const& scratch, node_map<signal<NtkDest>, NtkSource>& node2new )
+  {
+    node_map<uint32_t, NtkSource> levels( ntk, 0u );
+    std::vector<uint64_t> level_sizes;
+    uint64_t expected_num_gates{ 0u };
+    for ( auto const& n : gates )
+    {
+      uint32_t level{ 0u };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        level = std::max( level, levels[f] );
+      } );
+      levels[n] = level + 1u;
+      if ( level >= level_sizes.size() )
+      {
+        level_sizes.resize( level + 1u, 0u );
+      }
+      ++level_sizes[level];
+      expected_num_gates += scratch[node_to_function[n]].num_gates();
+    }
+
+    std::vector<uint64_t> offsets( level_sizes.size() + 1u, 0u );
+    std::partial_sum( level_sizes.begin(), level_sizes.end(), offsets.begin() + 1u );
+    std::vector<node<NtkSource>> ordered( gates.size() );
+    {
+      auto next = offsets;
+      for ( auto const& n : gates )
+      {
+        ordered[next[levels[n] - 1u]++] = n;
+      }
+    }
+
+    concurrent_network_builder<NtkDest> builder( ntk_dest, expected_num_gates );
+    std::vector<std::vector<signal<NtkDest>>> values( ps.num_threads );
+    std::vector<std::vector<signal<NtkDest>>> children( ps.num_threads );
+    parallel_for_levels( ps.num_threads, level_sizes, [&]( uint32_t level, uint64_t index, uint32_t thread_id ) {
+      auto const& n = ordered[offsets[level] + index];
+      auto const& sntk = scratch[node_to_function[n]];
+      auto& sntk_values = values[thread_id];
+      auto& gate_children = children[thread_id];
+
+      sntk_values.resize( sntk.size() );
+      sntk_values[sntk.node_to_index( sntk.get_node( sntk.get_constant( false ) ) )] = builder.get_constant( false );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        sntk_values[sntk.node_to_index( sntk.pi_at( i ) )] = node2new[f] ^ ntk.is_complemented( f );
+      } );
+
+      sntk.foreach_gate( [&]( auto const& g ) {
+        gate_children.clear();
+        sntk.foreach_fanin( g, [&]( auto const& f ) {
+          gate_children.push_back( sntk_values[sntk.node_to_index( sntk.get_node( f ) )] ^ sntk.is_complemented( f ) );
+        } );
+        sntk_values[sntk.node_to_index( g )] = builder.clone_node( sntk, g, gate_children );
+      } );
+
+      auto const o = sntk.po_at( 0u );
+      node2new[n] = sntk_values[sntk.node_to_index( sntk.get_node( o ) )] ^ sntk.is_complemented( o );
+    } );
+    builder.commit();
+
+    for ( auto const& n : gates )
+    {
+      set_node_name( n, node2new[n] );
+    }
+  }
+
+  void set_node_name( node<NtkSource> const& n, signal<NtkDest> const& f )
+  {
+    if constexpr ( has_has_name_v<NtkSource> && has_get_name_v<NtkSource> && has_set_name_v<NtkDest> )
+    {
+      if ( ntk.has_name( ntk.make_signal( n ) ) )
+        ntk_dest.set_name( f, ntk.get_name( ntk.make_signal( n ) ) );
+    }
+    else
+    {
+      (void)n;
+      (void)f;
+    }
+  }
+
 private:
   NtkDest& ntk_dest;
   NtkSource const& ntk;
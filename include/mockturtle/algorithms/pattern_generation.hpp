@@ -34,6 +34,7 @@
 #pragma once
 
 #include "../networks/aig.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "circuit_validator.hpp"
@@ -42,6 +43,9 @@
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/z3.hpp>
 #include <kitty/partial_truth_table.hpp>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <random>
 
 namespace mockturtle
@@ -74,6 +78,18 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
+
+  /*! \brief Number of threads used for stuck-at pattern generation.
+   *
+   * If larger than 1, target nodes are solved concurrently by SAT workers,
+   * each one owning a private copy of the network and a private validator.
+   * Generated patterns are appended to the simulator in batches.  Requires
+   * the network to implement `clone`; otherwise, the serial algorithm is used.
+   */
+  uint32_t num_threads{ 1 };
+
+  /*! \brief Number of target nodes solved in each parallel round. */
+  uint32_t batch_size{ 256 };
 };
 
 struct pattern_generation_stats
@@ -116,6 +132,50 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
   using TT = incomplete_node_map<kitty::partial_truth_table, Ntk>;
+  using validator_t = circuit_validator<Ntk, bill::solvers::bsat2, true, true, use_odc>;
+  using base_ntk_t = std::conditional_t<has_clone_v<Ntk>, std::decay_t<decltype( std::declval<Ntk>().clone() )>, Ntk>;
+
+  /* SAT worker owning a private copy of the network */
+  struct patgen_worker
+  {
+    patgen_worker( Ntk const& ntk, validator_params const& vps )
+        : ntk( ntk.clone() ), view( this->ntk ), validator( view, vps )
+    {
+    }
+
+    void set_odc_levels( int32_t odc_levels )
+    {
+      /* changing the ODC levels restarts the solver */
+      if ( odc_levels != current_odc_levels )
+      {
+        validator.set_odc_levels( odc_levels );
+        current_odc_levels = odc_levels;
+      }
+    }
+
+    base_ntk_t ntk;
+    Ntk view;
+    validator_t validator;
+    std::optional<int32_t> current_odc_levels;
+  };
+
+  /* target node of a parallel round */
+  struct patgen_target
+  {
+    patgen_target( node const& root, bool value, bool is_stuck_at )
+        : root( root ), value( value ), is_stuck_at( is_stuck_at )
+    {
+    }
+
+    node root;
+    bool value;       /* wanted value of root */
+    bool is_stuck_at; /* root is constant under the current patterns */
+    bool is_constant{ false };
+    uint32_t unobservable_type1{ 0 };
+    uint32_t unobservable_node{ 0 };
+    std::vector<std::vector<bool>> patterns;  /* known patterns in which root has `value` */
+    std::vector<std::vector<bool>> generated; /* generated patterns */
+  };
 
   explicit patgen_impl( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, validator_params& vps, pattern_generation_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), vps( vps ), validator( ntk, vps ),
@@ -138,7 +198,14 @@ public:
 
     if ( ps.num_stuck_at > 0 )
     {
-      stuck_at_check();
+      if ( ps.num_threads > 1u )
+      {
+        parallel_stuck_at_check();
+      }
+      else
+      {
+        stuck_at_check();
+      }
       if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
       {
         sim.pack_bits();
@@ -293,6 +360,105 @@ private:
     } );
   }
 
+  void parallel_stuck_at_check()
+  {
+    if constexpr ( has_clone_v<Ntk> && std::is_constructible_v<Ntk, base_ntk_t&> && !has_EXCDC_interface_v<Ntk> )
+    {
+      progress_bar pbar{ ntk.size(), "patgen-sa |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
+
+      /* each worker owns a copy of the network, such that traversal IDs used in ODC computations are not shared */
+      std::vector<std::unique_ptr<patgen_worker>> workers( ps.num_threads );
+      for ( auto& w : workers )
+      {
+        w = std::make_unique<patgen_worker>( ntk, vps );
+      }
+
+      std::vector<node> gates;
+      ntk.foreach_gate( [&]( auto const& n ) {
+        gates.emplace_back( n );
+      } );
+
+      std::vector<patgen_target> targets;
+      uint64_t next = 0u;
+      while ( next < gates.size() )
+      {
+        /* collect a batch of target nodes under the current patterns */
+        targets.clear();
+        kitty::partial_truth_table const zero = sim.compute_constant( false );
+        for ( ; next < gates.size() && targets.size() < ps.batch_size; ++next )
+        {
+          auto const& n = gates[next];
+          pbar( next, next, sim.num_bits() );
+
+          if ( tts[n].num_bits() != sim.num_bits() )
+          {
+            call_with_stopwatch( st.time_sim, [&]() {
+              simulate_node<Ntk>( ntk, n, tts, sim );
+            } );
+          }
+
+          if ( ( tts[n] == zero ) || ( tts[n] == ~zero ) )
+          {
+            targets.emplace_back( n, tts[n] == zero, true );
+          }
+          else if ( ps.num_stuck_at > 1 )
+          {
+            auto const& tt = tts[n];
+            if ( kitty::count_ones( tt ) < ps.num_stuck_at )
+            {
+              targets.emplace_back( n, true, false );
+              collect_patterns( tt, true, targets.back().patterns );
+            }
+            else if ( kitty::count_zeros( tt ) < ps.num_stuck_at )
+            {
+              targets.emplace_back( n, false, false );
+              collect_patterns( tt, false, targets.back().patterns );
+            }
+          }
+        }
+
+        /* solve the targets concurrently, targets are statically assigned to workers for reproducibility */
+        call_with_stopwatch( st.time_sat, [&]() {
+          parallel_for( ps.num_threads, ps.num_threads, [&]( uint64_t worker_id, uint32_t ) {
+            for ( auto i = worker_id; i < targets.size(); i += ps.num_threads )
+            {
+              solve_target( *workers[worker_id], targets[i] );
+            }
+          } );
+        } );
+
+        /* append the generated patterns in target order */
+        for ( auto const& t : targets )
+        {
+          st.unobservable_type1 += t.unobservable_type1;
+          st.unobservable_node += t.unobservable_node;
+          if ( t.is_constant )
+          {
+            ++st.num_constant;
+            const_nodes.emplace_back( t.value ? ntk.make_signal( t.root ) : !ntk.make_signal( t.root ) );
+            continue;
+          }
+          for ( auto const& pattern : t.generated )
+          {
+            new_pattern( pattern, t.root );
+          }
+        }
+
+        /* bring the last (incomplete) block up-to-date */
+        if ( sim.num_bits() % 64 != 0 )
+        {
+          call_with_stopwatch( st.time_sim, [&]() {
+            simulate_nodes<Ntk>( ntk, tts, sim, false );
+          } );
+        }
+      }
+    }
+    else
+    {
+      stuck_at_check();
+    }
+  }
+
   void observability_check()
   {
     progress_bar pbar{ ntk.size(), "patgen-obs |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
@@ -457,6 +623,73 @@ private:
     zero = sim.compute_constant( false );
   }
 
+  void collect_patterns( kitty::partial_truth_table const& tt, bool value, std::vector<std::vector<bool>>& patterns )
+  {
+    for ( auto i = 0u; i < tt.num_bits(); ++i )
+    {
+      if ( kitty::get_bit( tt, i ) == value )
+      {
+        patterns.emplace_back();
+        ntk.foreach_pi( [&]( auto const& pi ) {
+          patterns.back().emplace_back( kitty::get_bit( tts[pi], i ) );
+        } );
+      }
+    }
+  }
+
+  void solve_target( patgen_worker& w, patgen_target& t )
+  {
+    if ( !t.is_stuck_at )
+    {
+      /* `t.value` has been observed too few times, generate more patterns */
+      w.set_odc_levels( ps.odc_levels );
+      t.generated = w.validator.generate_pattern( t.root, t.value, t.patterns, ps.num_stuck_at - t.patterns.size() );
+      return;
+    }
+
+    w.set_odc_levels( 0 );
+    auto const res = w.validator.validate( t.root, !t.value );
+    if ( !res )
+    {
+      return; /* timeout */
+    }
+    else if ( *res ) /* UNSAT, constant node */
+    {
+      t.is_constant = true;
+      return;
+    }
+
+    /* SAT, pattern found */
+    if constexpr ( use_odc )
+    {
+      /* check if the found pattern is observable */
+      if ( !pattern_is_observable( w.view, t.root, w.validator.cex, ps.odc_levels ) )
+      {
+        w.set_odc_levels( ps.odc_levels );
+        auto const res2 = w.validator.validate( t.root, !t.value );
+        if ( res2 )
+        {
+          if ( !( *res2 ) )
+          {
+            ++t.unobservable_type1;
+          }
+          else
+          {
+            ++t.unobservable_node;
+          }
+        }
+      }
+    }
+    t.generated.emplace_back( w.validator.cex );
+
+    if ( ps.num_stuck_at > 1 )
+    {
+      w.set_odc_levels( ps.odc_levels );
+      auto generated = w.validator.generate_pattern( t.root, t.value, { t.generated.front() }, ps.num_stuck_at - 1 );
+      std::move( generated.begin(), generated.end(), std::back_inserter( t.generated ) );
+    }
+  }
+
   std::vector<bool> compute_support( node const& n )
   {
     ntk.incr_trav_id();
@@ -537,7 +770,7 @@ private:
   pattern_generation_stats& st;
 
   validator_params& vps;
-  circuit_validator<Ntk, bill::solvers::bsat2, true, true, use_odc> validator;
+  validator_t validator;
 
   TT tts;
   std::vector<signal> const_nodes;
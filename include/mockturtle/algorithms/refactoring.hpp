@@ -38,6 +38,7 @@
 #include "../networks/mig.hpp"
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/cut_view.hpp"
@@ -48,11 +49,18 @@
 #include "cleanup.hpp"
 #include "detail/mffc_utils.hpp"
 #include "dont_cares.hpp"
+#include "reconv_cut.hpp"
 #include "simulation.hpp"
 
 #include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
 
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
 namespace mockturtle
 {
 
@@ -75,6 +83,20 @@ struct refactoring_params
   /*! \brief Use don't cares for optimization. */
   bool use_dont_cares{ false };
 
+  /*! \brief Number of threads used to precompute candidates.
+   *
+   * If larger than 1, windows and candidate implementations are computed
+   * speculatively in parallel for batches of nodes, without modifying the
+   * network.  The candidates are then validated and applied in node order;
+   * a candidate is skipped if its window has been modified by an earlier
+   * substitution.  Hence, the result may differ from the single-threaded
+   * one.  The refactoring function must be safe to call from multiple
+   * threads (e.g., `sop_factoring` or `bidecomposition_resynthesis`, but not
+   * `mig_npn_resynthesis`).  Refactoring with don't cares is always performed
+   * by a single thread.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Show progress. */
   bool progress{ false };
 
@@ -101,12 +123,19 @@ struct refactoring_stats
   /*! \brief Accumulated runtime for simulating MFFCs. */
   stopwatch<>::duration time_simulation{ 0 };
 
+  /*! \brief Number of precomputed candidates skipped because their window was modified. */
+  uint32_t num_invalidated{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i] MFFC time        = {:>5.2f} secs\n", to_seconds( time_mffc ) );
     std::cout << fmt::format( "[i] refactoring time = {:>5.2f} secs\n", to_seconds( time_refactoring ) );
     std::cout << fmt::format( "[i] simulation time  = {:>5.2f} secs\n", to_seconds( time_simulation ) );
+    if ( num_invalidated > 0 )
+    {
+      std::cout << fmt::format( "[i] invalidated      = {:>5}\n", num_invalidated );
+    }
   }
 };
 
@@ -133,6 +162,79 @@ struct has_refactoring_with_dont_cares<Ntk,
 template<class Ntk, class RefactoringFn, class Iterator>
 inline constexpr bool has_refactoring_with_dont_cares_v = has_refactoring_with_dont_cares<Ntk, RefactoringFn, Iterator>::value;
 
+/* Network used to compute windows concurrently: the fanout counters and the
+ * traversal ids that are modified by `mffc_view`, `cut_view`, and the
+ * reconvergence-driven cut computation are stored in the view instead of in
+ * the shared network.  Copies of the view share this state. */
+template<class Ntk>
+class refactoring_window_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit refactoring_window_view( Ntk const& ntk )
+      : Ntk( ntk ), _state( std::make_shared<state>() )
+  {
+  }
+
+  /* must be called whenever nodes have been added to the network */
+  void update()
+  {
+    _state->visited.resize( Ntk::size(), 0u );
+  }
+
+  uint32_t fanout_size( node const& n ) const
+  {
+    const auto it = _state->fanout_delta.find( n );
+    return Ntk::fanout_size( n ) + ( it == _state->fanout_delta.end() ? 0 : it->second );
+  }
+
+  uint32_t incr_fanout_size( node const& n ) const
+  {
+    const auto fanout = fanout_size( n );
+    ++_state->fanout_delta[n];
+    return fanout;
+  }
+
+  uint32_t decr_fanout_size( node const& n ) const
+  {
+    --_state->fanout_delta[n];
+    return fanout_size( n );
+  }
+
+  uint32_t visited( node const& n ) const
+  {
+    return _state->visited[Ntk::node_to_index( n )];
+  }
+
+  void set_visited( node const& n, uint32_t v ) const
+  {
+    _state->visited[Ntk::node_to_index( n )] = v;
+  }
+
+  uint32_t trav_id() const
+  {
+    return _state->trav_id;
+  }
+
+  void incr_trav_id() const
+  {
+    ++_state->trav_id;
+  }
+
+private:
+  struct state
+  {
+    std::unordered_map<node, int32_t> fanout_delta;
+    std::vector<uint32_t> visited;
+    uint32_t trav_id{ 0u };
+  };
+
+  std::shared_ptr<state> _state;
+};
+
 template<class Ntk, class RefactoringFn, class NodeCostFn>
 class refactoring_impl
 {
@@ -142,6 +244,15 @@ public:
 
   void run()
   {
+    if constexpr ( has_speculative_mode )
+    {
+      if ( ps.num_threads > 1u && !ps.use_dont_cares )
+      {
+        run_speculative();
+        return;
+      }
+    }
+
     progress_bar pbar{ ntk.size(), "refactoring |{0}| node = {1:>4}   cand = {2:>4}   est. reduction = {3:>5}", ps.progress };
 
     stopwatch t( st.time_total );
@@ -281,6 +392,237 @@ public:
   }
 
 private:
+  using scratch_network = typename Ntk::base_type;
+  using window_view = refactoring_window_view<scratch_network>;
+  using leaves_iterator = typename std::vector<signal<Ntk>>::iterator;
+
+  static constexpr bool has_speculative_mode = has_clone_node_v<Ntk> &&
+                                               std::is_default_constructible_v<scratch_network> &&
+                                               std::is_same_v<signal<Ntk>, signal<scratch_network>> &&
+                                               std::is_invocable_v<RefactoringFn&, scratch_network&, kitty::dynamic_truth_table const&, leaves_iterator const&, leaves_iterator const&, std::function<bool( signal<Ntk> const& )>>;
+
+  /* precomputed candidate for a node */
+  struct refactoring_candidate
+  {
+    bool resynthesized{ false };
+    uint32_t thread_id{ 0u };
+    uint32_t first_pi{ 0u };           /* index of the first leaf in the scratch network */
+    std::vector<node<Ntk>> window;     /* gates between the leaves and the root */
+    std::vector<signal<Ntk>> leaves;
+    signal<Ntk> f;                     /* implementation in the scratch network */
+  };
+
+  void run_speculative()
+  {
+    progress_bar pbar{ ntk.size(), "refactoring |{0}| node = {1:>4}   cand = {2:>4}   est. reduction = {3:>5}", ps.progress };
+
+    stopwatch t( st.time_total );
+
+    /* track the nodes whose fanins change, which invalidates the windows containing them */
+    std::vector<uint32_t> modified( ntk.size(), 0u );
+    uint32_t batch_id = 0u;
+    const auto mark_modified = [&]( node<Ntk> const& n ) {
+      const auto index = ntk.node_to_index( n );
+      if ( index >= modified.size() )
+      {
+        modified.resize( ntk.size(), 0u );
+      }
+      modified[index] = batch_id;
+    };
+    auto modified_event = ntk.events().register_modified_event( [&]( auto const& n, auto const& ) { mark_modified( n ); } );
+    auto delete_event = ntk.events().register_delete_event( [&]( auto const& n ) { mark_modified( n ); } );
+
+    std::vector<node<Ntk>> gates;
+    const auto size = ntk.num_gates();
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i >= size )
+      {
+        return false;
+      }
+      gates.push_back( n );
+      return true;
+    } );
+
+    std::vector<window_view> views;
+    std::vector<scratch_network> scratches( ps.num_threads );
+    for ( auto i = 0u; i < ps.num_threads; ++i )
+    {
+      views.emplace_back( ntk );
+    }
+
+    constexpr uint32_t batch_size = 4096u;
+    std::vector<refactoring_candidate> batch;
+    for ( auto first = 0u; first < gates.size(); first += batch_size )
+    {
+      const auto num_gates = std::min<uint32_t>( batch_size, static_cast<uint32_t>( gates.size() ) - first );
+      batch.clear();
+      batch.resize( num_gates );
+      ++batch_id;
+
+      for ( auto i = 0u; i < ps.num_threads; ++i )
+      {
+        views[i].update();
+        scratches[i] = scratch_network{};
+      }
+
+      /* compute windows and candidates without modifying the network */
+      call_with_stopwatch( st.time_refactoring, [&]() {
+        parallel_for( ps.num_threads, num_gates, [&]( uint64_t i, uint32_t thread_id ) {
+          batch[i].thread_id = thread_id;
+          compute_candidate( views[thread_id], scratches[thread_id], gates[first + i], batch[i] );
+        } );
+      } );
+
+      /* validate and apply the candidates */
+      for ( auto i = 0u; i < num_gates; ++i )
+      {
+        const auto& n = gates[first + i];
+        auto const& cand = batch[i];
+
+        pbar( first + i, first + i, _candidates, _estimated_gain );
+
+        if ( !cand.resynthesized || ntk.fanout_size( n ) == 0u )
+          continue;
+
+        if ( std::any_of( cand.window.begin(), cand.window.end(), [&]( auto const& g ) {
+               const auto index = ntk.node_to_index( g );
+               return index < modified.size() && modified[index] == batch_id;
+             } ) )
+        {
+          ++st.num_invalidated;
+          continue;
+        }
+
+        ntk.incr_trav_id();
+        int32_t gain = recursive_deref_mark( n );
+
+        std::unordered_map<uint32_t, signal<Ntk>> old_to_new;
+        const auto new_f = copy_candidate( scratches[cand.thread_id], cand, cand.f, old_to_new );
+
+        if ( n == ntk.get_node( new_f ) )
+        {
+          recursive_ref( n );
+          continue;
+        }
+
+        /* ref only if it is a new node */
+        if ( ntk.fanout_size( ntk.get_node( new_f ) ) == 0 )
+        {
+          recursive_deref_check_mark( ntk.get_node( new_f ) );
+          gain -= recursive_ref( ntk.get_node( new_f ) );
+        }
+
+        recursive_ref( n );
+
+        if ( gain > 0 || ( ps.allow_zero_gain && gain == 0 ) )
+        {
+          ++_candidates;
+          _estimated_gain += gain;
+          ntk.substitute_node( n, new_f );
+        }
+        else
+        {
+          /* remove */
+          if ( ntk.fanout_size( ntk.get_node( new_f ) ) == 0 )
+            ntk.take_out_node( ntk.get_node( new_f ) );
+        }
+      }
+    }
+
+    ntk.events().release_modified_event( modified_event );
+    ntk.events().release_delete_event( delete_event );
+  }
+
+  void compute_candidate( window_view const& view, scratch_network& scratch, node<Ntk> const& n, refactoring_candidate& cand ) const
+  {
+    if ( view.fanout_size( n ) == 0u )
+      return;
+
+    const mffc_view<window_view> mffc( view, n );
+    if ( mffc.num_pos() == 0 || ( !ps.use_reconvergence_cut && mffc.num_pis() > ps.max_pis ) || mffc.size() < 4 )
+      return;
+
+    kitty::dynamic_truth_table tt;
+    if ( mffc.num_pis() <= ps.max_pis )
+    {
+      /* use MFFC */
+      mffc.foreach_pi( [&]( auto const& m ) {
+        cand.leaves.push_back( view.make_signal( m ) );
+      } );
+      mffc.foreach_gate( [&]( auto const& m ) {
+        cand.window.push_back( m );
+      } );
+
+      default_simulator<kitty::dynamic_truth_table> sim( mffc.num_pis() );
+      tt = simulate<kitty::dynamic_truth_table>( mffc, sim )[0];
+    }
+    else
+    {
+      /* compute a reconvergent-driven cut */
+      reconvergence_driven_cut_parameters rps;
+      rps.max_leaves = ps.max_pis;
+      reconvergence_driven_cut_statistics rst;
+      detail::reconvergence_driven_cut_impl<window_view, false, false> reconv_cuts( view, rps, rst );
+
+      std::vector<node<Ntk>> roots = { n };
+      auto const extended_leaves = reconv_cuts.run( roots ).first;
+      assert( extended_leaves.size() <= ps.max_pis );
+
+      for ( auto const& l : extended_leaves )
+      {
+        cand.leaves.push_back( view.make_signal( l ) );
+      }
+
+      cut_view<window_view> cut( view, extended_leaves, view.make_signal( n ) );
+      cut.foreach_gate( [&]( auto const& m ) {
+        cand.window.push_back( m );
+      } );
+
+      default_simulator<kitty::dynamic_truth_table> sim( static_cast<uint32_t>( extended_leaves.size() ) );
+      tt = simulate<kitty::dynamic_truth_table>( cut, sim )[0];
+    }
+
+    std::vector<signal<Ntk>> pis;
+    cand.first_pi = scratch.size();
+    for ( auto i = 0u; i < cand.leaves.size(); ++i )
+    {
+      pis.push_back( scratch.create_pi() );
+    }
+
+    refactoring_fn( scratch, tt, pis.begin(), pis.end(), [&]( auto const& f ) { cand.f = f; cand.resynthesized = true; return false; } );
+  }
+
+  signal<Ntk> copy_candidate( scratch_network const& scratch, refactoring_candidate const& cand, signal<Ntk> const& f, std::unordered_map<uint32_t, signal<Ntk>>& old_to_new )
+  {
+    const auto n = scratch.get_node( f );
+    const auto index = scratch.node_to_index( n );
+
+    signal<Ntk> res;
+    if ( scratch.is_constant( n ) )
+    {
+      res = ntk.get_constant( scratch.constant_value( n ) );
+    }
+    else if ( scratch.is_pi( n ) )
+    {
+      res = cand.leaves[index - cand.first_pi];
+    }
+    else if ( const auto it = old_to_new.find( index ); it != old_to_new.end() )
+    {
+      res = it->second;
+    }
+    else
+    {
+      std::vector<signal<Ntk>> children;
+      scratch.foreach_fanin( n, [&]( auto const& fi ) {
+        children.push_back( copy_candidate( scratch, cand, fi, old_to_new ) );
+      } );
+      res = ntk.clone_node( scratch, n, children );
+      old_to_new[index] = res;
+    }
+
+    return scratch.is_complemented( f ) ? ntk.create_not( res ) : res;
+  }
+
   uint32_t recursive_deref_mark( node<Ntk> const& n )
   {
     /* terminate? */
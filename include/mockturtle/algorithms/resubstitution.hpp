@@ -39,6 +39,7 @@
 #include "../traits.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
 
@@ -640,6 +641,7 @@ public:
 
   void run( resub_callback_t const& callback = substitute_fn<Ntk> )
   {
+    MOCKTURTLE_TRACE_SCOPE( "resubstitution" );
     stopwatch t( st.time_total );
 
     /* start the managers */
@@ -673,6 +675,8 @@ public:
       /* update statistics */
       last_gain = 0;
       st.num_total_divisors += collector.divs.size();
+      MOCKTURTLE_TRACE_COUNT( "resubstitution/windows", 1 );
+      MOCKTURTLE_TRACE_COUNT( "resubstitution/divisors", collector.divs.size() );
 
       /* try to find a resubstitution with the divisors */
       auto g = call_with_stopwatch( st.time_resub, [&]() {
@@ -700,6 +704,7 @@ public:
       } );
       if ( updated )
       {
+        MOCKTURTLE_TRACE_COUNT( "resubstitution/substitutions", 1 );
         resub_engine.update();
       }
 
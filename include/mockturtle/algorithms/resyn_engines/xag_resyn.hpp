@@ -41,6 +41,8 @@
 #include <kitty/kitty.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -82,6 +84,16 @@ struct xag_resyn_static_params
   /*! \brief Depth cost of each XOR gate (only relevant when `preserve_depth = true` and `use_xor = true`). */
   static constexpr uint32_t depth_cost_of_xor{ 1u };
 
+  /*! \brief Whether to use word-level kernels for small truth tables.
+   *
+   * If enabled and the truth tables have at most 256 bits (e.g.,
+   * `kitty::static_truth_table<N>` with N <= 8), the divisor functions are
+   * copied into a contiguous table of 64-bit words and the unateness checks
+   * are performed with fixed-size word operations. The results are the same
+   * as without the kernels.
+   */
+  static constexpr bool use_small_tt_kernels{ true };
+
   using truth_table_storage_type = void;
   using node_type = void;
 };
@@ -163,6 +175,22 @@ struct xag_resyn_stats
   }
 };
 
+namespace detail
+{
+
+/* number of 64-bit words of a truth table type, if known at compile time (0 otherwise) */
+template<class TT>
+struct xag_resyn_static_num_words : std::integral_constant<uint32_t, 0u>
+{
+};
+
+template<uint32_t NumVars, bool IsSmall>
+struct xag_resyn_static_num_words<kitty::static_truth_table<NumVars, IsSmall>> : std::integral_constant<uint32_t, IsSmall ? 1u : ( 1u << ( NumVars - 6 ) )>
+{
+};
+
+} // namespace detail
+
 /*! \brief Logic resynthesis engine for AIGs or XAGs.
  *
  * The algorithm is based on ABC's implementation in `giaResub.c` by Alan Mishchenko.
@@ -282,6 +310,7 @@ public:
       ++begin;
     }
 
+    pack_divisors( target.num_blocks() );
     return compute_function( max_size );
   }
 
@@ -300,7 +329,36 @@ private:
   {
     index_list.clear();
     index_list.add_inputs( divisors.size() - 1 );
-    auto const lit = compute_function_rec( num_inserts );
+
+    std::optional<uint32_t> lit;
+    constexpr auto static_words = detail::xag_resyn_static_num_words<TT>::value;
+    if constexpr ( static_words == 1u || static_words == 2u || static_words == 4u )
+    {
+      lit = num_words == 0u ? compute_function_rec<0u>( num_inserts ) : compute_function_rec<static_words>( num_inserts );
+    }
+    else if constexpr ( static_words != 0u )
+    {
+      lit = compute_function_rec<0u>( num_inserts );
+    }
+    else
+    {
+      switch ( num_words )
+      {
+      case 1u:
+        lit = compute_function_rec<1u>( num_inserts );
+        break;
+      case 2u:
+        lit = compute_function_rec<2u>( num_inserts );
+        break;
+      case 4u:
+        lit = compute_function_rec<4u>( num_inserts );
+        break;
+      default:
+        lit = compute_function_rec<0u>( num_inserts );
+        break;
+      }
+    }
+
     if ( lit )
     {
       assert( index_list.num_gates() <= num_inserts );
@@ -310,8 +368,14 @@ private:
     return std::nullopt;
   }
 
+  template<uint32_t W>
   std::optional<uint32_t> compute_function_rec( uint32_t num_inserts )
   {
+    if constexpr ( W != 0u )
+    {
+      pack_on_off_sets<W>();
+    }
+
     pos_unate_lits.clear();
     neg_unate_lits.clear();
     binate_divs.clear();
@@ -320,7 +384,7 @@ private:
 
     /* try 0-resub and collect unate literals */
     auto const res0 = call_with_stopwatch( st.time_unate, [&]() {
-      return find_one_unate();
+      return find_one_unate<W>();
     } );
     if ( res0 )
     {
@@ -333,18 +397,18 @@ private:
 
     /* sort unate literals and try 1-resub */
     call_with_stopwatch( st.time_sort, [&]() {
-      sort_unate_lits( pos_unate_lits, 1 );
-      sort_unate_lits( neg_unate_lits, 0 );
+      sort_unate_lits<W>( pos_unate_lits, 1 );
+      sort_unate_lits<W>( neg_unate_lits, 0 );
     } );
     auto const res1or = call_with_stopwatch( st.time_resub1, [&]() {
-      return find_div_div( pos_unate_lits, 1 );
+      return find_div_div<W>( pos_unate_lits, 1 );
     } );
     if ( res1or )
     {
       return *res1or;
     }
     auto const res1and = call_with_stopwatch( st.time_resub1, [&]() {
-      return find_div_div( neg_unate_lits, 0 );
+      return find_div_div<W>( neg_unate_lits, 0 );
     } );
     if ( res1and )
     {
@@ -359,7 +423,7 @@ private:
     if constexpr ( static_params::use_xor )
     {
       /* collect XOR-type unate pairs and try 1-resub with XOR */
-      auto const res1xor = find_xor();
+      auto const res1xor = find_xor<W>();
       if ( res1xor )
       {
         return *res1xor;
@@ -372,21 +436,21 @@ private:
 
     /* collect AND-type unate pairs and sort (both types), then try 2- and 3-resub */
     call_with_stopwatch( st.time_collect_pairs, [&]() {
-      collect_unate_pairs();
+      collect_unate_pairs<W>();
     } );
     call_with_stopwatch( st.time_sort, [&]() {
-      sort_unate_pairs( pos_unate_pairs, 1 );
-      sort_unate_pairs( neg_unate_pairs, 0 );
+      sort_unate_pairs<W>( pos_unate_pairs, 1 );
+      sort_unate_pairs<W>( neg_unate_pairs, 0 );
     } );
     auto const res2or = call_with_stopwatch( st.time_resub2, [&]() {
-      return find_div_pair( pos_unate_lits, pos_unate_pairs, 1 );
+      return find_div_pair<W>( pos_unate_lits, pos_unate_pairs, 1 );
     } );
     if ( res2or )
     {
       return *res2or;
     }
     auto const res2and = call_with_stopwatch( st.time_resub2, [&]() {
-      return find_div_pair( neg_unate_lits, neg_unate_pairs, 0 );
+      return find_div_pair<W>( neg_unate_lits, neg_unate_pairs, 0 );
     } );
     if ( res2and )
     {
@@ -396,14 +460,14 @@ private:
     if ( num_inserts >= 3u )
     {
       auto const res3or = call_with_stopwatch( st.time_resub3, [&]() {
-        return find_pair_pair( pos_unate_pairs, 1 );
+        return find_pair_pair<W>( pos_unate_pairs, 1 );
       } );
       if ( res3or )
       {
         return *res3or;
       }
       auto const res3and = call_with_stopwatch( st.time_resub3, [&]() {
-        return find_pair_pair( neg_unate_pairs, 0 );
+        return find_pair_pair<W>( neg_unate_pairs, 0 );
       } );
       if ( res3and )
       {
@@ -464,7 +528,7 @@ private:
         on_off_sets[on_off_div] &= lit & 0x1 ? get_div( lit >> 1 ) : ~get_div( lit >> 1 );
       } );
 
-      auto const res_remain_div = compute_function_rec( num_inserts - 1 );
+      auto const res_remain_div = compute_function_rec<W>( num_inserts - 1 );
       if ( res_remain_div )
       {
         auto const new_lit = index_list.add_and( ( lit ^ 0x1 ), *res_remain_div ^ on_off_div );
@@ -492,7 +556,7 @@ private:
         }
       } );
 
-      auto const res_remain_pair = compute_function_rec( num_inserts - 2 );
+      auto const res_remain_pair = compute_function_rec<W>( num_inserts - 2 );
       if ( res_remain_pair )
       {
         uint32_t new_lit1;
@@ -517,6 +581,7 @@ private:
      2. Collect unate literals
      3. Find 0-resub (both positive unate and negative unate) and collect binate (neither pos nor neg unate) divisors
    */
+  template<uint32_t W>
   std::optional<uint32_t> find_one_unate()
   {
     num_bits[0] = kitty::count_ones( on_off_sets[0] ); /* off-set */
@@ -534,24 +599,24 @@ private:
     {
       bool unateness[4] = { false, false, false, false };
       /* check intersection with off-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[0] ) )
+      if ( div_is_disjoint<W, 1>( v, 0 ) )
       {
         pos_unate_lits.emplace_back( v << 1 );
         unateness[0] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[0] ) )
+      else if ( div_is_disjoint<W, 0>( v, 0 ) )
       {
         pos_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[1] = true;
       }
 
       /* check intersection with on-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[1] ) )
+      if ( div_is_disjoint<W, 1>( v, 1 ) )
       {
         neg_unate_lits.emplace_back( v << 1 );
         unateness[2] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[1] ) )
+      else if ( div_is_disjoint<W, 0>( v, 1 ) )
       {
         neg_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[3] = true;
@@ -585,30 +650,24 @@ private:
      - For `pos_unate_lits`, `on_off` = 1, sort by intersection with on-set;
      - For `neg_unate_lits`, `on_off` = 0, sort by intersection with off-set
    */
+  template<uint32_t W>
   void sort_unate_lits( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
     for ( auto& l : unate_lits )
     {
-      l.score = kitty::count_ones( ( l.lit & 0x1 ? ~get_div( l.lit >> 1 ) : get_div( l.lit >> 1 ) ) & on_off_sets[on_off] );
+      l.score = lit_score<W>( l.lit, on_off );
     }
     std::stable_sort( unate_lits.begin(), unate_lits.end(), [&]( unate_lit const& l1, unate_lit const& l2 ) {
       return l1.score > l2.score; // descending order
     } );
   }
 
+  template<uint32_t W>
   void sort_unate_pairs( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
     for ( auto& p : unate_pairs )
     {
-      if constexpr ( static_params::use_xor )
-      {
-        p.score = ( p.lit1 > p.lit2 ) ? kitty::count_ones( ( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) ^ ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) ) & on_off_sets[on_off] )
-                                      : kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
-      }
-      else
-      {
-        p.score = kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
-      }
+      p.score = pair_score<W>( p, on_off );
     }
     std::stable_sort( unate_pairs.begin(), unate_pairs.end(), [&]( fanin_pair const& p1, fanin_pair const& p2 ) {
       return p1.score > p2.score; // descending order
@@ -619,6 +678,7 @@ private:
      - For `pos_unate_lits`, `on_off` = 1, try covering all on-set bits by combining two with an OR gate;
      - For `neg_unate_lits`, `on_off` = 0, try covering all off-set bits by combining two with an AND gate
    */
+  template<uint32_t W>
   std::optional<uint32_t> find_div_div( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
     for ( auto i = 0u; i < unate_lits.size(); ++i )
@@ -635,9 +695,7 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( lits_cover<W>( lit1, lit2, on_off ) )
         {
           auto const new_lit = index_list.add_and( ( lit1 ^ 0x1 ), ( lit2 ^ 0x1 ) );
           return new_lit + on_off;
@@ -647,6 +705,7 @@ private:
     return std::nullopt;
   }
 
+  template<uint32_t W>
   std::optional<uint32_t> find_div_pair( std::vector<unate_lit>& unate_lits, std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
     for ( auto i = 0u; i < unate_lits.size(); ++i )
@@ -659,25 +718,7 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        TT ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
-
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( lit_pair_cover<W>( lit1, pair2, on_off ) )
         {
           uint32_t new_lit1;
           if constexpr ( static_params::use_xor )
@@ -703,6 +744,7 @@ private:
     return std::nullopt;
   }
 
+  template<uint32_t W>
   std::optional<uint32_t> find_pair_pair( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
     for ( auto i = 0u; i < unate_pairs.size(); ++i )
@@ -719,33 +761,7 @@ private:
         {
           break;
         }
-        TT ntt1, ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair1.lit1 > pair1.lit2 )
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) ^ ( pair1.lit2 & 0x1 ? ~get_div( pair1.lit2 >> 1 ) : get_div( pair1.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          }
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
-
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( pairs_cover<W>( pair1, pair2, on_off ) )
         {
           uint32_t fanin_lit1, fanin_lit2;
           if constexpr ( static_params::use_xor )
@@ -780,6 +796,7 @@ private:
     return std::nullopt;
   }
 
+  template<uint32_t W>
   std::optional<uint32_t> find_xor()
   {
     /* collect XOR-type pairs (d1 ^ d2) & off = 0 or ~(d1 ^ d2) & on = 0, selecting d1, d2 from binate_divs */
@@ -787,27 +804,27 @@ private:
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        auto const tt_xor = get_div( binate_divs[i] ) ^ get_div( binate_divs[j] );
+        auto const empty = xor_disjointness<W>( binate_divs[i], binate_divs[j] );
         bool unateness[4] = { false, false, false, false };
         /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
+        if ( empty[0] && !empty[2] )
         {
           pos_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[0] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
+        if ( empty[1] && !empty[3] )
         {
           pos_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[1] = true;
         }
 
         /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
+        if ( empty[2] && !empty[0] )
         {
           neg_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[2] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
+        if ( empty[3] && !empty[1] )
         {
           neg_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[3] = true;
@@ -828,30 +845,32 @@ private:
   }
 
   /* collect AND-type pairs (d1 & d2) & off = 0 or ~(d1 & d2) & on = 0, selecting d1, d2 from binate_divs */
+  template<uint32_t W>
   void collect_unate_pairs()
   {
     for ( auto i = 0u; i < binate_divs.size(); ++i )
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        collect_unate_pairs_detail<1, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 1>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<1, 0>( binate_divs[i], binate_divs[j] );
-        collect_unate_pairs_detail<0, 0>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail<W, 1, 1>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail<W, 0, 1>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail<W, 1, 0>( binate_divs[i], binate_divs[j] );
+        collect_unate_pairs_detail<W, 0, 0>( binate_divs[i], binate_divs[j] );
       }
     }
   }
 
-  template<bool pol1, bool pol2>
+  template<uint32_t W, bool pol1, bool pol2>
   void collect_unate_pairs_detail( uint32_t div1, uint32_t div2 )
   {
+    auto const empty = pair_disjointness<W, pol1, pol2>( div1, div2 );
     /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-    if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
+    if ( empty[0] && !empty[1] )
     {
       pos_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
     /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-    else if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
+    else if ( empty[1] && !empty[0] )
     {
       neg_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
     }
@@ -869,10 +888,281 @@ private:
     }
   }
 
+  /* Helpers for the unateness checks. With `W = 0`, the truth tables are
+     accessed with `get_div`; otherwise, the packed words are used. */
+  template<uint32_t W>
+  using words_t = std::array<uint64_t, W>;
+
+  void pack_divisors( uint32_t num_blocks )
+  {
+    num_words = 0u;
+    if constexpr ( static_params::use_small_tt_kernels )
+    {
+      if ( num_blocks > 4u )
+      {
+        return;
+      }
+
+      num_words = num_blocks <= 1u ? 1u : ( num_blocks <= 2u ? 2u : 4u );
+      div_words.assign( divisors.size() * num_words, 0u );
+      for ( auto v = 1u; v < divisors.size(); ++v )
+      {
+        auto const& tt = get_div( v );
+        std::copy( tt.cbegin(), tt.cend(), div_words.begin() + v * num_words );
+      }
+    }
+  }
+
+  template<uint32_t W>
+  void pack_on_off_sets()
+  {
+    for ( auto i = 0u; i < 2u; ++i )
+    {
+      on_off_words[i].fill( 0u );
+      std::copy( on_off_sets[i].cbegin(), on_off_sets[i].cend(), on_off_words[i].begin() );
+    }
+  }
+
+  /* words of the function of a literal */
+  template<uint32_t W>
+  inline words_t<W> lit_words( uint32_t lit ) const
+  {
+    words_t<W> res;
+    uint64_t const mask = uint64_t( 0 ) - ( lit & 0x1 );
+    uint64_t const* tt = div_words.data() + ( lit >> 1 ) * W;
+    for ( auto k = 0u; k < W; ++k )
+    {
+      res[k] = tt[k] ^ mask;
+    }
+    return res;
+  }
+
+  /* words of the function of a pair */
+  template<uint32_t W>
+  inline words_t<W> pair_words( fanin_pair const& pair ) const
+  {
+    auto res = lit_words<W>( pair.lit1 );
+    auto const tt2 = lit_words<W>( pair.lit2 );
+    if ( static_params::use_xor && pair.lit1 > pair.lit2 )
+    {
+      for ( auto k = 0u; k < W; ++k )
+      {
+        res[k] ^= tt2[k];
+      }
+    }
+    else
+    {
+      for ( auto k = 0u; k < W; ++k )
+      {
+        res[k] &= tt2[k];
+      }
+    }
+    return res;
+  }
+
+  /* whether `tt & on_off_sets[on_off]` is empty */
+  template<uint32_t W>
+  inline bool words_are_disjoint( words_t<W> const& tt, uint32_t on_off ) const
+  {
+    uint64_t acc = 0u;
+    for ( auto k = 0u; k < W; ++k )
+    {
+      acc |= tt[k] & on_off_words[on_off][k];
+    }
+    return acc == 0u;
+  }
+
+  /* whether `tt1 | tt2` covers `on_off_sets[on_off]` */
+  template<uint32_t W>
+  inline bool words_cover( words_t<W> const& tt1, words_t<W> const& tt2, uint32_t on_off ) const
+  {
+    uint64_t acc = 0u;
+    for ( auto k = 0u; k < W; ++k )
+    {
+      acc |= ~tt1[k] & ~tt2[k] & on_off_words[on_off][k];
+    }
+    return acc == 0u;
+  }
+
+  /* number of ones in `tt & on_off_sets[on_off]` */
+  template<uint32_t W>
+  inline uint32_t words_count( words_t<W> const& tt, uint32_t on_off ) const
+  {
+    uint32_t count = 0u;
+    for ( auto k = 0u; k < W; ++k )
+    {
+      uint64_t const word = tt[k] & on_off_words[on_off][k];
+      count += __builtin_popcount( word & 0xffffffff ) + __builtin_popcount( word >> 32 );
+    }
+    return count;
+  }
+
+  template<uint32_t W, bool pol>
+  inline bool div_is_disjoint( uint32_t v, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      return kitty::intersection_is_empty<TT, pol, 1>( get_div( v ), on_off_sets[on_off] );
+    }
+    else
+    {
+      return words_are_disjoint<W>( lit_words<W>( ( v << 1 ) + (uint32_t)( !pol ) ), on_off );
+    }
+  }
+
+  template<uint32_t W>
+  inline uint32_t lit_score( uint32_t lit, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      return kitty::count_ones( ( lit & 0x1 ? ~get_div( lit >> 1 ) : get_div( lit >> 1 ) ) & on_off_sets[on_off] );
+    }
+    else
+    {
+      return words_count<W>( lit_words<W>( lit ), on_off );
+    }
+  }
+
+  template<uint32_t W>
+  inline uint32_t pair_score( fanin_pair const& p, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      if constexpr ( static_params::use_xor )
+      {
+        return ( p.lit1 > p.lit2 ) ? kitty::count_ones( ( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) ^ ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) ) & on_off_sets[on_off] )
+                                   : kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
+      }
+      else
+      {
+        return kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
+      }
+    }
+    else
+    {
+      return words_count<W>( pair_words<W>( p ), on_off );
+    }
+  }
+
+  /* truth table of the negation of a pair */
+  TT negated_pair_tt( fanin_pair const& pair ) const
+  {
+    if constexpr ( static_params::use_xor )
+    {
+      if ( pair.lit1 > pair.lit2 ) /* XOR pair: ~(lit1 ^ lit2) = ~lit1 ^ lit2 */
+      {
+        return ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) ^ ( pair.lit2 & 0x1 ? ~get_div( pair.lit2 >> 1 ) : get_div( pair.lit2 >> 1 ) );
+      }
+    }
+    /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2 */
+    return ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) | ( pair.lit2 & 0x1 ? get_div( pair.lit2 >> 1 ) : ~get_div( pair.lit2 >> 1 ) );
+  }
+
+  /* whether `lit1 | lit2` covers `on_off_sets[on_off]` */
+  template<uint32_t W>
+  inline bool lits_cover( uint32_t lit1, uint32_t lit2, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
+      auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
+      return kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] );
+    }
+    else
+    {
+      return words_cover<W>( lit_words<W>( lit1 ), lit_words<W>( lit2 ), on_off );
+    }
+  }
+
+  /* whether `lit1 | pair2` covers `on_off_sets[on_off]` */
+  template<uint32_t W>
+  inline bool lit_pair_cover( uint32_t lit1, fanin_pair const& pair2, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
+      return kitty::intersection_is_empty( ntt1, negated_pair_tt( pair2 ), on_off_sets[on_off] );
+    }
+    else
+    {
+      return words_cover<W>( lit_words<W>( lit1 ), pair_words<W>( pair2 ), on_off );
+    }
+  }
+
+  /* whether `pair1 | pair2` covers `on_off_sets[on_off]` */
+  template<uint32_t W>
+  inline bool pairs_cover( fanin_pair const& pair1, fanin_pair const& pair2, uint32_t on_off ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      return kitty::intersection_is_empty( negated_pair_tt( pair1 ), negated_pair_tt( pair2 ), on_off_sets[on_off] );
+    }
+    else
+    {
+      return words_cover<W>( pair_words<W>( pair1 ), pair_words<W>( pair2 ), on_off );
+    }
+  }
+
+  /* emptiness of `x & off`, `~x & off`, `x & on`, and `~x & on` for `x = div1 ^ div2` */
+  template<uint32_t W>
+  inline std::array<bool, 4> xor_disjointness( uint32_t div1, uint32_t div2 ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      auto const tt_xor = get_div( div1 ) ^ get_div( div2 );
+      return { kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ), kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ),
+               kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ), kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) };
+    }
+    else
+    {
+      uint64_t const* tt1 = div_words.data() + div1 * W;
+      uint64_t const* tt2 = div_words.data() + div2 * W;
+      uint64_t acc[4] = { 0u, 0u, 0u, 0u };
+      for ( auto k = 0u; k < W; ++k )
+      {
+        uint64_t const x = tt1[k] ^ tt2[k];
+        acc[0] |= x & on_off_words[0][k];
+        acc[1] |= ~x & on_off_words[0][k];
+        acc[2] |= x & on_off_words[1][k];
+        acc[3] |= ~x & on_off_words[1][k];
+      }
+      return { acc[0] == 0u, acc[1] == 0u, acc[2] == 0u, acc[3] == 0u };
+    }
+  }
+
+  /* emptiness of `x & off` and `x & on` for `x = ( pol1 ? div1 : ~div1 ) & ( pol2 ? div2 : ~div2 )` */
+  template<uint32_t W, bool pol1, bool pol2>
+  inline std::array<bool, 2> pair_disjointness( uint32_t div1, uint32_t div2 ) const
+  {
+    if constexpr ( W == 0u )
+    {
+      return { kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ),
+               kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) };
+    }
+    else
+    {
+      auto const tt1 = lit_words<W>( ( div1 << 1 ) + (uint32_t)( !pol1 ) );
+      auto const tt2 = lit_words<W>( ( div2 << 1 ) + (uint32_t)( !pol2 ) );
+      uint64_t acc[2] = { 0u, 0u };
+      for ( auto k = 0u; k < W; ++k )
+      {
+        uint64_t const x = tt1[k] & tt2[k];
+        acc[0] |= x & on_off_words[0][k];
+        acc[1] |= x & on_off_words[1][k];
+      }
+      return { acc[0] == 0u, acc[1] == 0u };
+    }
+  }
+
 private:
   std::array<TT, 2> on_off_sets;
   std::array<uint32_t, 2> num_bits; /* number of bits in on-set and off-set */
 
+  /* divisor functions and on-set/off-set as 64-bit words (if `num_words > 0`) */
+  uint32_t num_words{ 0u };
+  std::vector<uint64_t> div_words;
+  std::array<std::array<uint64_t, 4u>, 2u> on_off_words;
+
   const typename static_params::truth_table_storage_type* ptts;
   std::vector<std::conditional_t<static_params::copy_tts, TT, typename static_params::node_type>> divisors;
 
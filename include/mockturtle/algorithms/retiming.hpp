@@ -32,10 +32,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 #include "../utils/node_map.hpp"
+#include "../utils/parallel_utils.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/fanout_view.hpp"
 #include "../views/topo_view.hpp"
@@ -59,6 +64,15 @@ struct retime_params
   /*! \brief Retiming max iterations. */
   uint32_t iterations{ UINT32_MAX };
 
+  /*! \brief Number of threads for the minimum cut computation.
+   *
+   * If larger than 1, the minimum cuts of independent register clusters,
+   * i.e., groups of registers whose retiming regions do not overlap, are
+   * computed concurrently.  The result does not depend on the number of
+   * threads.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose */
   bool verbose{ false };
 };
@@ -89,20 +103,409 @@ struct retime_stats
 namespace detail
 {
 
+/*! \brief Minimum node cut of a flow network with unit node capacities.
+ *
+ * Nodes are numbered from 0 to `num_nodes - 1`.  Flow enters the network
+ * at the sources, follows the arcs, and leaves it at the sinks.  Each node
+ * has capacity 1, arcs are not bounded.  The cut is the set of saturated
+ * nodes closest to the sources.
+ *
+ * The cut is computed on the network in which each node is split into an
+ * input and an output vertex.  A maximum preflow is computed with a FIFO
+ * push-relabel algorithm with the global relabeling and gap heuristics, the
+ * excess that cannot reach the sinks is returned to the sources, and the
+ * nodes reachable from the sources in the residual network form the source
+ * side of the cut.
+ * The implementation is not recursive and uses memory linear in the size
+ * of the network, which is kept when the object is reused.
+ */
+class unit_capacity_min_cut
+{
+public:
+  /*! \brief Starts a new flow network with `num_nodes` nodes. */
+  void reset( uint32_t num_nodes )
+  {
+    _num_nodes = num_nodes;
+    _arcs.clear();
+    _sources.clear();
+    _sinks.clear();
+  }
+
+  void add_arc( uint32_t from, uint32_t to )
+  {
+    _arcs.emplace_back( from, to );
+  }
+
+  void add_source( uint32_t n )
+  {
+    _sources.push_back( n );
+  }
+
+  void add_sink( uint32_t n )
+  {
+    _sinks.push_back( n );
+  }
+
+  /*! \brief Appends the nodes in the minimum cut to `cut` in increasing order. */
+  void run( std::vector<uint32_t>& cut )
+  {
+    build();
+
+    auto const n = num_vertices();
+    auto const source = 2u * _num_nodes;
+
+    _excess.assign( n, 0u );
+    _in_queue.assign( n, 0u );
+    _queue.resize( n );
+    _queue_begin = _queue_size = 0u;
+
+    global_relabel();
+    _label[source] = n;
+
+    /* one unit of flow for each source */
+    _excess[source] = static_cast<uint32_t>( _sources.size() );
+    for ( auto a = _offsets[source]; a < _offsets[source + 1]; ++a )
+    {
+      push( source, a, _capacity[a] );
+    }
+
+    uint32_t num_relabels{ 0u };
+    while ( _queue_size > 0u )
+    {
+      auto const v = _queue[_queue_begin];
+      _queue_begin = _queue_begin + 1u == n ? 0u : _queue_begin + 1u;
+      --_queue_size;
+      _in_queue[v] = 0u;
+
+      if ( _label[v] >= n )
+        continue;
+
+      num_relabels += discharge( v );
+      if ( num_relabels >= n / 8u )
+      {
+        global_relabel();
+        num_relabels = 0u;
+      }
+    }
+
+    return_excess();
+    mark_reachable();
+
+    /* a source is also cut if its arc from the super source is saturated */
+    auto const begin = cut.size();
+    for ( auto i = 0u; i < _num_nodes; ++i )
+    {
+      if ( _in_queue[2u * i] && !_in_queue[2u * i + 1u] )
+      {
+        cut.push_back( i );
+      }
+    }
+    for ( auto const& i : _sources )
+    {
+      if ( !_in_queue[2u * i] )
+      {
+        cut.push_back( i );
+      }
+    }
+    std::sort( cut.begin() + begin, cut.end() );
+  }
+
+private:
+  uint32_t num_vertices() const
+  {
+    return 2u * _num_nodes + 2u;
+  }
+
+  /* builds the residual network of the split nodes */
+  void build()
+  {
+    static constexpr uint32_t unbounded = std::numeric_limits<uint32_t>::max() / 2u;
+
+    auto const n = num_vertices();
+    auto const source = 2u * _num_nodes;
+    auto const sink = source + 1u;
+
+    _offsets.assign( n + 1u, 0u );
+    for ( auto i = 0u; i < _num_nodes; ++i )
+    {
+      ++_offsets[2u * i + 1u];
+      ++_offsets[2u * i + 2u];
+    }
+    for ( auto const& [from, to] : _arcs )
+    {
+      ++_offsets[2u * from + 2u];
+      ++_offsets[2u * to + 1u];
+    }
+    for ( auto const& i : _sources )
+    {
+      ++_offsets[source + 1u];
+      ++_offsets[2u * i + 1u];
+    }
+    for ( auto const& i : _sinks )
+    {
+      ++_offsets[2u * i + 2u];
+      ++_offsets[sink + 1u];
+    }
+    for ( auto v = 0u; v < n; ++v )
+    {
+      _offsets[v + 1u] += _offsets[v];
+    }
+
+    _head.resize( _offsets[n] );
+    _capacity.resize( _offsets[n] );
+    _reverse.resize( _offsets[n] );
+    _backward.resize( _offsets[n] );
+    _current.assign( _offsets.begin(), _offsets.end() - 1u );
+
+    auto const add_edge = [&]( uint32_t from, uint32_t to, uint32_t capacity ) {
+      auto const a = _current[from]++;
+      auto const b = _current[to]++;
+      _head[a] = to;
+      _capacity[a] = capacity;
+      _reverse[a] = b;
+      _backward[a] = 0u;
+      _head[b] = from;
+      _capacity[b] = 0u;
+      _reverse[b] = a;
+      _backward[b] = 1u;
+    };
+
+    for ( auto i = 0u; i < _num_nodes; ++i )
+    {
+      add_edge( 2u * i, 2u * i + 1u, 1u );
+    }
+    for ( auto const& [from, to] : _arcs )
+    {
+      add_edge( 2u * from + 1u, 2u * to, unbounded );
+    }
+    for ( auto const& i : _sources )
+    {
+      add_edge( source, 2u * i, 1u );
+    }
+    for ( auto const& i : _sinks )
+    {
+      add_edge( 2u * i + 1u, sink, 1u );
+    }
+  }
+
+  /* labels each vertex with its distance to the sinks in the residual network */
+  void global_relabel()
+  {
+    auto const n = num_vertices();
+    auto const source = 2u * _num_nodes;
+    auto const sink = source + 1u;
+
+    _label.assign( n, n );
+    _label[sink] = 0u;
+    _count.assign( n, 0u );
+    _bfs.clear();
+    _bfs.push_back( sink );
+    for ( auto i = 0u; i < _bfs.size(); ++i )
+    {
+      auto const w = _bfs[i];
+      for ( auto a = _offsets[w]; a < _offsets[w + 1]; ++a )
+      {
+        auto const v = _head[a];
+        if ( v != source && _label[v] == n && _capacity[_reverse[a]] > 0u )
+        {
+          _label[v] = _label[w] + 1u;
+          _bfs.push_back( v );
+        }
+      }
+    }
+    for ( auto const& v : _bfs )
+    {
+      ++_count[_label[v]];
+    }
+
+    std::copy( _offsets.begin(), _offsets.end() - 1u, _current.begin() );
+  }
+
+  void push( uint32_t v, uint32_t a, uint32_t delta )
+  {
+    auto const w = _head[a];
+    _capacity[a] -= delta;
+    _capacity[_reverse[a]] += delta;
+    _excess[v] -= delta;
+    _excess[w] += delta;
+
+    if ( !_in_queue[w] && w < 2u * _num_nodes )
+    {
+      auto const n = num_vertices();
+      _queue[_queue_begin + _queue_size < n ? _queue_begin + _queue_size : _queue_begin + _queue_size - n] = w;
+      ++_queue_size;
+      _in_queue[w] = 1u;
+    }
+  }
+
+  /* pushes the excess of `v` to its admissible arcs, returns the number of relabels */
+  uint32_t discharge( uint32_t v )
+  {
+    auto const n = num_vertices();
+    uint32_t num_relabels{ 0u };
+
+    while ( _excess[v] > 0u )
+    {
+      if ( _current[v] == _offsets[v + 1] )
+      {
+        uint32_t label = n;
+        for ( auto a = _offsets[v]; a < _offsets[v + 1]; ++a )
+        {
+          if ( _capacity[a] > 0u )
+          {
+            label = std::min( label, _label[_head[a]] + 1u );
+          }
+        }
+        ++num_relabels;
+        relabel( v, label );
+        if ( _label[v] >= n )
+          break;
+        continue;
+      }
+
+      auto const a = _current[v];
+      if ( _capacity[a] > 0u && _label[v] == _label[_head[a]] + 1u )
+      {
+        push( v, a, std::min( _excess[v], _capacity[a] ) );
+      }
+      else
+      {
+        ++_current[v];
+      }
+    }
+
+    return num_relabels;
+  }
+
+  /* sets the label of `v`, vertices above an emptied label cannot reach the sinks anymore */
+  void relabel( uint32_t v, uint32_t label )
+  {
+    auto const n = num_vertices();
+    auto const old_label = _label[v];
+
+    _current[v] = _offsets[v];
+    if ( --_count[old_label] > 0u )
+    {
+      _label[v] = label;
+      if ( label < n )
+        ++_count[label];
+      return;
+    }
+
+    for ( auto& l : _label )
+    {
+      if ( l > old_label && l < n )
+      {
+        --_count[l];
+        l = n;
+      }
+    }
+    _label[v] = n;
+  }
+
+  /* turns the preflow into a flow by cancelling flow backwards from the vertices with excess */
+  void return_excess()
+  {
+    auto const source = 2u * _num_nodes;
+
+    std::copy( _offsets.begin(), _offsets.end() - 1u, _current.begin() );
+    _bfs.clear();
+    for ( auto v = 0u; v < source; ++v )
+    {
+      if ( _excess[v] > 0u )
+      {
+        _bfs.push_back( v );
+      }
+    }
+
+    while ( !_bfs.empty() )
+    {
+      auto const v = _bfs.back();
+      _bfs.pop_back();
+
+      while ( _excess[v] > 0u )
+      {
+        auto const a = _current[v];
+        assert( a < _offsets[v + 1] );
+        if ( !_backward[a] || _capacity[a] == 0u )
+        {
+          ++_current[v];
+          continue;
+        }
+
+        auto const w = _head[a];
+        auto const delta = std::min( _excess[v], _capacity[a] );
+        _capacity[a] -= delta;
+        _capacity[_reverse[a]] += delta;
+        _excess[v] -= delta;
+        if ( w != source && _excess[w] == 0u )
+        {
+          _bfs.push_back( w );
+        }
+        _excess[w] += delta;
+      }
+    }
+  }
+
+  /* marks the vertices reachable from the sources in the residual network */
+  void mark_reachable()
+  {
+    auto const source = 2u * _num_nodes;
+
+    std::fill( _in_queue.begin(), _in_queue.end(), 0u );
+    _in_queue[source] = 1u;
+    _bfs.clear();
+    _bfs.push_back( source );
+    for ( auto i = 0u; i < _bfs.size(); ++i )
+    {
+      auto const v = _bfs[i];
+      for ( auto a = _offsets[v]; a < _offsets[v + 1]; ++a )
+      {
+        auto const w = _head[a];
+        if ( !_in_queue[w] && _capacity[a] > 0u )
+        {
+          _in_queue[w] = 1u;
+          _bfs.push_back( w );
+        }
+      }
+    }
+  }
+
+private:
+  uint32_t _num_nodes{ 0u };
+  std::vector<std::pair<uint32_t, uint32_t>> _arcs;
+  std::vector<uint32_t> _sources;
+  std::vector<uint32_t> _sinks;
+
+  std::vector<uint32_t> _offsets;
+  std::vector<uint32_t> _head;
+  std::vector<uint32_t> _capacity;
+  std::vector<uint32_t> _reverse;
+  std::vector<uint8_t> _backward;
+  std::vector<uint32_t> _current;
+  std::vector<uint32_t> _label;
+  std::vector<uint32_t> _count;
+  std::vector<uint32_t> _excess;
+  std::vector<uint8_t> _in_queue;
+  std::vector<uint32_t> _queue;
+  uint32_t _queue_begin{ 0u };
+  uint32_t _queue_size{ 0u };
+  std::vector<uint32_t> _bfs;
+};
+
 template<class Ntk>
 class retime_impl
 {
 public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
-  static constexpr uint32_t sink_node = UINT32_MAX;
 
 public:
   explicit retime_impl( Ntk& ntk, retime_params const& ps, retime_stats& st )
       : _ntk( ntk ),
         _ps( ps ),
         _st( st ),
-        _flow_path( ntk )
+        _flow_index( ntk )
   {}
 
 public:
@@ -162,51 +565,53 @@ private:
   template<bool forward>
   std::vector<node> max_flow( uint32_t iteration )
   {
-    uint32_t flow = 0;
+    collect_flow_clusters<forward>();
 
-    _flow_path.reset();
-    _ntk.incr_trav_id();
+    auto const num_clusters = static_cast<uint32_t>( _cluster_offsets.size() - 1u );
+    std::vector<std::vector<uint32_t>> cuts( num_clusters );
+    _solvers.resize( std::max( 1u, _ps.num_threads ) );
 
-    /* run max flow from each register (capacity 1) */
-    _ntk.foreach_register( [&]( auto const& n ) {
-      uint32_t local_flow;
-      if constexpr ( forward )
-      {
-        local_flow = max_flow_forwards_compute_rec( _ntk.fanout( n )[0] );
-      }
-      else
+    /* clusters do not share nodes, their minimum cuts are independent */
+    parallel_for( _ps.num_threads, num_clusters, [&]( uint64_t c, uint32_t thread_id ) {
+      auto const begin = _cluster_offsets[c];
+      auto const end = _cluster_offsets[c + 1];
+
+      /* a register alone in its region */
+      if ( end - begin == 1u )
       {
-        node fanin = _ntk.get_node( _ntk.get_fanin0( n ) );
-        local_flow = max_flow_backwards_compute_rec( fanin );
+        if ( _flow_sink[begin] )
+          cuts[c].push_back( 0u );
+        return;
       }
 
-      flow += local_flow;
-
-      if ( local_flow )
-        _ntk.incr_trav_id();
-
-      return true;
-    } );
-
-    /* run reachability */
-    _ntk.incr_trav_id();
-    _ntk.foreach_register( [&]( auto const& n ) {
-      uint32_t local_flow;
-      if constexpr ( forward )
+      auto& solver = _solvers[thread_id];
+      solver.reset( end - begin );
+      for ( auto i = begin; i < end; ++i )
       {
-        local_flow = max_flow_forwards_compute_rec( _ntk.fanout( n )[0] );
+        if ( _flow_source[i] )
+          solver.add_source( i - begin );
+        if ( _flow_sink[i] )
+          solver.add_sink( i - begin );
       }
-      else
+      for ( auto a = _arc_offsets[c]; a < _arc_offsets[c + 1]; ++a )
       {
-        node fanin = _ntk.get_node( _ntk.get_fanin0( n ) );
-        local_flow = max_flow_backwards_compute_rec( fanin );
+        solver.add_arc( _arcs[a].first, _arcs[a].second );
       }
-
-      assert( local_flow == 0 );
-      return true;
+      solver.run( cuts[c] );
     } );
 
-    auto min_cut = get_min_cut();
+    std::vector<node> min_cut;
+    min_cut.reserve( _ntk.num_registers() );
+    for ( auto c = 0u; c < num_clusters; ++c )
+    {
+      for ( auto const& i : cuts[c] )
+      {
+        min_cut.push_back( _flow_nodes[_cluster_offsets[c] + i] );
+      }
+    }
+    std::sort( min_cut.begin(), min_cut.end(), [&]( auto const& a, auto const& b ) {
+      return _ntk.node_to_index( a ) < _ntk.node_to_index( b );
+    } );
 
     // assert( check_min_cut<forward>( min_cut, iteration ) );
 
@@ -215,171 +620,139 @@ private:
     return min_cut;
   }
 
-  uint32_t max_flow_forwards_compute_rec( node const& n )
+  /* collects the flow network of each group of registers whose regions overlap */
+  template<bool forward>
+  void collect_flow_clusters()
   {
-    uint32_t found_path = 0;
-
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return 0;
-
-    _ntk.set_visited( n, _ntk.trav_id() );
-
-    /* node is not in a flow path */
-    if ( _flow_path[n] == 0 )
-    {
-      /* cut boundary (sink) */
-      if ( _ntk.value( n ) )
+    std::vector<node> sources;
+    _ntk.foreach_register( [&]( auto const& n ) {
+      if constexpr ( forward )
       {
-        _flow_path[n] = sink_node;
-        return 1;
+        sources.push_back( _ntk.fanout( n )[0] );
       }
-
-      _ntk.foreach_fanout( n, [&]( auto const& f ) {
-        /* there is a path for flow */
-        if ( max_flow_forwards_compute_rec( f ) )
-        {
-          _flow_path[n] = _ntk.node_to_index( f );
-          found_path = 1;
-          return false;
-        }
-        return true;
-      } );
-
-      return found_path;
-    }
-
-    /* path has flow already, find alternative path from fanin with flow */
-    node fanin_flow = 0;
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return true;
-      if ( _flow_path[f] == _ntk.node_to_index( n ) )
+      else
       {
-        fanin_flow = _ntk.get_node( f );
-        return false;
+        sources.push_back( _ntk.get_node( _ntk.get_fanin0( n ) ) );
       }
       return true;
     } );
 
-    if ( fanin_flow == 0 )
-      return 0;
-
-    /* augment path */
-    _ntk.foreach_fanout( fanin_flow, [&]( auto const& f ) {
-      /* there is a path for flow */
-      if ( max_flow_forwards_compute_rec( f ) )
+    std::vector<uint32_t> parent( sources.size() );
+    std::iota( parent.begin(), parent.end(), 0u );
+    auto const find = [&]( uint32_t i ) {
+      while ( parent[i] != i )
       {
-        _flow_path[fanin_flow] = _ntk.node_to_index( f );
-        found_path = 1;
-        return false;
+        i = parent[i] = parent[parent[i]];
       }
-      return true;
-    } );
-
-    if ( found_path )
-      return 1;
-
-    if ( max_flow_forwards_compute_rec( fanin_flow ) )
-    {
-      _flow_path[fanin_flow] = 0;
-      return 1;
-    }
-
-    return 0;
-  }
-
-  uint32_t max_flow_backwards_compute_rec( node const& n )
-  {
-    uint32_t found_path = 0;
-
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return 0;
-
-    _ntk.set_visited( n, _ntk.trav_id() );
-
-    /* node is not in a flow path */
-    if ( _flow_path[n] == 0 )
+      return i;
+    };
+
+    /* explore the region of each register up to the sinks, nodes are numbered in order of discovery */
+    _flow_index.reset( UINT32_MAX );
+    std::vector<node> region;
+    std::vector<uint32_t> owner;
+    std::vector<uint8_t> is_sink;
+    std::vector<std::pair<uint32_t, uint32_t>> arcs;
+    for ( auto i = 0u; i < sources.size(); ++i )
     {
-      /* cut boundary (sink) */
-      if ( _ntk.value( n ) )
-      {
-        _flow_path[n] = sink_node;
-        return 1;
-      }
-
-      _ntk.foreach_fanin( n, [&]( auto const& f ) {
-        if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-          return true;
-        /* there is a path for flow */
-        if ( max_flow_backwards_compute_rec( _ntk.get_node( f ) ) )
+      auto const visit = [&]( node const& n ) {
+        if ( _flow_index[n] == UINT32_MAX )
         {
-          _flow_path[n] = _ntk.node_to_index( _ntk.get_node( f ) );
-          found_path = 1;
-          return false;
+          _flow_index[n] = static_cast<uint32_t>( region.size() );
+          region.push_back( n );
+          owner.push_back( i );
+          is_sink.push_back( _ntk.value( n ) ? 1u : 0u );
+          _stack.push_back( n );
         }
-        return true;
-      } );
-
-      return found_path;
-    }
+        else
+        {
+          parent[find( owner[_flow_index[n]] )] = find( i );
+        }
+      };
 
-    /* path has flow already, find alternative path from fanout with flow */
-    node fanout_flow = 0;
-    _ntk.foreach_fanout( n, [&]( auto const& f ) {
-      if ( _flow_path[f] == _ntk.node_to_index( n ) )
+      visit( sources[i] );
+      while ( !_stack.empty() )
       {
-        fanout_flow = _ntk.get_node( f );
-        return false;
+        auto const n = _stack.back();
+        _stack.pop_back();
+        if ( is_sink[_flow_index[n]] )
+          continue;
+        foreach_flow_successor<forward>( n, [&]( node const& f ) {
+          visit( f );
+          arcs.emplace_back( _flow_index[n], _flow_index[f] );
+        } );
       }
-      return true;
-    } );
-
-    if ( fanout_flow == 0 )
-      return 0;
+    }
 
-    /* augment path */
-    _ntk.foreach_fanin( fanout_flow, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return true;
-      /* there is a path for flow */
-      if ( max_flow_backwards_compute_rec( _ntk.get_node( f ) ) )
+    /* store the nodes and arcs of each cluster consecutively */
+    std::vector<uint32_t> cluster_of( sources.size(), UINT32_MAX );
+    std::vector<uint32_t> local( region.size() );
+    std::vector<uint32_t> sizes;
+    for ( auto i = 0u; i < region.size(); ++i )
+    {
+      auto& c = cluster_of[find( owner[i] )];
+      if ( c == UINT32_MAX )
       {
-        _flow_path[fanout_flow] = _ntk.node_to_index( _ntk.get_node( f ) );
-        found_path = 1;
-        return false;
+        c = static_cast<uint32_t>( sizes.size() );
+        sizes.push_back( 0u );
       }
-      return true;
-    } );
+      owner[i] = c;
+      local[i] = sizes[c]++;
+    }
 
-    if ( found_path )
-      return 1;
+    _cluster_offsets.assign( sizes.size() + 1u, 0u );
+    _arc_offsets.assign( sizes.size() + 1u, 0u );
+    for ( auto c = 0u; c < sizes.size(); ++c )
+    {
+      _cluster_offsets[c + 1] = _cluster_offsets[c] + sizes[c];
+    }
+    for ( auto const& [from, to] : arcs )
+    {
+      ++_arc_offsets[owner[from] + 1];
+    }
+    std::partial_sum( _arc_offsets.begin(), _arc_offsets.end(), _arc_offsets.begin() );
 
-    if ( max_flow_backwards_compute_rec( fanout_flow ) )
+    _flow_nodes.resize( region.size() );
+    _flow_sink.resize( region.size() );
+    _flow_source.assign( region.size(), 0u );
+    for ( auto i = 0u; i < region.size(); ++i )
     {
-      _flow_path[fanout_flow] = 0;
-      return 1;
+      auto const position = _cluster_offsets[owner[i]] + local[i];
+      _flow_nodes[position] = region[i];
+      _flow_sink[position] = is_sink[i];
+    }
+    for ( auto const& n : sources )
+    {
+      auto const i = _flow_index[n];
+      _flow_source[_cluster_offsets[owner[i]] + local[i]] = 1u;
     }
 
-    return 0;
+    std::vector<uint32_t> next( _arc_offsets.begin(), _arc_offsets.end() - 1u );
+    _arcs.resize( arcs.size() );
+    for ( auto const& [from, to] : arcs )
+    {
+      _arcs[next[owner[from]]++] = { local[from], local[to] };
+    }
   }
 
-  std::vector<node> get_min_cut()
+  template<bool forward, typename Fn>
+  void foreach_flow_successor( node const& n, Fn&& fn )
   {
-    std::vector<node> min_cut;
-    min_cut.reserve( _ntk.num_registers() );
-
-    _ntk.foreach_node( [&]( auto const& n ) {
-      if ( _flow_path[n] == 0 )
-        return true;
-      if ( _ntk.visited( n ) != _ntk.trav_id() )
-        return true;
-
-      if ( _ntk.value( n ) || _ntk.visited( _flow_path[n] ) != _ntk.trav_id() )
-        min_cut.push_back( n );
-      return true;
-    } );
-
-    return min_cut;
+    if constexpr ( forward )
+    {
+      _ntk.foreach_fanout( n, [&]( auto const& f ) {
+        fn( f );
+      } );
+    }
+    else
+    {
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        if ( !_ntk.is_constant( _ntk.get_node( f ) ) )
+        {
+          fn( _ntk.get_node( f ) );
+        }
+      } );
+    }
   }
 
   template<bool forward>
@@ -393,7 +766,7 @@ private:
 
     for ( auto const& n : min_cut )
     {
-      rec_mark_tfi( n );
+      mark_tfi( n );
     }
 
     min_cut.clear();
@@ -436,22 +809,29 @@ private:
 
   void collect_cut_nodes_tfi( node const& n, std::vector<node>& min_cut )
   {
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return;
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      auto const m = _stack.back();
+      _stack.pop_back();
 
-    _ntk.set_visited( n, _ntk.trav_id() );
+      if ( _ntk.visited( m ) == _ntk.trav_id() )
+        continue;
 
-    if ( _ntk.value( n ) )
-    {
-      min_cut.push_back( n );
-      return;
-    }
+      _ntk.set_visited( m, _ntk.trav_id() );
 
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return;
-      collect_cut_nodes_tfi( _ntk.get_node( f ), min_cut );
-    } );
+      if ( _ntk.value( m ) )
+      {
+        min_cut.push_back( m );
+        continue;
+      }
+
+      _ntk.foreach_fanin( m, [&]( auto const& f ) {
+        if ( _ntk.is_constant( _ntk.get_node( f ) ) )
+          return;
+        _stack.push_back( _ntk.get_node( f ) );
+      } );
+    }
   }
 
   template<bool forward>
@@ -479,7 +859,7 @@ private:
 
       /* exclude reachable nodes from PIs from retiming */
       _ntk.foreach_pi( [&]( auto const& n ) {
-        rec_mark_tfo( n );
+        mark_tfo( n );
       } );
 
       /* mark childrens of marked nodes */
@@ -518,7 +898,7 @@ private:
 
       /* exclude reachable nodes from POs from retiming */
       _ntk.foreach_po( [&]( auto const& f ) {
-        rec_mark_tfi( _ntk.get_node( f ) );
+        mark_tfi( _ntk.get_node( f ) );
       } );
     }
   }
@@ -628,28 +1008,45 @@ private:
     } );
   }
 
-  void rec_mark_tfo( node const& n )
+  void mark_tfo( node const& n )
   {
     if ( _ntk.value( n ) )
       return;
 
     _ntk.set_value( n, 1 );
-    _ntk.foreach_fanout( n, [&]( auto const& f ) {
-      rec_mark_tfo( f );
-    } );
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      auto const m = _stack.back();
+      _stack.pop_back();
+      _ntk.foreach_fanout( m, [&]( auto const& f ) {
+        if ( _ntk.value( f ) )
+          return;
+        _ntk.set_value( f, 1 );
+        _stack.push_back( f );
+      } );
+    }
   }
 
-  void rec_mark_tfi( node const& n )
+  void mark_tfi( node const& n )
   {
     if ( _ntk.value( n ) )
       return;
 
     _ntk.set_value( n, 1 );
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return;
-      rec_mark_tfi( _ntk.get_node( f ) );
-    } );
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      auto const m = _stack.back();
+      _stack.pop_back();
+      _ntk.foreach_fanin( m, [&]( auto const& f ) {
+        auto const g = _ntk.get_node( f );
+        if ( _ntk.is_constant( g ) || _ntk.value( g ) )
+          return;
+        _ntk.set_value( g, 1 );
+        _stack.push_back( g );
+      } );
+    }
   }
 
   template<bool forward>
@@ -736,7 +1133,15 @@ private:
   retime_params const& _ps;
   retime_stats& _st;
 
-  node_map<uint32_t, Ntk> _flow_path;
+  node_map<uint32_t, Ntk> _flow_index;
+  std::vector<node> _flow_nodes;
+  std::vector<uint32_t> _cluster_offsets;
+  std::vector<uint32_t> _arc_offsets;
+  std::vector<std::pair<uint32_t, uint32_t>> _arcs;
+  std::vector<uint8_t> _flow_sink;
+  std::vector<uint8_t> _flow_source;
+  std::vector<unit_capacity_min_cut> _solvers;
+  std::vector<node> _stack;
 };
 
 } /* namespace detail */
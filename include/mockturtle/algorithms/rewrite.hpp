@@ -36,6 +36,7 @@
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/color_view.hpp"
 #include "../views/depth_view.hpp"
 #include "../views/fanout_view.hpp"
@@ -145,6 +146,7 @@ public:
 
   void run()
   {
+    MOCKTURTLE_TRACE_SCOPE( "rewrite" );
     stopwatch t( st.time_total );
 
     ntk.incr_trav_id();
@@ -206,6 +208,7 @@ private:
 
       cut_manager.clear_cuts( n );
       cut_manager.compute_cuts( n );
+      MOCKTURTLE_TRACE_COUNT( "rewrite/cuts", cuts.cuts( ntk.node_to_index( n ) ).size() );
 
       uint32_t cut_index = 0;
       for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
@@ -218,6 +221,7 @@ private:
         }
 
         /* Boolean matching */
+        MOCKTURTLE_TRACE_COUNT( "rewrite/npn_canonizations", 1 );
         auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
@@ -227,6 +231,7 @@ private:
 
         if ( structures == nullptr )
         {
+          MOCKTURTLE_TRACE_COUNT( "rewrite/library_misses", 1 );
           ++cut_index;
           continue;
         }
@@ -316,6 +321,7 @@ private:
         assert( n != ntk.get_node( new_f ) );
 
         _estimated_gain += best_gain;
+        MOCKTURTLE_TRACE_COUNT( "rewrite/substitutions", 1 );
         ntk.substitute_node_no_restrash( n, new_f ^ best_phase );
 
         if constexpr ( has_level_v<Ntk> )
@@ -388,6 +394,7 @@ private:
 
       cut_manager.clear_cuts( n );
       cut_manager.compute_cuts( n );
+      MOCKTURTLE_TRACE_COUNT( "rewrite/cuts", cuts.cuts( ntk.node_to_index( n ) ).size() );
 
       /* compute window */
       std::vector<node<Ntk>> roots = { n };
@@ -410,6 +417,7 @@ private:
         }
 
         /* Boolean matching */
+        MOCKTURTLE_TRACE_COUNT( "rewrite/npn_canonizations", 1 );
         auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
@@ -453,6 +461,7 @@ private:
 
         if ( structures == nullptr )
         {
+          MOCKTURTLE_TRACE_COUNT( "rewrite/library_misses", 1 );
           ++cut_index;
           continue;
         }
@@ -542,6 +551,7 @@ private:
         assert( n != ntk.get_node( new_f ) );
 
         _estimated_gain += best_gain;
+        MOCKTURTLE_TRACE_COUNT( "rewrite/substitutions", 1 );
         ntk.substitute_node_no_restrash( n, new_f ^ best_phase );
 
         if constexpr ( has_level_v<Ntk> )
@@ -749,6 +759,7 @@ private:
 
   void compute_required()
   {
+    MOCKTURTLE_TRACE_SCOPE( "rewrite/required_times" );
     if constexpr ( has_level_v<Ntk> )
     {
       ntk.foreach_po( [&]( auto const& f ) {
@@ -0,0 +1,459 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sequential_simulation.hpp
+  \brief Cycle-based simulation of sequential networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <kitty/detail/mscfix.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include "../networks/sequential.hpp"
+#include "../traits.hpp"
+#include "../views/topo_view.hpp"
+
+namespace mockturtle
+{
+
+struct sequential_simulation_params
+{
+  /*! \brief Number of 64-bit words per signal.
+   *
+   * Each bit of a word simulates an independent trace, such that
+   * `64 * num_words` traces are simulated in parallel.
+   */
+  uint32_t num_words{ 1u };
+};
+
+/*! \brief Cycle-based simulator for sequential networks.
+ *
+ * Simulates `64 * num_words` independent traces of a sequential network in
+ * parallel, one clock cycle at a time.  In each cycle, the registers latch
+ * the values of their inputs computed in the previous cycle, the primary
+ * inputs are assigned, and the gates are evaluated in topological order.
+ * The registers start from their initial values (`register_t::init`), where
+ * unknown initial values are 0.
+ *
+ * For each node, the simulator counts the number of toggles, i.e., the
+ * number of traces in which the value of the node differs from its value in
+ * the previous cycle.  The toggle rates can be used as switching activity
+ * for power-aware mapping (e.g., `emap_params::switching_activity`).
+ *
+ * Gates of AIG-like networks are evaluated with `compute`, and gates of
+ * k-LUT networks with their functions, which are cached when the simulator
+ * is constructed.
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      sequential<aig_network> aig = ...;
+
+      sequential_simulator sim( aig );
+      std::ifstream in( "stimuli.txt" );
+      sim.simulate_stream( in );
+
+      emap_params ps;
+      ps.eswp_rounds = 2;
+      ps.switching_activity = sim.switching_activity();
+      auto const res = emap( aig, lib, ps );
+   \endverbatim
+ */
+template<class Ntk>
+class sequential_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr bool is_aig_like = detail::is_aig_like_v<typename Ntk::base_type>;
+
+public:
+  explicit sequential_simulator( Ntk const& ntk, sequential_simulation_params const& ps = {} )
+      : _ntk( ntk ),
+        _num_words( ps.num_words ),
+        _values( ntk.size() * ps.num_words ),
+        _toggles( ntk.size() )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( is_aig_like || std::is_same_v<typename Ntk::base_type, klut_network>, "Ntk is neither an AIG-like nor a k-LUT network" );
+    static_assert( has_num_registers_v<Ntk>, "Ntk does not implement the num_registers method" );
+    static_assert( has_foreach_ro_v<Ntk>, "Ntk does not implement the foreach_ro method" );
+    static_assert( has_foreach_ri_v<Ntk>, "Ntk does not implement the foreach_ri method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    assert( ps.num_words > 0u );
+
+    /* `topo_view::foreach_gate` skips only the PIs, register outputs are filtered here */
+    topo_view<Ntk> topo{ ntk };
+    topo.foreach_node( [&]( auto const& n ) {
+      if ( !ntk.is_constant( n ) && !ntk.is_ci( n ) )
+      {
+        _gates.push_back( n );
+      }
+    } );
+
+    if constexpr ( !is_aig_like )
+    {
+      _function_offsets.reserve( _gates.size() + 1u );
+      _function_offsets.push_back( 0u );
+      for ( auto const& n : _gates )
+      {
+        auto const tt = ntk.node_function( n );
+        _functions.insert( _functions.end(), tt.cbegin(), tt.cend() );
+        _function_offsets.push_back( static_cast<uint32_t>( _functions.size() ) );
+      }
+    }
+
+    reset();
+  }
+
+  /*! \brief Restores the initial values of the registers and clears the toggles. */
+  void reset()
+  {
+    std::fill( _values.begin(), _values.end(), 0u );
+    std::fill( _toggles.begin(), _toggles.end(), 0u );
+    _num_cycles = 0u;
+
+    _ntk.foreach_node( [&]( auto const& n ) {
+      if ( _ntk.is_constant( n ) && _ntk.constant_value( n ) )
+      {
+        std::fill_n( _values.begin() + word_index( n ), _num_words, ~UINT64_C( 0 ) );
+      }
+    } );
+    _ntk.foreach_ro( [&]( auto const& n, auto i ) {
+      auto const init = _ntk.register_at( i ).init;
+      std::fill_n( _values.begin() + word_index( n ), _num_words, init == 1u ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    } );
+  }
+
+  /*! \brief Simulates one clock cycle.
+   *
+   * \param inputs Values of the primary inputs, `num_words` consecutive words per input
+   */
+  void simulate_cycle( std::vector<uint64_t> const& inputs )
+  {
+    assert( inputs.size() == _ntk.num_pis() * _num_words );
+
+    /* registers latch the values of the previous cycle */
+    if ( _num_cycles > 0u )
+    {
+      _next_state.clear();
+      _ntk.foreach_ri( [&]( auto const& f ) {
+        for ( auto w = 0u; w < _num_words; ++w )
+        {
+          _next_state.push_back( value( f, w ) );
+        }
+      } );
+      auto it = _next_state.begin();
+      _ntk.foreach_ro( [&]( auto const& n ) {
+        for ( auto w = 0u; w < _num_words; ++w )
+        {
+          update( n, w, *it++ );
+        }
+      } );
+    }
+
+    _ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      for ( auto w = 0u; w < _num_words; ++w )
+      {
+        update( n, w, inputs[i * _num_words + w] );
+      }
+    } );
+
+    for ( auto i = 0u; i < _gates.size(); ++i )
+    {
+      evaluate( i );
+    }
+
+    ++_num_cycles;
+  }
+
+  /*! \brief Simulates cycles with uniformly random input values. */
+  void simulate_random_cycles( uint32_t num_cycles, uint64_t seed = 1u )
+  {
+    std::mt19937_64 rng( seed );
+    std::vector<uint64_t> inputs( _ntk.num_pis() * _num_words );
+    for ( auto c = 0u; c < num_cycles; ++c )
+    {
+      std::generate( inputs.begin(), inputs.end(), [&]() { return rng(); } );
+      simulate_cycle( inputs );
+    }
+  }
+
+  /*! \brief Simulates the input vectors of a stream.
+   *
+   * Each line of the stream is one clock cycle.  It contains either a
+   * single input vector, which is assigned to all traces, or one input
+   * vector per trace (`num_traces()` vectors), separated by whitespace.  An
+   * input vector has one character per primary input, `0` or `1`.  Empty
+   * lines and lines starting with `#` are skipped.  The stream is read line
+   * by line, such that memory does not depend on its length.
+   *
+   * Simulation stops at the first malformed line, after the cycles of the
+   * previous lines have been simulated.
+   *
+   * \param in Input stream
+   * \return Number of simulated cycles, or `std::nullopt` if a line is malformed
+   */
+  std::optional<uint64_t> simulate_stream( std::istream& in )
+  {
+    auto const num_pis = _ntk.num_pis();
+    std::vector<uint64_t> inputs( num_pis * _num_words );
+
+    uint64_t num_cycles{ 0u };
+    std::string line, vector;
+    while ( std::getline( in, line ) )
+    {
+      if ( !line.empty() && line.back() == '\r' )
+      {
+        line.pop_back();
+      }
+      if ( line.empty() || line[0] == '#' )
+      {
+        continue;
+      }
+
+      std::fill( inputs.begin(), inputs.end(), 0u );
+      std::istringstream columns( line );
+      uint32_t trace{ 0u };
+      while ( columns >> vector )
+      {
+        if ( trace == num_traces() || vector.size() != num_pis )
+        {
+          return std::nullopt;
+        }
+
+        auto const word = trace >> 6;
+        auto const mask = UINT64_C( 1 ) << ( trace & 63 );
+        for ( auto i = 0u; i < num_pis; ++i )
+        {
+          if ( vector[i] == '1' )
+          {
+            inputs[i * _num_words + word] |= mask;
+          }
+          else if ( vector[i] != '0' )
+          {
+            return std::nullopt;
+          }
+        }
+        ++trace;
+      }
+
+      if ( trace == 1u )
+      {
+        /* broadcast the vector to all traces */
+        for ( auto i = 0u; i < num_pis; ++i )
+        {
+          std::fill_n( inputs.begin() + i * _num_words, _num_words, inputs[i * _num_words] ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+        }
+      }
+      else if ( trace != num_traces() )
+      {
+        return std::nullopt;
+      }
+
+      simulate_cycle( inputs );
+      ++num_cycles;
+    }
+    return num_cycles;
+  }
+
+  /*! \brief Simulates the input vectors of a file (see `simulate_stream`).
+   *
+   * \return Number of simulated cycles, or `std::nullopt` if the file cannot be opened or a line is malformed
+   */
+  std::optional<uint64_t> simulate_file( std::string const& filename )
+  {
+    std::ifstream in( filename, std::ifstream::in );
+    if ( !in.is_open() )
+    {
+      return std::nullopt;
+    }
+    return simulate_stream( in );
+  }
+
+  /*! \brief Number of traces simulated in parallel. */
+  uint32_t num_traces() const
+  {
+    return 64u * _num_words;
+  }
+
+  /*! \brief Number of simulated cycles. */
+  uint64_t num_cycles() const
+  {
+    return _num_cycles;
+  }
+
+  /*! \brief Values of node `n` in 64 traces of the last cycle. */
+  uint64_t value( node const& n, uint32_t word = 0u ) const
+  {
+    return _values[word_index( n ) + word];
+  }
+
+  /*! \brief Values of signal `f` in 64 traces of the last cycle. */
+  template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
+  uint64_t value( signal const& f, uint32_t word = 0u ) const
+  {
+    auto const v = value( _ntk.get_node( f ), word );
+    return _ntk.is_complemented( f ) ? ~v : v;
+  }
+
+  /*! \brief Number of toggles of node `n` over all traces and cycles. */
+  uint64_t toggles( node const& n ) const
+  {
+    return _toggles[_ntk.node_to_index( n )];
+  }
+
+  /*! \brief Toggle rate of each node (indexed by node index).
+   *
+   * The toggle rate is the number of toggles divided by the number of
+   * traces and transitions between consecutive cycles.
+   */
+  std::vector<float> switching_activity() const
+  {
+    std::vector<float> activity( _toggles.size(), 0.0f );
+    if ( _num_cycles < 2u )
+    {
+      return activity;
+    }
+
+    auto const num_transitions = static_cast<double>( num_traces() ) * static_cast<double>( _num_cycles - 1u );
+    for ( auto i = 0u; i < _toggles.size(); ++i )
+    {
+      activity[i] = static_cast<float>( _toggles[i] / num_transitions );
+    }
+    return activity;
+  }
+
+private:
+  std::size_t word_index( node const& n ) const
+  {
+    return static_cast<std::size_t>( _ntk.node_to_index( n ) ) * _num_words;
+  }
+
+  void update( node const& n, uint32_t word, uint64_t value )
+  {
+    auto& old_value = _values[word_index( n ) + word];
+    if ( _num_cycles > 0u )
+    {
+      auto const diff = old_value ^ value;
+      _toggles[_ntk.node_to_index( n )] += __builtin_popcount( static_cast<uint32_t>( diff & 0xffffffff ) ) + __builtin_popcount( static_cast<uint32_t>( diff >> 32 ) );
+    }
+    old_value = value;
+  }
+
+  void evaluate( uint32_t gate )
+  {
+    auto const& n = _gates[gate];
+
+    if constexpr ( is_aig_like )
+    {
+      /* complemented fanins are handled by `compute` */
+      std::array<kitty::static_truth_table<6u>, Ntk::max_fanin_size> tts;
+      auto const num_fanins = _ntk.fanin_size( n );
+      for ( auto w = 0u; w < _num_words; ++w )
+      {
+        _ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          tts[i]._bits = value( _ntk.get_node( f ), w );
+        } );
+        update( n, w, _ntk.compute( n, tts.begin(), tts.begin() + num_fanins )._bits );
+      }
+    }
+    else
+    {
+      _fanins.clear();
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        _fanins.push_back( word_index( _ntk.get_node( f ) ) );
+      } );
+      auto const num_fanins = static_cast<uint32_t>( _fanins.size() );
+      auto const function = _functions.begin() + _function_offsets[gate];
+
+      /* multiplexer tree over the minterms of the function */
+      _minterms.resize( std::size_t( 1 ) << num_fanins );
+      for ( auto w = 0u; w < _num_words; ++w )
+      {
+        for ( auto m = 0u; m < _minterms.size(); ++m )
+        {
+          _minterms[m] = ( ( *( function + ( m >> 6 ) ) >> ( m & 63 ) ) & 1 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+        }
+        for ( auto i = 0u, size = static_cast<uint32_t>( _minterms.size() ); i < num_fanins; ++i, size >>= 1 )
+        {
+          auto const x = _values[_fanins[i] + w];
+          for ( auto m = 0u; m < size / 2u; ++m )
+          {
+            _minterms[m] = ( x & _minterms[2u * m + 1u] ) | ( ~x & _minterms[2u * m] );
+          }
+        }
+        update( n, w, _minterms[0] );
+      }
+    }
+  }
+
+private:
+  Ntk const& _ntk;
+  uint32_t _num_words;
+
+  std::vector<node> _gates;
+  std::vector<uint64_t> _values;
+  std::vector<uint64_t> _toggles;
+  uint64_t _num_cycles{ 0u };
+
+  /* functions of the gates of k-LUT networks */
+  std::vector<uint64_t> _functions;
+  std::vector<uint32_t> _function_offsets;
+
+  std::vector<uint64_t> _next_state;
+  std::vector<std::size_t> _fanins;
+  std::vector<uint64_t> _minterms;
+};
+
+template<class T>
+sequential_simulator( T const& ) -> sequential_simulator<T>;
+
+template<class T>
+sequential_simulator( T const&, sequential_simulation_params const& ) -> sequential_simulator<T>;
+
+} // namespace mockturtle
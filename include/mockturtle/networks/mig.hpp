@@ -196,6 +196,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
+    _storage->backup_node( f.index );
     _storage->nodes[f.index].data[0].h1++;
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
@@ -308,8 +309,11 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
+    _storage->backup_node( a.index );
     _storage->nodes[a.index].data[0].h1++;
+    _storage->backup_node( b.index );
     _storage->nodes[b.index].data[0].h1++;
+    _storage->backup_node( c.index );
     _storage->nodes[c.index].data[0].h1++;
 
     for ( auto const& fn : _events->on_add )
@@ -540,6 +544,7 @@ public:
     const auto old_child2 = signal{ node.children[2] };
 
     // erase old node in hash table
+    _storage->backup_node( n );
     _storage->hash.erase( node );
 
     // insert updated node into hash table
@@ -549,8 +554,10 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
+    _storage->backup_node( new_signal.index );
     _storage->nodes[new_signal.index].data[0].h1++;
     // update the reference counter of the old signal
+    _storage->backup_node( old_node );
     _storage->nodes[old_node].data[0].h1--;
 
     for ( auto const& fn : _events->on_modified )
@@ -610,6 +617,7 @@ public:
     const auto old_child2 = signal{ node.children[2] };
 
     // erase old node in hash table
+    _storage->backup_node( n );
     _storage->hash.erase( node );
 
     // insert updated node into hash table
@@ -622,8 +630,10 @@ public:
     }
 
     // update the reference counter of the new signal
+    _storage->backup_node( new_signal.index );
     _storage->nodes[new_signal.index].data[0].h1++;
     // update the reference counter of the old signal
+    _storage->backup_node( old_node );
     _storage->nodes[old_node].data[0].h1--;
 
     for ( auto const& fn : _events->on_modified )
@@ -641,14 +651,17 @@ public:
     {
       if ( output.index == old_node )
       {
+        _storage->backup_output( output );
         output.index = new_signal.index;
         output.weight ^= new_signal.complement;
 
         if ( old_node != new_signal.index )
         {
           // increment fan-out of new node
+          _storage->backup_node( new_signal.index );
           _storage->nodes[new_signal.index].data[0].h1++;
           // decrement fan-out of old node
+          _storage->backup_node( old_node );
           _storage->nodes[old_node].data[0].h1--;
         }
       }
@@ -662,6 +675,7 @@ public:
       return;
 
     auto& nobj = _storage->nodes[n];
+    _storage->backup_node( n );
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
@@ -690,6 +704,7 @@ public:
 
     assert( n < _storage->nodes.size() );
     auto& nobj = _storage->nodes[n];
+    _storage->backup_node( n );
     nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
 
@@ -836,11 +851,13 @@ public:
 
   uint32_t incr_fanout_size( node const& n ) const
   {
+    _storage->backup_node( n );
     return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
+    _storage->backup_node( n );
     return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
   }
 
@@ -39,7 +39,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -209,6 +212,124 @@ struct empty_storage_data
 {
 };
 
+/*! \brief Copy-on-write backup of the nodes of a storage.
+ *
+ * While a backup is active, networks save a node before modifying it.
+ * Nodes are saved in chunks of `chunk_size` consecutive nodes, the first
+ * time one of them is modified, such that starting a backup takes
+ * constant time and restoring it only rewrites the modified nodes of the
+ * saved chunks.  Whether a modified node was in the structural hash table
+ * is recorded when it is first modified.  Copies of a storage do not
+ * inherit its backup.
+ */
+template<typename Node>
+struct node_backup
+{
+  static constexpr uint64_t chunk_bits = 10u;
+  static constexpr uint64_t chunk_size = UINT64_C( 1 ) << chunk_bits;
+
+  /* states of the nodes in a saved chunk */
+  enum node_state : uint8_t
+  {
+    unmodified = 0,
+    modified = 1,
+    modified_hashed = 2
+  };
+
+  struct chunk
+  {
+    uint64_t first;
+    std::vector<Node> nodes;
+    std::vector<uint8_t> states;
+  };
+
+  node_backup() = default;
+
+  node_backup( node_backup const& )
+  {
+  }
+
+  node_backup& operator=( node_backup const& )
+  {
+    clear();
+    return *this;
+  }
+
+  void clear()
+  {
+    active = false;
+    outputs_saved = false;
+    chunk_slots.clear();
+    chunks.clear();
+    outputs.clear();
+  }
+
+  bool active{ false };
+  uint64_t num_nodes{ 0u };
+  uint64_t num_inputs{ 0u };
+  uint64_t num_outputs{ 0u };
+
+  /* 1 + position of the chunk in `chunks`, or 0 if it has not been saved */
+  std::vector<uint32_t> chunk_slots;
+  std::vector<chunk> chunks;
+
+  bool outputs_saved{ false };
+  std::vector<typename Node::pointer_type> outputs;
+};
+
+/*! \brief Log of the modifications of the nodes of a storage.
+ *
+ * While a transaction is open, networks log the previous content of a
+ * node (and whether it was in the structural hash table) before each
+ * modification, as well as the previous driver of each redirected output.
+ * Transactions can be nested, and rolling one back undoes its
+ * modifications in reverse order, in time linear in their number.  Copies
+ * of a storage do not inherit its log.
+ */
+template<typename Node>
+struct node_undo_log
+{
+  struct node_entry
+  {
+    uint64_t index;
+    Node node;
+    bool hashed;
+  };
+
+  struct output_entry
+  {
+    uint64_t index;
+    typename Node::pointer_type output;
+  };
+
+  struct transaction
+  {
+    uint64_t num_nodes;
+    uint64_t num_inputs;
+    uint64_t num_outputs;
+    uint64_t num_node_entries;
+    uint64_t num_output_entries;
+  };
+
+  node_undo_log() = default;
+
+  node_undo_log( node_undo_log const& )
+  {
+  }
+
+  node_undo_log& operator=( node_undo_log const& )
+  {
+    transactions.clear();
+    node_entries.clear();
+    output_entries.clear();
+    return *this;
+  }
+
+  std::vector<transaction> transactions;
+  std::vector<node_entry> node_entries;
+  std::vector<output_entry> output_entries;
+};
+
 template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
 struct storage
 {
@@ -232,6 +353,211 @@ struct storage
   phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
 
   T data;
+
+  node_backup<node_type> backup;
+  node_undo_log<node_type> undo_log;
+
+  /*! \brief Starts saving nodes before they are modified.
+   *
+   * Nodes, inputs, and outputs created afterwards are removed when the
+   * backup is restored.
+   */
+  void start_backup()
+  {
+    assert( !backup.active );
+    backup.active = true;
+    backup.num_nodes = nodes.size();
+    backup.num_inputs = inputs.size();
+    backup.num_outputs = outputs.size();
+  }
+
+  /*! \brief Saves a node that is about to be modified, if a backup is active or a transaction is open. */
+  void backup_node( uint64_t index )
+  {
+    if ( backup.active && index < backup.num_nodes )
+    {
+      save_node( index );
+    }
+    if ( !undo_log.transactions.empty() && index < undo_log.transactions.back().num_nodes )
+    {
+      log_node( index );
+    }
+  }
+
+  /*! \brief Saves an output that is about to be redirected, if a backup is active or a transaction is open. */
+  void backup_output( typename node_type::pointer_type const& output )
+  {
+    auto const index = static_cast<uint64_t>( &output - outputs.data() );
+    if ( backup.active && !backup.outputs_saved )
+    {
+      backup.outputs_saved = true;
+      backup.outputs.assign( outputs.begin(), outputs.begin() + backup.num_outputs );
+    }
+    if ( !undo_log.transactions.empty() && index < undo_log.transactions.back().num_outputs )
+    {
+      undo_log.output_entries.push_back( { index, output } );
+    }
+  }
+
+  /*! \brief Restores the saved nodes, the hash table, inputs, and outputs, and stops the backup. */
+  void restore_backup()
+  {
+    assert( backup.active );
+
+    /* remove the hash table entries of modified and created nodes */
+    auto const erase_entry = [&]( uint64_t index ) {
+      if ( auto const it = hash.find( nodes[index] ); it != hash.end() && it->second == index )
+      {
+        hash.erase( it );
+      }
+    };
+    for ( auto const& c : backup.chunks )
+    {
+      for ( auto i = 0u; i < c.nodes.size(); ++i )
+      {
+        if ( c.states[i] != node_backup<node_type>::unmodified )
+        {
+          erase_entry( c.first + i );
+        }
+      }
+    }
+    for ( auto index = backup.num_nodes; index < nodes.size(); ++index )
+    {
+      erase_entry( index );
+    }
+    nodes.erase( nodes.begin() + backup.num_nodes, nodes.end() );
+
+    for ( auto& c : backup.chunks )
+    {
+      for ( auto i = 0u; i < c.nodes.size(); ++i )
+      {
+        if ( c.states[i] == node_backup<node_type>::unmodified )
+        {
+          continue;
+        }
+        nodes[c.first + i] = std::move( c.nodes[i] );
+        if ( c.states[i] == node_backup<node_type>::modified_hashed )
+        {
+          hash[nodes[c.first + i]] = c.first + i;
+        }
+      }
+    }
+
+    inputs.erase( inputs.begin() + backup.num_inputs, inputs.end() );
+    if ( backup.outputs_saved )
+    {
+      outputs = std::move( backup.outputs );
+    }
+    else
+    {
+      outputs.erase( outputs.begin() + backup.num_outputs, outputs.end() );
+    }
+
+    backup.clear();
+  }
+
+  /*! \brief Stops the backup and keeps all modifications. */
+  void stop_backup()
+  {
+    backup.clear();
+  }
+
+  /*! \brief Opens a (nested) transaction. */
+  void begin_transaction()
+  {
+    undo_log.transactions.push_back( { nodes.size(), inputs.size(), outputs.size(), undo_log.node_entries.size(), undo_log.output_entries.size() } );
+  }
+
+  /*! \brief Closes the innermost transaction and keeps its modifications. */
+  void commit_transaction()
+  {
+    assert( !undo_log.transactions.empty() );
+    undo_log.transactions.pop_back();
+
+    /* the modifications only need to be kept for enclosing transactions */
+    if ( undo_log.transactions.empty() )
+    {
+      undo_log.node_entries.clear();
+      undo_log.output_entries.clear();
+    }
+  }
+
+  /*! \brief Closes the innermost transaction and undoes its modifications. */
+  void rollback_transaction()
+  {
+    assert( !undo_log.transactions.empty() );
+    auto const t = undo_log.transactions.back();
+    undo_log.transactions.pop_back();
+
+    auto const erase_entry = [&]( uint64_t index ) {
+      if ( auto const it = hash.find( nodes[index] ); it != hash.end() && it->second == index )
+      {
+        hash.erase( it );
+      }
+    };
+
+    /* restore the nodes in reverse order, such that each ends up with its content at the start */
+    while ( undo_log.node_entries.size() > t.num_node_entries )
+    {
+      auto& entry = undo_log.node_entries.back();
+      erase_entry( entry.index );
+      nodes[entry.index] = std::move( entry.node );
+      if ( entry.hashed )
+      {
+        hash[nodes[entry.index]] = entry.index;
+      }
+      undo_log.node_entries.pop_back();
+    }
+    for ( auto index = t.num_nodes; index < nodes.size(); ++index )
+    {
+      erase_entry( index );
+    }
+    nodes.erase( nodes.begin() + t.num_nodes, nodes.end() );
+
+    while ( undo_log.output_entries.size() > t.num_output_entries )
+    {
+      auto const& entry = undo_log.output_entries.back();
+      outputs[entry.index] = entry.output;
+      undo_log.output_entries.pop_back();
+    }
+    inputs.erase( inputs.begin() + t.num_inputs, inputs.end() );
+    outputs.erase( outputs.begin() + t.num_outputs, outputs.end() );
+  }
+
+private:
+  void log_node( uint64_t index )
+  {
+    auto const it = hash.find( nodes[index] );
+    undo_log.node_entries.push_back( { index, nodes[index], it != hash.end() && it->second == index } );
+  }
+
+  void save_node( uint64_t index )
+  {
+    if ( backup.chunk_slots.empty() )
+    {
+      backup.chunk_slots.resize( ( backup.num_nodes >> node_backup<node_type>::chunk_bits ) + 1u, 0u );
+    }
+
+    /* copy the chunk the first time one of its nodes is modified */
+    auto const c = index >> node_backup<node_type>::chunk_bits;
+    auto const first = c << node_backup<node_type>::chunk_bits;
+    if ( backup.chunk_slots[c] == 0u )
+    {
+      backup.chunk_slots[c] = static_cast<uint32_t>( backup.chunks.size() + 1u );
+      auto const last = std::min( first + node_backup<node_type>::chunk_size, backup.num_nodes );
+      auto& saved = backup.chunks.emplace_back();
+      saved.first = first;
+      saved.nodes.assign( nodes.begin() + first, nodes.begin() + last );
+      saved.states.resize( last - first, node_backup<node_type>::unmodified );
+    }
+
+    auto& state = backup.chunks[backup.chunk_slots[c] - 1u].states[index - first];
+    if ( state == node_backup<node_type>::unmodified )
+    {
+      auto const it = hash.find( nodes[index] );
+      state = it != hash.end() && it->second == index ? node_backup<node_type>::modified_hashed : node_backup<node_type>::modified;
+    }
+  }
 };
 
 template<typename Node, typename T = empty_storage_data>
@@ -195,6 +195,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
+    _storage->backup_node( f.index );
     _storage->nodes[f.index].data[0].h1++;
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
@@ -304,8 +305,11 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
+    _storage->backup_node( a.index );
     _storage->nodes[a.index].data[0].h1++;
+    _storage->backup_node( b.index );
     _storage->nodes[b.index].data[0].h1++;
+    _storage->backup_node( c.index );
     _storage->nodes[c.index].data[0].h1++;
 
     for ( auto const& fn : _events->on_add )
@@ -371,8 +375,11 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
+    _storage->backup_node( a.index );
     _storage->nodes[a.index].data[0].h1++;
+    _storage->backup_node( b.index );
     _storage->nodes[b.index].data[0].h1++;
+    _storage->backup_node( c.index );
     _storage->nodes[c.index].data[0].h1++;
 
     for ( auto const& fn : _events->on_add )
@@ -705,6 +712,7 @@ public:
     const auto old_child2 = signal{ node.children[2] };
 
     // erase old node in hash table
+    _storage->backup_node( n );
     _storage->hash.erase( node );
 
     // insert updated node into hash table
@@ -714,6 +722,7 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
+    _storage->backup_node( new_signal.index );
     _storage->nodes[new_signal.index].data[0].h1++;
 
     for ( auto const& fn : _events->on_modified )
@@ -836,6 +845,7 @@ public:
     const auto old_child2 = signal{ node.children[2] };
 
     // erase old node in hash table
+    _storage->backup_node( n );
     _storage->hash.erase( node );
 
     // insert updated node into hash table
@@ -848,6 +858,7 @@ public:
     }
 
     // update the reference counter of the new signal
+    _storage->backup_node( new_signal.index );
     _storage->nodes[new_signal.index].data[0].h1++;
 
     for ( auto const& fn : _events->on_modified )
@@ -865,12 +876,14 @@ public:
     {
       if ( output.index == old_node )
       {
+        _storage->backup_output( output );
         output.index = new_signal.index;
         output.weight ^= new_signal.complement;
 
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
+          _storage->backup_node( new_signal.index );
           _storage->nodes[new_signal.index].data[0].h1++;
         }
       }
@@ -884,6 +897,7 @@ public:
       return;
 
     auto& nobj = _storage->nodes[n];
+    _storage->backup_node( n );
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
@@ -912,6 +926,7 @@ public:
 
     assert( n < _storage->nodes.size() );
     auto& nobj = _storage->nodes[n];
+    _storage->backup_node( n );
     nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
 
@@ -1058,11 +1073,13 @@ public:
 
   uint32_t incr_fanout_size( node const& n ) const
   {
+    _storage->backup_node( n );
     return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
+    _storage->backup_node( n );
     return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
   }
 
@@ -0,0 +1,607 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file choice_classes.hpp
+  \brief Compact equivalence classes of structural choices
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Structural choices of a network stored in flat arrays.
+ *
+ * Contrary to `choice_view`, which links the nodes of an equivalence class
+ * through per-node vectors and modifies the network, this class keeps the
+ * choices next to an unmodified network: the members of all classes are
+ * stored contiguously, one class after the other, and each node stores its
+ * representative together with its phase in a single literal.  The
+ * representative of a class is its member with the smallest index.
+ *
+ * The classes are built from equivalences between nodes and signals, e.g.,
+ * the ones proven by `functional_choices`.  Members can be dead nodes (that
+ * have been substituted by an equivalent node), whose structure is kept in
+ * the storage of the network.  Constants and combinational inputs are never
+ * members of classes.  A member is only added to a class if this does not
+ * create a cycle in the choice network, in which each node depends on the
+ * representatives of its fanins and each representative on the other
+ * members of its class.  Cycles are detected with a search that is bounded
+ * by the levels of the nodes in the choice network, which are updated while
+ * members are added.
+ *
+ * The class precomputes a topological order of the choice network, which
+ * contains all live nodes and all members of classes (together with their
+ * transitive fanins), in which the members of a class precede its
+ * representative.
+ *
+ * The classes are consumed by `choice_cut_enumeration`; the mappers do not
+ * use them yet (the multi-output matching of `emap` groups gates with
+ * `choice_view`, which is unrelated to structural choices).
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `is_complemented`
+ * - `is_constant`
+ * - `is_ci`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `foreach_node`
+ * - `foreach_co`
+ * - `foreach_fanin`
+ */
+template<class Ntk>
+class choice_classes
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr uint32_t no_class = std::numeric_limits<uint32_t>::max();
+
+public:
+  /*! \brief Builds the classes from equivalences.
+   *
+   * \param ntk Network
+   * \param equivalences Pairs of a node and a signal with the same function
+   */
+  choice_classes( Ntk const& ntk, std::vector<std::pair<node, signal>> const& equivalences )
+      : _ntk( &ntk ),
+        _repr( ntk.size() ),
+        _class_of( ntk.size(), no_class )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+
+    for ( auto i = 0u; i < _repr.size(); ++i )
+    {
+      _repr[i] = i << 1;
+    }
+    build_classes( equivalences );
+    compute_topological_order();
+  }
+
+  /*! \brief Representative of the class of node `n` (`n` itself if it has no class). */
+  node representative( node const& n ) const
+  {
+    return _ntk->index_to_node( _repr[_ntk->node_to_index( n )] >> 1 );
+  }
+
+  /*! \brief Whether node `n` is the complement of its representative. */
+  bool phase( node const& n ) const
+  {
+    return _repr[_ntk->node_to_index( n )] & 1;
+  }
+
+  /*! \brief Whether node `n` is its own representative. */
+  bool is_representative( node const& n ) const
+  {
+    auto const index = _ntk->node_to_index( n );
+    return ( _repr[index] >> 1 ) == index;
+  }
+
+  /*! \brief Whether node `n` is the representative of a class with other members. */
+  bool has_choices( node const& n ) const
+  {
+    auto const index = _ntk->node_to_index( n );
+    return _class_of[index] != no_class && ( _repr[index] >> 1 ) == index;
+  }
+
+  /*! \brief Calls `fn( node, phase )` on the members of the class of `n`, starting with its representative. */
+  template<typename Fn>
+  void foreach_choice( node const& n, Fn&& fn ) const
+  {
+    auto const index = _ntk->node_to_index( n );
+    auto const c = _class_of[index];
+    if ( c == no_class )
+    {
+      fn( n, false );
+      return;
+    }
+    for ( auto i = _offsets[c]; i < _offsets[c + 1]; ++i )
+    {
+      fn( _ntk->index_to_node( _members[i] >> 1 ), static_cast<bool>( _members[i] & 1 ) );
+    }
+  }
+
+  /*! \brief Number of classes with at least two members. */
+  uint32_t num_classes() const
+  {
+    return static_cast<uint32_t>( _offsets.size() - 1u );
+  }
+
+  /*! \brief Number of members that are not representatives. */
+  uint32_t num_choices() const
+  {
+    return static_cast<uint32_t>( _members.size() - num_classes() );
+  }
+
+  /*! \brief Number of equivalences that were not added, as they would create cycles or contradict others. */
+  uint32_t num_rejected() const
+  {
+    return _num_rejected;
+  }
+
+  /*! \brief Topological order of the choice network. */
+  std::vector<node> const& topological_order() const
+  {
+    return _topo_order;
+  }
+
+private:
+  uint32_t find( uint32_t index, bool& parity )
+  {
+    parity = false;
+    auto root = index;
+    while ( _parent[root] != root )
+    {
+      parity ^= static_cast<bool>( _parity[root] );
+      root = _parent[root];
+    }
+
+    /* path compression */
+    auto p = parity;
+    while ( _parent[index] != root )
+    {
+      auto const next = _parent[index];
+      auto const next_parity = p ^ static_cast<bool>( _parity[index] );
+      _parent[index] = root;
+      _parity[index] = p;
+      index = next;
+      p = next_parity;
+    }
+    return root;
+  }
+
+  void build_classes( std::vector<std::pair<node, signal>> const& equivalences )
+  {
+    auto const size = static_cast<uint32_t>( _repr.size() );
+
+    /* union-find with the phases relative to the roots */
+    _parent.resize( size );
+    _parity.assign( size, 0u );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      _parent[i] = i;
+    }
+    for ( auto const& [n, f] : equivalences )
+    {
+      bool pa, pb;
+      auto const a = find( static_cast<uint32_t>( _ntk->node_to_index( n ) ), pa );
+      auto const b = find( static_cast<uint32_t>( _ntk->node_to_index( _ntk->get_node( f ) ) ), pb );
+      bool const p = pa ^ pb ^ _ntk->is_complemented( f );
+      if ( a == b )
+      {
+        _num_rejected += p ? 1u : 0u; /* inconsistent phases */
+        continue;
+      }
+      _parent[b] = a;
+      _parity[b] = p;
+    }
+
+    /* bucket the members of each set by increasing index */
+    std::vector<uint32_t> set_size( size, 0u );
+    std::vector<bool> parities( size );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      bool p;
+      _parent[i] = find( i, p );
+      parities[i] = p;
+      auto const n = _ntk->index_to_node( i );
+      if ( !_ntk->is_constant( n ) && !_ntk->is_ci( n ) )
+      {
+        ++set_size[_parent[i]];
+      }
+    }
+    std::vector<uint32_t> set_begin( size + 1u, 0u );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      set_begin[i + 1u] = set_begin[i] + ( set_size[i] > 1u ? set_size[i] : 0u );
+    }
+    std::vector<uint32_t> sets( set_begin[size] );
+    std::vector<uint32_t> set_pos( set_begin.begin(), set_begin.end() - 1 );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      auto const n = _ntk->index_to_node( i );
+      if ( set_size[_parent[i]] > 1u && !_ntk->is_constant( n ) && !_ntk->is_ci( n ) )
+      {
+        sets[set_pos[_parent[i]]++] = i;
+      }
+    }
+    _parent.clear();
+    _parent.shrink_to_fit();
+    _parity.clear();
+    _parity.shrink_to_fit();
+
+    /* admit the members one by one, as long as the choice network stays acyclic */
+    compute_fanouts();
+    compute_levels();
+    _visited.assign( size, 0u );
+    _offsets.push_back( 0u );
+    for ( auto s = 0u; s < size; ++s )
+    {
+      if ( set_begin[s + 1u] == set_begin[s] )
+      {
+        continue;
+      }
+
+      auto const repr = sets[set_begin[s]];
+      auto const c = num_classes();
+      _class_of[repr] = c;
+      _members.push_back( repr << 1 );
+
+      for ( auto j = set_begin[s] + 1u; j < set_begin[s + 1u]; ++j )
+      {
+        /* only the node with the higher level can reach the other one */
+        auto const m = sets[j];
+        if ( _level[m] > _level[repr] ? reaches( m, repr ) : reaches( repr, m ) )
+        {
+          ++_num_rejected;
+          continue;
+        }
+        _class_of[m] = c;
+        _repr[m] = ( repr << 1 ) | static_cast<uint32_t>( parities[m] ^ parities[repr] );
+        _members.push_back( ( m << 1 ) | ( _repr[m] & 1u ) );
+
+        /* the representative now depends on `m`, and the fanouts of `m` on the representative */
+        raise_level( repr, _level[m] + 1u );
+        for ( auto i = _fanout_offsets[m]; i < _fanout_offsets[m + 1u]; ++i )
+        {
+          raise_level( _fanouts[i], _level[repr] + 1u );
+        }
+      }
+
+      if ( _members.size() - _offsets.back() == 1u )
+      {
+        _members.pop_back();
+        _class_of[repr] = no_class;
+      }
+      else
+      {
+        _offsets.push_back( static_cast<uint32_t>( _members.size() ) );
+      }
+    }
+
+    _level.clear();
+    _level.shrink_to_fit();
+    _fanout_offsets.clear();
+    _fanout_offsets.shrink_to_fit();
+    _fanouts.clear();
+    _fanouts.shrink_to_fit();
+  }
+
+  /* structural fanouts of all nodes in compressed rows */
+  void compute_fanouts()
+  {
+    auto const size = static_cast<uint32_t>( _repr.size() );
+    _fanout_offsets.assign( size + 1u, 0u );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      foreach_structural_fanin( i, [&]( uint32_t fanin ) {
+        ++_fanout_offsets[fanin + 1u];
+      } );
+    }
+    for ( auto i = 0u; i < size; ++i )
+    {
+      _fanout_offsets[i + 1u] += _fanout_offsets[i];
+    }
+    _fanouts.resize( _fanout_offsets[size] );
+    std::vector<uint32_t> pos( _fanout_offsets.begin(), _fanout_offsets.end() - 1 );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      foreach_structural_fanin( i, [&]( uint32_t fanin ) {
+        _fanouts[pos[fanin]++] = i;
+      } );
+    }
+  }
+
+  /* levels of the choice network without classes, i.e., of the storage of the network */
+  void compute_levels()
+  {
+    auto const size = static_cast<uint32_t>( _repr.size() );
+    _level.assign( size, 0u );
+    _visited.assign( size, 0u );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      post_order( i, [&]( uint32_t index ) {
+        foreach_dependency( index, [&]( uint32_t next ) {
+          _level[index] = std::max( _level[index], _level[next] + 1u );
+        } );
+      } );
+    }
+  }
+
+  /* raises the level of a node to at least `level` and updates the nodes that depend on it */
+  void raise_level( uint32_t index, uint32_t level )
+  {
+    if ( _level[index] >= level )
+    {
+      return;
+    }
+    _level[index] = level;
+    _stack.clear();
+    _stack.push_back( index );
+    while ( !_stack.empty() )
+    {
+      auto const next = _stack.back();
+      _stack.pop_back();
+      foreach_dependent( next, [&]( uint32_t dependent ) {
+        if ( _level[dependent] <= _level[next] )
+        {
+          _level[dependent] = _level[next] + 1u;
+          _stack.push_back( dependent );
+        }
+      } );
+    }
+  }
+
+  template<typename Fn>
+  void foreach_structural_fanin( uint32_t index, Fn&& fn ) const
+  {
+    auto const n = _ntk->index_to_node( index );
+    if ( _ntk->is_constant( n ) || _ntk->is_ci( n ) )
+    {
+      return;
+    }
+    _ntk->foreach_fanin( n, [&]( auto const& f ) {
+      fn( static_cast<uint32_t>( _ntk->node_to_index( _ntk->get_node( f ) ) ) );
+    } );
+  }
+
+  /* calls `fn` on the successors of a node in the choice network */
+  template<typename Fn>
+  void foreach_dependency( uint32_t index, Fn&& fn ) const
+  {
+    auto const n = _ntk->index_to_node( index );
+    if ( _ntk->is_constant( n ) || _ntk->is_ci( n ) )
+    {
+      return;
+    }
+    _ntk->foreach_fanin( n, [&]( auto const& f ) {
+      fn( _repr[_ntk->node_to_index( _ntk->get_node( f ) )] >> 1 );
+    } );
+
+    auto const c = _class_of[index];
+    if ( c != no_class && ( _repr[index] >> 1 ) == index )
+    {
+      /* the last class may still be under construction */
+      auto const end = c + 1u < _offsets.size() ? _offsets[c + 1u] : static_cast<uint32_t>( _members.size() );
+      for ( auto i = _offsets[c] + 1u; i < end; ++i )
+      {
+        fn( _members[i] >> 1 );
+      }
+    }
+  }
+
+  /* calls `fn` on the predecessors of a node in the choice network (during construction) */
+  template<typename Fn>
+  void foreach_dependent( uint32_t index, Fn&& fn ) const
+  {
+    auto const repr = _repr[index] >> 1;
+    if ( repr != index )
+    {
+      fn( repr );
+      return;
+    }
+
+    auto const c = _class_of[index];
+    if ( c == no_class )
+    {
+      for ( auto i = _fanout_offsets[index]; i < _fanout_offsets[index + 1u]; ++i )
+      {
+        fn( _fanouts[i] );
+      }
+      return;
+    }
+
+    /* the last class may still be under construction */
+    auto const end = c + 1u < _offsets.size() ? _offsets[c + 1u] : static_cast<uint32_t>( _members.size() );
+    for ( auto j = _offsets[c]; j < end; ++j )
+    {
+      auto const m = _members[j] >> 1;
+      for ( auto i = _fanout_offsets[m]; i < _fanout_offsets[m + 1u]; ++i )
+      {
+        fn( _fanouts[i] );
+      }
+    }
+  }
+
+  /* whether `to` is in the transitive fanin of `from`; only nodes with a higher level than `to` are explored */
+  bool reaches( uint32_t from, uint32_t to )
+  {
+    if ( _level[from] <= _level[to] )
+    {
+      return false;
+    }
+
+    ++_trav_id;
+    _visited[from] = _trav_id;
+    _stack.clear();
+    _stack.push_back( from );
+    while ( !_stack.empty() )
+    {
+      auto const index = _stack.back();
+      _stack.pop_back();
+
+      bool found = false;
+      foreach_dependency( index, [&]( uint32_t next ) {
+        if ( next == to )
+        {
+          found = true;
+        }
+        else if ( _visited[next] != _trav_id && _level[next] > _level[to] )
+        {
+          _visited[next] = _trav_id;
+          _stack.push_back( next );
+        }
+      } );
+      if ( found )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* iterative post-order traversal of the choice network from `root`, in which
+   * `_visited` is 0 for new nodes, 1 for nodes on the stack, and 2 for done nodes */
+  template<typename Fn>
+  void post_order( uint32_t root, Fn&& fn )
+  {
+    if ( _visited[root] != 0u )
+    {
+      return;
+    }
+
+    auto const push = [&]( uint32_t index ) {
+      _visited[index] = 1u;
+      auto const begin = static_cast<uint32_t>( _successors.size() );
+      foreach_dependency( index, [&]( uint32_t next ) {
+        _successors.push_back( next );
+      } );
+      _frames.push_back( index );
+      _frames.push_back( begin );
+      _frames.push_back( static_cast<uint32_t>( _successors.size() ) );
+    };
+
+    push( root );
+    while ( !_frames.empty() )
+    {
+      auto const top = _frames.size() - 3u;
+      if ( _frames[top + 1u] < _frames[top + 2u] )
+      {
+        auto const next = _successors[_frames[top + 1u]++];
+        assert( _visited[next] != 1u && "choice network is cyclic" );
+        if ( _visited[next] == 0u )
+        {
+          push( next );
+        }
+        continue;
+      }
+
+      _visited[_frames[top]] = 2u;
+      fn( _frames[top] );
+      _successors.resize( top == 0u ? 0u : _frames[top - 1u] ); /* end of the successors of the parent */
+      _frames.resize( top );
+    }
+  }
+
+  void compute_topological_order()
+  {
+    _visited.assign( _repr.size(), 0u );
+    auto const visit = [&]( uint32_t root ) {
+      post_order( root, [&]( uint32_t index ) {
+        _topo_order.push_back( _ntk->index_to_node( index ) );
+      } );
+    };
+
+    _ntk->foreach_node( [&]( auto const& n ) {
+      visit( static_cast<uint32_t>( _repr[_ntk->node_to_index( n )] >> 1 ) );
+    } );
+    for ( auto c = 0u; c < num_classes(); ++c )
+    {
+      visit( _members[_offsets[c]] >> 1 );
+    }
+    _ntk->foreach_co( [&]( auto const& f ) {
+      visit( static_cast<uint32_t>( _repr[_ntk->node_to_index( _ntk->get_node( f ) )] >> 1 ) );
+    } );
+
+    _visited.clear();
+    _visited.shrink_to_fit();
+    _stack.clear();
+    _stack.shrink_to_fit();
+    _frames.clear();
+    _frames.shrink_to_fit();
+    _successors.clear();
+    _successors.shrink_to_fit();
+  }
+
+private:
+  Ntk const* _ntk;
+
+  /* representative literal (index and phase) of each node */
+  std::vector<uint32_t> _repr;
+  /* class of each member */
+  std::vector<uint32_t> _class_of;
+  /* literals of the members of all classes, relative to their representatives */
+  std::vector<uint32_t> _members;
+  std::vector<uint32_t> _offsets;
+  std::vector<node> _topo_order;
+  uint32_t _num_rejected{ 0u };
+
+  /* temporary data during construction */
+  std::vector<uint32_t> _parent;
+  std::vector<uint8_t> _parity;
+  std::vector<uint32_t> _visited;
+  std::vector<uint32_t> _stack;
+  std::vector<uint32_t> _frames; /* node index, begin and end of its successors */
+  std::vector<uint32_t> _successors;
+  std::vector<uint32_t> _level;
+  std::vector<uint32_t> _fanout_offsets;
+  std::vector<uint32_t> _fanouts;
+  uint32_t _trav_id{ 0u };
+};
+
+} // namespace mockturtle
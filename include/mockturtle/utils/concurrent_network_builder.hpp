@@ -0,0 +1,524 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file concurrent_network_builder.hpp
+  \brief Concurrent construction of structurally hashed networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
+#include "../networks/aig.hpp"
+#include "../networks/mig.hpp"
+#include "../networks/xag.hpp"
+#include "../networks/xmg.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Whether gates of a network type can be created with `concurrent_network_builder`. */
+template<class Ntk>
+inline constexpr bool has_concurrent_network_builder_v = std::is_same_v<Ntk, aig_network> || std::is_same_v<Ntk, xag_network> ||
+                                                         std::is_same_v<Ntk, mig_network> || std::is_same_v<Ntk, xmg_network>;
+
+/*! \brief Concurrent structural hashing for AIGs, XAGs, MIGs, and XMGs.
+ *
+ * Allows several threads to create gates of the same network at the same
+ * time, e.g., to build disjoint cones in parallel.  The builder is attached
+ * to a network, whose existing nodes (constants, PIs, and gates) can be used
+ * as fanins of new gates.  New gates are structurally hashed against the
+ * gates of the network and against each other using a sharded hash table,
+ * and are stored in append-only segments of doubling size, the first of
+ * which holds the expected number of new gates; hence, all `create_*`
+ * methods are thread-safe.  The gates are normalized exactly as in the
+ * network, and the returned signals are the signals the gates will have in
+ * the network.
+ *
+ * The new gates are added to the network (in the order they were created)
+ * when `commit` is called, which must be done by a single thread once all
+ * threads have finished.  The network must not be modified between the
+ * construction of the builder and `commit`, and PIs must be created before.
+ * Signals created by one thread can be passed to other threads, provided
+ * that this is done with proper synchronization (e.g., after joining).
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig;
+      std::vector<aig_network::signal> pis( 64u );
+      std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+
+      concurrent_network_builder builder( aig );
+      std::vector<aig_network::signal> outputs( 8u );
+      parallel_for( 4u, outputs.size(), [&]( uint64_t index, uint32_t ) {
+        outputs[index] = build_cone( builder, pis, index );
+      } );
+      builder.commit();
+
+      for ( auto const& f : outputs )
+      {
+        aig.create_po( f );
+      }
+   \endverbatim
+ */
+template<class Ntk>
+class concurrent_network_builder
+{
+public:
+  using signal = typename Ntk::signal;
+  using storage_type = typename Ntk::storage::element_type;
+  using node_type = typename storage_type::node_type;
+  using hasher = typename decltype( storage_type::hash )::hasher;
+
+  static constexpr bool is_aig = std::is_same_v<Ntk, aig_network>;
+  static constexpr bool is_xag = std::is_same_v<Ntk, xag_network>;
+  static constexpr bool is_mig = std::is_same_v<Ntk, mig_network>;
+  static constexpr bool is_xmg = std::is_same_v<Ntk, xmg_network>;
+
+  static_assert( has_concurrent_network_builder_v<Ntk>, "Ntk must be aig_network, xag_network, mig_network, or xmg_network" );
+
+  /* segment `k` holds `2^(segment_bits + k)` nodes */
+  static constexpr uint32_t min_segment_bits = 10u;
+  static constexpr uint32_t max_segment_bits = 24u;
+  static constexpr uint32_t max_segments = 40u;
+
+public:
+  /*! \brief Constructor.
+   *
+   * \param ntk Network to which the gates are added
+   * \param expected_num_gates Expected number of new gates, used to size the first segment and the hash table
+   */
+  explicit concurrent_network_builder( Ntk& ntk, uint64_t expected_num_gates = 0u )
+      : _ntk( ntk ),
+        _base_size( ntk.size() ),
+        _segment_bits( min_segment_bits )
+  {
+    while ( _segment_bits < max_segment_bits && ( uint64_t( 1 ) << _segment_bits ) < expected_num_gates )
+    {
+      ++_segment_bits;
+    }
+    for ( auto& segment : _segments )
+    {
+      segment.store( nullptr, std::memory_order_relaxed );
+    }
+    _hash.reserve( expected_num_gates );
+  }
+
+  ~concurrent_network_builder()
+  {
+    release_segments();
+  }
+
+  concurrent_network_builder( concurrent_network_builder const& ) = delete;
+  concurrent_network_builder& operator=( concurrent_network_builder const& ) = delete;
+
+  signal get_constant( bool value ) const
+  {
+    return _ntk.get_constant( value );
+  }
+
+  /*! \brief Returns the number of gates that have not been committed yet. */
+  uint64_t num_new_gates() const
+  {
+    return _num_nodes.load();
+  }
+
+#pragma region Create binary functions
+  signal create_and( signal a, signal b )
+  {
+    if constexpr ( is_mig || is_xmg )
+    {
+      return create_maj( get_constant( false ), a, b );
+    }
+    else
+    {
+      /* order inputs (a < b for AND gates) */
+      if ( a.index > b.index )
+      {
+        std::swap( a, b );
+      }
+
+      /* trivial cases */
+      if ( a.index == b.index )
+      {
+        return ( a.complement == b.complement ) ? a : get_constant( false );
+      }
+      else if ( a.index == 0 )
+      {
+        return a.complement ? b : get_constant( false );
+      }
+
+      node_type node;
+      node.children[0] = a;
+      node.children[1] = b;
+      return create_node( node, false );
+    }
+  }
+
+  signal create_nand( signal const& a, signal const& b )
+  {
+    return !create_and( a, b );
+  }
+
+  signal create_or( signal const& a, signal const& b )
+  {
+    if constexpr ( is_mig || is_xmg )
+    {
+      return create_maj( get_constant( true ), a, b );
+    }
+    else
+    {
+      return !create_and( !a, !b );
+    }
+  }
+
+  signal create_nor( signal const& a, signal const& b )
+  {
+    return !create_or( a, b );
+  }
+
+  signal create_lt( signal const& a, signal const& b )
+  {
+    return create_and( !a, b );
+  }
+
+  signal create_le( signal const& a, signal const& b )
+  {
+    return !create_and( a, !b );
+  }
+
+  signal create_xor( signal a, signal b )
+  {
+    if constexpr ( is_xag )
+    {
+      /* order inputs (a > b for XOR gates) */
+      if ( a.index < b.index )
+      {
+        std::swap( a, b );
+      }
+
+      bool const f_compl = a.complement != b.complement;
+      a.complement = b.complement = false;
+
+      /* trivial cases */
+      if ( a.index == b.index )
+      {
+        return get_constant( f_compl );
+      }
+      else if ( b.index == 0 )
+      {
+        return a ^ f_compl;
+      }
+
+      node_type node;
+      node.children[0] = a;
+      node.children[1] = b;
+      return create_node( node, f_compl );
+    }
+    else if constexpr ( is_xmg )
+    {
+      return create_xor3( get_constant( false ), a, b );
+    }
+    else
+    {
+      const auto fcompl = a.complement ^ b.complement;
+      const auto c1 = create_and( +a, -b );
+      const auto c2 = create_and( +b, -a );
+      return create_and( !c1, !c2 ) ^ !fcompl;
+    }
+  }
+
+  signal create_xnor( signal const& a, signal const& b )
+  {
+    return !create_xor( a, b );
+  }
+#pragma endregion
+
+#pragma region Create ternary functions
+  signal create_maj( signal a, signal b, signal c )
+  {
+    static_assert( is_mig || is_xmg, "create_maj is only supported for MIGs and XMGs" );
+
+    /* order inputs */
+    if ( a.index > b.index )
+    {
+      std::swap( a, b );
+    }
+    if ( b.index > c.index )
+    {
+      std::swap( b, c );
+    }
+    if ( a.index > b.index )
+    {
+      std::swap( a, b );
+    }
+
+    /* trivial cases */
+    if ( a.index == b.index )
+    {
+      return ( a.complement == b.complement ) ? a : c;
+    }
+    else if ( b.index == c.index )
+    {
+      return ( b.complement == c.complement ) ? b : a;
+    }
+
+    /* complemented edges minimization */
+    auto node_complement = false;
+    if ( static_cast<unsigned>( a.complement ) + static_cast<unsigned>( b.complement ) +
+             static_cast<unsigned>( c.complement ) >=
+         2u )
+    {
+      node_complement = true;
+      a.complement = !a.complement;
+      b.complement = !b.complement;
+      c.complement = !c.complement;
+    }
+
+    node_type node;
+    node.children[0] = a;
+    node.children[1] = b;
+    node.children[2] = c;
+    return create_node( node, node_complement );
+  }
+
+  signal create_xor3( signal a, signal b, signal c )
+  {
+    static_assert( is_xmg, "create_xor3 is only supported for XMGs" );
+
+    /* order inputs */
+    if ( a.index < b.index )
+    {
+      std::swap( a, b );
+    }
+    if ( b.index < c.index )
+    {
+      std::swap( b, c );
+    }
+    if ( a.index < b.index )
+    {
+      std::swap( a, b );
+    }
+
+    /* propagate complement edges */
+    bool const fcompl = ( a.complement != b.complement ) != c.complement;
+    a.complement = b.complement = c.complement = false;
+
+    /* trivial cases */
+    if ( a.index == b.index )
+    {
+      return c ^ fcompl;
+    }
+    else if ( b.index == c.index )
+    {
+      return a ^ fcompl;
+    }
+
+    node_type node;
+    node.children[0] = a;
+    node.children[1] = b;
+    node.children[2] = c;
+    return create_node( node, fcompl );
+  }
+#pragma endregion
+
+#pragma region Create nodes
+  /*! \brief Creates a gate with the same function as a gate of another network of the same type. */
+  signal clone_node( Ntk const& other, typename Ntk::node const& source, std::vector<signal> const& children )
+  {
+    if constexpr ( is_aig )
+    {
+      (void)other;
+      (void)source;
+      assert( children.size() == 2u );
+      return create_and( children[0u], children[1u] );
+    }
+    else if constexpr ( is_xag )
+    {
+      assert( children.size() == 2u );
+      return other.is_and( source ) ? create_and( children[0u], children[1u] ) : create_xor( children[0u], children[1u] );
+    }
+    else if constexpr ( is_mig )
+    {
+      (void)other;
+      (void)source;
+      assert( children.size() == 3u );
+      return create_maj( children[0u], children[1u], children[2u] );
+    }
+    else
+    {
+      assert( children.size() == 3u );
+      return other.is_maj( source ) ? create_maj( children[0u], children[1u], children[2u] ) : create_xor3( children[0u], children[1u], children[2u] );
+    }
+  }
+#pragma endregion
+
+  /*! \brief Adds the new gates to the network.
+   *
+   * Must be called by a single thread after all threads have finished.  The
+   * builder can be used again afterwards.
+   */
+  void commit()
+  {
+    auto& storage = *_ntk._storage;
+    assert( storage.nodes.size() == _base_size && "network has been modified during concurrent construction" );
+
+    auto const num_nodes = _num_nodes.load();
+    storage.nodes.reserve( storage.nodes.size() + num_nodes );
+    storage.hash.reserve( storage.hash.size() + num_nodes );
+
+    for ( uint64_t i = 0u; i < num_nodes; ++i )
+    {
+      auto const& node = entry( i );
+      auto const index = storage.nodes.size();
+      storage.nodes.push_back( node );
+      storage.hash[node] = index;
+
+      /* increase ref-count to children */
+      for ( auto const& c : node.children )
+      {
+        storage.nodes[c.index].data[0].h1++;
+      }
+
+      for ( auto const& fn : _ntk._events->on_add )
+      {
+        ( *fn )( index );
+      }
+    }
+
+    release_segments();
+    _hash.clear();
+    _num_nodes = 0u;
+    _base_size = storage.nodes.size();
+  }
+
+private:
+  signal create_node( node_type const& node, bool complement )
+  {
+    /* gates of the network (read-only during concurrent construction) */
+    if ( std::all_of( node.children.begin(), node.children.end(), [&]( auto const& c ) { return c.index < _base_size; } ) )
+    {
+      auto const& hash = _ntk._storage->hash;
+      if ( const auto it = hash.find( node ); it != hash.end() )
+      {
+        return signal( it->second, complement );
+      }
+    }
+
+    /* new gates */
+    uint64_t index{ 0u };
+    _hash.lazy_emplace_l(
+        node,
+        [&]( uint64_t const& value ) { index = value; },
+        [&]( auto const& ctor ) {
+          index = _base_size + append( node );
+          ctor( node, index );
+        } );
+    return signal( index, complement );
+  }
+
+  uint64_t append( node_type const& node )
+  {
+    auto const i = _num_nodes.fetch_add( 1u );
+    auto const [k, offset] = locate( i );
+    assert( k < max_segments && "too many nodes for concurrent construction" );
+
+    auto* segment = _segments[k].load( std::memory_order_acquire );
+    if ( segment == nullptr )
+    {
+      auto* new_segment = new node_type[uint64_t( 1 ) << ( _segment_bits + k )];
+      if ( _segments[k].compare_exchange_strong( segment, new_segment, std::memory_order_acq_rel ) )
+      {
+        segment = new_segment;
+      }
+      else
+      {
+        delete[] new_segment;
+      }
+    }
+
+    segment[offset] = node;
+    return i;
+  }
+
+  node_type const& entry( uint64_t i ) const
+  {
+    auto const [k, offset] = locate( i );
+    return _segments[k].load( std::memory_order_acquire )[offset];
+  }
+
+  /* returns the segment of the `i`-th new node and its offset in the segment */
+  std::pair<uint32_t, uint64_t> locate( uint64_t i ) const
+  {
+    auto q = ( i >> _segment_bits ) + 1u;
+    uint32_t k{ 0u };
+    while ( q >>= 1u )
+    {
+      ++k;
+    }
+    return { k, i - ( ( ( uint64_t( 1 ) << k ) - 1u ) << _segment_bits ) };
+  }
+
+  void release_segments()
+  {
+    for ( auto& segment : _segments )
+    {
+      delete[] segment.exchange( nullptr );
+    }
+  }
+
+private:
+  Ntk& _ntk;
+  uint64_t _base_size;
+
+  uint32_t _segment_bits;
+  std::array<std::atomic<node_type*>, max_segments> _segments;
+  std::atomic<uint64_t> _num_nodes{ 0u };
+
+  phmap::parallel_flat_hash_map<node_type, uint64_t, hasher,
+                                std::equal_to<node_type>,
+                                std::allocator<std::pair<const node_type, uint64_t>>,
+                                6, std::mutex>
+      _hash;
+};
+
+} // namespace mockturtle
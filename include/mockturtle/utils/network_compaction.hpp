@@ -0,0 +1,233 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file network_compaction.hpp
+  \brief In-place removal of dead nodes
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
+#include "node_map.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Relocation of the nodes of a network by `compact_nodes`.
+ *
+ * Maps the nodes and signals of the network before the compaction to the
+ * ones after it, and moves the values of node maps accordingly.
+ */
+template<class Ntk>
+class node_remapping
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr uint64_t removed = std::numeric_limits<uint64_t>::max();
+
+public:
+  node_remapping( Ntk const& ntk, std::vector<uint64_t> old_to_new, uint64_t num_removed )
+      : _ntk( &ntk ),
+        _old_to_new( std::move( old_to_new ) ),
+        _num_removed( num_removed )
+  {
+  }
+
+  /*! \brief Whether node `n` was removed. */
+  bool is_removed( node const& n ) const
+  {
+    return _old_to_new[_ntk->node_to_index( n )] == removed;
+  }
+
+  /*! \brief New node of the former node `n`, which must not be removed. */
+  node operator()( node const& n ) const
+  {
+    assert( !is_removed( n ) );
+    return _ntk->index_to_node( _old_to_new[_ntk->node_to_index( n )] );
+  }
+
+  /*! \brief New signal of the former signal `f`, whose node must not be removed. */
+  template<typename _Ntk = Ntk, typename = std::enable_if_t<!std::is_same_v<typename _Ntk::signal, typename _Ntk::node>>>
+  signal operator()( signal const& f ) const
+  {
+    auto const g = _ntk->make_signal( ( *this )( _ntk->get_node( f ) ) );
+    return _ntk->is_complemented( f ) ? !g : g;
+  }
+
+  /*! \brief Moves the values of node maps to the new node indices.
+   *
+   * The maps must have been created for the compacted network.  Values of
+   * removed nodes are discarded.
+   */
+  template<class... Maps>
+  void apply( Maps&... maps ) const
+  {
+    ( maps.remap( _old_to_new ), ... );
+  }
+
+  /*! \brief Number of removed nodes. */
+  uint64_t num_removed() const
+  {
+    return _num_removed;
+  }
+
+  /*! \brief New index of each former node index (`removed` for removed nodes). */
+  std::vector<uint64_t> const& old_to_new() const
+  {
+    return _old_to_new;
+  }
+
+private:
+  Ntk const* _ntk;
+  std::vector<uint64_t> _old_to_new;
+  uint64_t _num_removed;
+};
+
+/*! \brief Removes the dead nodes of a network in-place.
+ *
+ * Relocates the live nodes to the front of the node array, keeping their
+ * order (and hence the topological order), and rewrites the fanins of the
+ * gates, the inputs, the outputs, and the structural hash table.  Contrary
+ * to `cleanup_dangling`, the network is not rebuilt: dangling nodes are
+ * kept, and existing copies of the network and node maps remain attached
+ * to it.
+ *
+ * The returned remapping translates former nodes and signals, and moves
+ * the values of node maps.  Views that store data for nodes (e.g.,
+ * `fanout_view` or `depth_view`) must be updated afterwards, and no
+ * snapshot or transaction of the network may be open.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `is_constant`
+ * - `is_ci`
+ * - `is_dead`
+ * - `node_to_index`
+ * - `index_to_node`
+ *
+ * \param ntk Network, whose storage is compacted
+ * \return Remapping of the former nodes
+ */
+template<class Ntk>
+node_remapping<Ntk> compact_nodes( Ntk& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+
+  auto& storage = *ntk._storage;
+  assert( !storage.backup.active && storage.undo_log.transactions.empty() );
+
+  /* new indices (constants and CIs are never dead), and whether the fanins must be rewritten */
+  auto const num_old = storage.nodes.size();
+  std::vector<uint64_t> old_to_new( num_old, node_remapping<Ntk>::removed );
+  std::vector<bool> is_gate( num_old, false );
+  uint64_t num_new{ 0u };
+  for ( auto i = 0u; i < num_old; ++i )
+  {
+    auto const n = ntk.index_to_node( i );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+    {
+      old_to_new[i] = num_new++;
+    }
+    else if ( !ntk.is_dead( n ) )
+    {
+      old_to_new[i] = num_new++;
+      is_gate[i] = true;
+    }
+  }
+  if ( num_new == num_old )
+  {
+    return node_remapping<Ntk>( ntk, std::move( old_to_new ), num_old - num_new );
+  }
+
+  /* the keys of the hash table are the nodes themselves, so that it is rebuilt */
+  std::vector<bool> is_hashed( num_old, false );
+  for ( auto const& [key, index] : storage.hash )
+  {
+    (void)key;
+    is_hashed[index] = true;
+  }
+  storage.hash.clear();
+
+  for ( auto i = 0u; i < num_old; ++i )
+  {
+    auto const index = old_to_new[i];
+    if ( index == node_remapping<Ntk>::removed )
+    {
+      continue;
+    }
+    if ( index != i )
+    {
+      storage.nodes[index] = std::move( storage.nodes[i] );
+    }
+    if ( is_gate[i] )
+    {
+      for ( auto& child : storage.nodes[index].children )
+      {
+        assert( old_to_new[child.index] != node_remapping<Ntk>::removed );
+        child.index = old_to_new[child.index];
+      }
+    }
+  }
+  storage.nodes.erase( storage.nodes.begin() + num_new, storage.nodes.end() );
+
+  for ( auto& input : storage.inputs )
+  {
+    input = old_to_new[input];
+  }
+  for ( auto& output : storage.outputs )
+  {
+    assert( old_to_new[output.index] != node_remapping<Ntk>::removed );
+    output.index = old_to_new[output.index];
+  }
+
+  storage.hash.reserve( num_new );
+  for ( auto i = 0u; i < num_old; ++i )
+  {
+    if ( is_hashed[i] && old_to_new[i] != node_remapping<Ntk>::removed )
+    {
+      storage.hash[storage.nodes[old_to_new[i]]] = old_to_new[i];
+    }
+  }
+
+  return node_remapping<Ntk>( ntk, std::move( old_to_new ), num_old - num_new );
+}
+
+} // namespace mockturtle
@@ -0,0 +1,171 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file network_snapshot.hpp
+  \brief Copy-on-write snapshots of networks
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "../networks/aig.hpp"
+#include "../networks/mig.hpp"
+#include "../networks/xag.hpp"
+#include "../networks/xmg.hpp"
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Whether a network saves its nodes in the storage backup before modifying them. */
+template<class Ntk>
+struct has_node_backup : std::false_type
+{
+};
+
+template<>
+struct has_node_backup<aig_network> : std::true_type
+{
+};
+
+template<>
+struct has_node_backup<xag_network> : std::true_type
+{
+};
+
+template<>
+struct has_node_backup<mig_network> : std::true_type
+{
+};
+
+template<>
+struct has_node_backup<xmg_network> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_node_backup_v = has_node_backup<Ntk>::value;
+
+/*! \brief Copy-on-write snapshot of a network.
+ *
+ * Taking a snapshot takes constant time.  Afterwards, the network saves
+ * the chunks of nodes it modifies, the first time each of them is
+ * modified, and rolling back only restores these chunks, together with
+ * their entries in the structural hash table, and removes the nodes,
+ * inputs, and outputs created since the snapshot.  This makes it cheap to
+ * try an in-place optimization and to discard its result if it does not
+ * improve the network, instead of cloning the network for every attempt.
+ *
+ * The snapshot applies to the storage shared by all copies of the network
+ * (not to clones).  A network has at most one snapshot at a time; the
+ * modifications are kept if the snapshot is committed or destroyed
+ * without rolling back.  Rolling back does not emit network events, such
+ * that views that keep data for nodes (e.g., `fanout_view` or
+ * `depth_view`) must be updated or recreated afterwards.  The values and
+ * visited flags of nodes are not restored.
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+
+      network_snapshot snapshot{ aig };
+      const auto size_before = aig.num_gates();
+      aig_resubstitution( aig );
+      if ( aig.num_gates() >= size_before )
+      {
+        snapshot.rollback();
+      }
+   \endverbatim
+ */
+template<class Ntk>
+class network_snapshot
+{
+public:
+  explicit network_snapshot( Ntk const& ntk )
+      : _storage( ntk._storage )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_node_backup_v<typename Ntk::base_type>, "Ntk does not save its nodes before modifying them" );
+
+    _storage->start_backup();
+  }
+
+  network_snapshot( network_snapshot<Ntk> const& ) = delete;
+  network_snapshot<Ntk>& operator=( network_snapshot<Ntk> const& ) = delete;
+
+  ~network_snapshot()
+  {
+    if ( _active )
+    {
+      _storage->stop_backup();
+    }
+  }
+
+  /*! \brief Restores the network as it was when the snapshot was taken. */
+  void rollback()
+  {
+    assert( _active );
+    _storage->restore_backup();
+    _active = false;
+  }
+
+  /*! \brief Keeps all modifications since the snapshot was taken. */
+  void commit()
+  {
+    assert( _active );
+    _storage->stop_backup();
+    _active = false;
+  }
+
+  /*! \brief Whether the snapshot has neither been rolled back nor committed. */
+  bool is_active() const
+  {
+    return _active;
+  }
+
+  /*! \brief Number of chunks of nodes saved so far. */
+  uint64_t num_saved_chunks() const
+  {
+    return _storage->backup.chunks.size();
+  }
+
+private:
+  typename Ntk::storage _storage;
+  bool _active{ true };
+};
+
+template<class T>
+network_snapshot( T const& ) -> network_snapshot<T>;
+
+} // namespace mockturtle
@@ -34,7 +34,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <variant>
@@ -194,6 +197,34 @@ public:
     }
   }
 
+  /*! \brief Moves the values after the nodes of the network were relocated.
+   *
+   * Entry `i` of `old_to_new` is the new index of the node with index `i`,
+   * or `std::numeric_limits<uint64_t>::max()` if the node was removed.  The
+   * relocated nodes must keep their relative order, as in `compact_nodes`.
+   *
+   * \param old_to_new New index of each former node index
+   */
+  void remap( std::vector<uint64_t> const& old_to_new )
+  {
+    auto const num_old = std::min<uint64_t>( data->size(), old_to_new.size() );
+    uint64_t num_new{ 0u };
+    for ( auto i = 0u; i < num_old; ++i )
+    {
+      if ( old_to_new[i] == std::numeric_limits<uint64_t>::max() )
+      {
+        continue;
+      }
+      assert( old_to_new[i] == num_new );
+      if ( old_to_new[i] != i )
+      {
+        ( *data )[old_to_new[i]] = std::move( ( *data )[i] );
+      }
+      ++num_new;
+    }
+    data->erase( data->begin() + num_new, data->end() );
+  }
+
 private:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -330,6 +361,28 @@ public:
   {
   }
 
+  /*! \brief Moves the values after the nodes of the network were relocated.
+   *
+   * Entry `i` of `old_to_new` is the new index of the node with index `i`,
+   * or `std::numeric_limits<uint64_t>::max()` if the node was removed.
+   *
+   * \param old_to_new New index of each former node index
+   */
+  void remap( std::vector<uint64_t> const& old_to_new )
+  {
+    container_type remapped;
+    remapped.reserve( data->size() );
+    for ( auto& [key, value] : *data )
+    {
+      auto const index = ntk->node_to_index( key );
+      if ( index < old_to_new.size() && old_to_new[index] != std::numeric_limits<uint64_t>::max() )
+      {
+        remapped.emplace( ntk->index_to_node( old_to_new[index] ), std::move( value ) );
+      }
+    }
+    *data = std::move( remapped );
+  }
+
 protected:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -0,0 +1,355 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file parallel_utils.hpp
+  \brief Utilities to run independent tasks on multiple threads
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+#include "node_map.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Returns the number of threads to be used by default.
+ *
+ * Returns the number of concurrent threads supported by the hardware, or 1
+ * if this number cannot be determined.
+ */
+inline uint32_t default_num_threads()
+{
+  return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+/*! \brief Runs a function on a range of indexes using multiple threads.
+ *
+ * Calls `fn( index, thread_id )` for each `index` in `[0, size)`.  Indexes
+ * are distributed dynamically among `num_threads` worker threads using a
+ * shared counter, hence tasks of different duration are balanced
+ * automatically.  The `thread_id` is in `[0, num_threads)` and can be used to
+ * access thread-local scratch data.  If `num_threads` is at most 1, or if
+ * there is a single task, all tasks are executed by the calling thread in
+ * increasing index order.
+ *
+ * If a task throws an exception, the remaining tasks are skipped and the
+ * first exception is rethrown after all threads have been joined.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      std::vector<uint32_t> results( tasks.size() );
+      parallel_for( 4u, tasks.size(), [&]( uint64_t index, uint32_t thread_id ) {
+        results[index] = solve( tasks[index], scratch[thread_id] );
+      } );
+   \endverbatim
+ */
+template<typename Fn>
+void parallel_for( uint32_t num_threads, uint64_t size, Fn&& fn )
+{
+  if ( num_threads <= 1u || size <= 1u )
+  {
+    for ( uint64_t i = 0u; i < size; ++i )
+    {
+      fn( i, 0u );
+    }
+    return;
+  }
+
+  num_threads = static_cast<uint32_t>( std::min<uint64_t>( num_threads, size ) );
+
+  std::atomic<uint64_t> next{ 0u };
+  std::atomic<bool> failed{ false };
+  std::exception_ptr exception;
+  std::mutex mu;
+
+  auto worker = [&]( uint32_t thread_id ) {
+    uint64_t i;
+    while ( !failed && ( i = next++ ) < size )
+    {
+      try
+      {
+        fn( i, thread_id );
+      }
+      catch ( ... )
+      {
+        std::lock_guard<std::mutex> lock( mu );
+        if ( !exception )
+        {
+          exception = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads - 1u );
+  for ( auto i = 1u; i < num_threads; ++i )
+  {
+    threads.emplace_back( worker, i );
+  }
+  worker( 0u );
+
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  if ( exception )
+  {
+    std::rethrow_exception( exception );
+  }
+}
+
+/*! \brief Runs a function on consecutive levels of tasks using multiple threads.
+ *
+ * Calls `fn( level, index, thread_id )` for each `index` in
+ * `[0, level_sizes[level])` of each level.  All tasks of a level are
+ * finished before any task of the next level starts, such that tasks may
+ * depend on the results of all previous levels.  Within a level, indexes
+ * are claimed in chunks from a shared counter as in `parallel_for`, and the
+ * same `num_threads` worker threads are used for all levels.  If
+ * `num_threads` is at most 1, all tasks are executed by the calling thread
+ * in increasing level and index order.
+ *
+ * If a task throws an exception, the remaining tasks are skipped and the
+ * first exception is rethrown after all threads have been joined.
+ */
+template<typename Fn>
+void parallel_for_levels( uint32_t num_threads, std::vector<uint64_t> const& level_sizes, Fn&& fn )
+{
+  auto const max_size = level_sizes.empty() ? 0u : *std::max_element( level_sizes.begin(), level_sizes.end() );
+  num_threads = static_cast<uint32_t>( std::min<uint64_t>( num_threads, max_size ) );
+  if ( num_threads <= 1u )
+  {
+    for ( auto l = 0u; l < level_sizes.size(); ++l )
+    {
+      for ( uint64_t i = 0u; i < level_sizes[l]; ++i )
+      {
+        fn( l, i, 0u );
+      }
+    }
+    return;
+  }
+
+  /* one counter per level to claim tasks, and one to wait until all are finished */
+  std::vector<std::atomic<uint64_t>> next( level_sizes.size() );
+  std::vector<std::atomic<uint64_t>> finished( level_sizes.size() );
+  std::atomic<bool> failed{ false };
+  std::exception_ptr exception;
+  std::mutex mu;
+
+  auto worker = [&]( uint32_t thread_id ) {
+    for ( auto l = 0u; l < level_sizes.size(); ++l )
+    {
+      auto const size = level_sizes[l];
+      auto const grain = std::max<uint64_t>( 1u, size / ( 8u * num_threads ) );
+
+      uint64_t done{ 0u };
+      uint64_t begin;
+      while ( !failed && ( begin = next[l].fetch_add( grain ) ) < size )
+      {
+        auto const end = std::min( begin + grain, size );
+        try
+        {
+          for ( auto i = begin; i < end; ++i )
+          {
+            fn( l, i, thread_id );
+          }
+        }
+        catch ( ... )
+        {
+          std::lock_guard<std::mutex> lock( mu );
+          if ( !exception )
+          {
+            exception = std::current_exception();
+          }
+          failed = true;
+        }
+        done += end - begin;
+      }
+
+      finished[l] += done;
+      while ( !failed && finished[l] < size )
+      {
+        std::this_thread::yield();
+      }
+      if ( failed )
+      {
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads - 1u );
+  for ( auto i = 1u; i < num_threads; ++i )
+  {
+    threads.emplace_back( worker, i );
+  }
+  worker( 0u );
+
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  if ( exception )
+  {
+    std::rethrow_exception( exception );
+  }
+}
+
+/*! \brief Calls a function on the nodes of a network rank by rank using multiple threads.
+ *
+ * Calls `fn( n, thread_id )` for each node `n` of each rank of a ranked
+ * network (e.g., `rank_view`), such that all nodes of a rank are processed
+ * before the nodes of the next rank.  Hence, `fn` may read the results of
+ * the fanins of `n`, which are in lower ranks.  The `thread_id` is in
+ * `[0, num_threads)` and can be used to access thread-local scratch data.
+ *
+ * **Required network functions:**
+ * - `depth`
+ * - `foreach_node_in_rank`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      rank_view ranked{ aig };
+      node_map<uint64_t, rank_view<aig_network>> values( ranked );
+      parallel_foreach_rank( ranked, [&]( auto const& n, uint32_t thread_id ) {
+        values[n] = evaluate( ranked, n, values, scratch[thread_id] );
+      } );
+   \endverbatim
+ */
+template<class Ntk, typename Fn>
+void parallel_foreach_rank( Ntk const& ntk, Fn&& fn, uint32_t num_threads = default_num_threads() )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_depth_v<Ntk>, "Ntk does not implement the depth method" );
+  static_assert( has_foreach_node_in_rank_v<Ntk>, "Ntk does not implement the foreach_node_in_rank method" );
+
+  std::vector<typename Ntk::node> nodes;
+  std::vector<uint64_t> offsets;
+  std::vector<uint64_t> level_sizes;
+  for ( auto r = 0u; r <= ntk.depth(); ++r )
+  {
+    offsets.push_back( nodes.size() );
+    ntk.foreach_node_in_rank( r, [&]( auto const& n ) {
+      nodes.push_back( n );
+    } );
+    level_sizes.push_back( nodes.size() - offsets.back() );
+  }
+
+  parallel_for_levels( num_threads, level_sizes, [&]( uint32_t level, uint64_t index, uint32_t thread_id ) {
+    fn( nodes[offsets[level] + index], thread_id );
+  } );
+}
+
+/*! \brief Calls a function on the gates of a network level by level using multiple threads.
+ *
+ * Calls `fn( n, thread_id )` for each gate `n`, such that all gates of a
+ * level are processed before the gates of the next level.  Hence, `fn` may
+ * read the results of the fanins of `n`.  The levels are computed while
+ * visiting the gates, which must hence be visited in topological order
+ * (e.g., in a `topo_view`).  The `thread_id` is in `[0, num_threads)` and
+ * can be used to access thread-local scratch data.
+ *
+ * **Required network functions:**
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `get_node`
+ * - `size`
+ * - `node_to_index`
+ */
+template<class Ntk, typename Fn>
+void parallel_foreach_gate_by_level( Ntk const& ntk, Fn&& fn, uint32_t num_threads = default_num_threads() )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+
+  /* levels of the gates, starting from 0 */
+  std::vector<typename Ntk::node> gates;
+  std::vector<uint32_t> gate_levels;
+  node_map<uint32_t, typename Ntk::base_type> levels( ntk, 0u ); /* views may reimplement `node_to_index` (e.g., `topo_view`) */
+  ntk.foreach_gate( [&]( auto const& n ) {
+    uint32_t level{ 0u };
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.get_node( f )] );
+    } );
+    levels[n] = level + 1u;
+    gates.push_back( n );
+    gate_levels.push_back( level );
+  } );
+
+  /* sort the gates by level */
+  std::vector<uint64_t> level_sizes;
+  for ( auto const& l : gate_levels )
+  {
+    if ( l >= level_sizes.size() )
+    {
+      level_sizes.resize( l + 1u, 0u );
+    }
+    ++level_sizes[l];
+  }
+  std::vector<uint64_t> offsets( level_sizes.size() + 1u, 0u );
+  for ( auto l = 0u; l < level_sizes.size(); ++l )
+  {
+    offsets[l + 1u] = offsets[l] + level_sizes[l];
+  }
+  std::vector<typename Ntk::node> sorted( gates.size() );
+  {
+    auto positions = offsets;
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      sorted[positions[gate_levels[i]]++] = gates[i];
+    }
+  }
+
+  parallel_for_levels( num_threads, level_sizes, [&]( uint32_t level, uint64_t index, uint32_t thread_id ) {
+    fn( sorted[offsets[level] + index], thread_id );
+  } );
+}
+
+} // namespace mockturtle
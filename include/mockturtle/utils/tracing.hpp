@@ -0,0 +1,459 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file tracing.hpp
+  \brief Instrumentation of algorithms with phase timers and counters
+
+  The macros `MOCKTURTLE_TRACE_SCOPE` and `MOCKTURTLE_TRACE_COUNT` record
+  phases and event counters into a process-wide `trace_recorder`, which can
+  export them as a Chrome trace (to be opened with `chrome://tracing` or
+  Perfetto) or as CSV.  The macros expand to nothing unless `ENABLE_TRACING`
+  is defined (CMake option `ENABLE_TRACING`).
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <sys/resource.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace mockturtle
+{
+
+/*! \brief Allocation counters.
+ *
+ * The counters are only updated if the global allocation functions are
+ * replaced using `MOCKTURTLE_TRACE_ALLOCATIONS()` in exactly one translation
+ * unit of the program.
+ */
+struct trace_allocation_counters
+{
+  inline static std::atomic<uint64_t> num_allocations{ 0 };
+  inline static std::atomic<uint64_t> num_bytes{ 0 };
+};
+
+/*! \brief Returns the peak resident set size of the process in KB.
+ *
+ * Returns 0 if the peak resident set size cannot be determined.
+ */
+inline uint64_t peak_rss_kb()
+{
+#ifndef _MSC_VER
+  rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+  {
+    return 0u;
+  }
+#ifdef __APPLE__
+  return static_cast<uint64_t>( usage.ru_maxrss ) / 1024u;
+#else
+  return static_cast<uint64_t>( usage.ru_maxrss );
+#endif
+#else
+  return 0u;
+#endif
+}
+
+/*! \brief A recorded phase or counter value. */
+struct trace_event
+{
+  /*! \brief Name of the phase or counter. */
+  std::string name;
+
+  /*! \brief Whether the event is a counter value (otherwise, a phase). */
+  bool is_counter{ false };
+
+  /*! \brief Thread that recorded the event. */
+  uint32_t thread_id{ 0 };
+
+  /*! \brief Start time in microseconds since the recorder was created. */
+  uint64_t timestamp{ 0 };
+
+  /*! \brief Duration in microseconds (phases only). */
+  uint64_t duration{ 0 };
+
+  /*! \brief Counter value (counters only). */
+  int64_t value{ 0 };
+
+  /*! \brief Number of allocations during the phase (phases only). */
+  uint64_t allocations{ 0 };
+
+  /*! \brief Number of allocated bytes during the phase (phases only). */
+  uint64_t allocated_bytes{ 0 };
+
+  /*! \brief Peak resident set size in KB at the end of the phase (phases only). */
+  uint64_t peak_rss{ 0 };
+};
+
+/*! \brief Process-wide collector of phases and event counters.
+ *
+ * Phases are recorded by `trace_scope` objects (usually created with
+ * `MOCKTURTLE_TRACE_SCOPE`) when they are destroyed.  Counters are created
+ * on first use and are incremented atomically, hence they can be used in
+ * hot loops and from multiple threads.  Whenever a phase ends, the values
+ * of the counters that changed are recorded as well.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      lut_map( aig );
+      auto& recorder = trace_recorder::instance();
+      recorder.write_chrome_trace( "trace.json" );
+      recorder.write_csv( "trace.csv" );
+   \endverbatim
+ */
+class trace_recorder
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  /*! \brief Returns the process-wide recorder. */
+  static trace_recorder& instance()
+  {
+    static trace_recorder recorder;
+    return recorder;
+  }
+
+  /*! \brief Returns the counter with the given name.
+   *
+   * The reference remains valid for the lifetime of the program.
+   */
+  std::atomic<int64_t>& counter( std::string const& name )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    auto it = _counters.find( name );
+    if ( it == _counters.end() )
+    {
+      it = _counters.emplace( std::piecewise_construct, std::forward_as_tuple( name ), std::forward_as_tuple() ).first;
+    }
+    return it->second.value;
+  }
+
+  /*! \brief Records a phase. */
+  void record_phase( std::string const& name, clock::time_point begin, clock::time_point end, uint64_t allocations, uint64_t allocated_bytes )
+  {
+    trace_event event;
+    event.name = name;
+    event.thread_id = thread_id();
+    event.timestamp = to_microseconds( begin - _start );
+    event.duration = to_microseconds( end - begin );
+    event.allocations = allocations;
+    event.allocated_bytes = allocated_bytes;
+    event.peak_rss = peak_rss_kb();
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    _events.push_back( event );
+    snapshot_counters( event.thread_id, event.timestamp + event.duration );
+  }
+
+  /*! \brief Removes all events and resets all counters to 0. */
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    _events.clear();
+    for ( auto& [_, c] : _counters )
+    {
+      c.value = 0;
+      c.last_value = 0;
+    }
+  }
+
+  /*! \brief Returns a copy of the recorded events. */
+  std::vector<trace_event> events() const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _events;
+  }
+
+  /*! \brief Writes the events in Chrome trace event format. */
+  void write_chrome_trace( std::ostream& os ) const
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for ( auto const& e : _events )
+    {
+      os << ( first ? "\n" : ",\n" );
+      first = false;
+      if ( e.is_counter )
+      {
+        os << fmt::format( "{{\"name\":\"{}\",\"ph\":\"C\",\"pid\":0,\"tid\":{},\"ts\":{},\"args\":{{\"value\":{}}}}}",
+                           escape( e.name ), e.thread_id, e.timestamp, e.value );
+      }
+      else
+      {
+        os << fmt::format( "{{\"name\":\"{}\",\"cat\":\"mockturtle\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{},\"dur\":{},\"args\":{{\"allocations\":{},\"allocated_bytes\":{},\"peak_rss_kb\":{}}}}}",
+                           escape( e.name ), e.thread_id, e.timestamp, e.duration, e.allocations, e.allocated_bytes, e.peak_rss );
+      }
+    }
+    os << "\n]}\n";
+  }
+
+  /*! \brief Writes the events in Chrome trace event format into a file. */
+  void write_chrome_trace( std::string const& filename ) const
+  {
+    std::ofstream os( filename.c_str(), std::ofstream::out );
+    write_chrome_trace( os );
+    os.close();
+  }
+
+  /*! \brief Writes a summary of the phases and counters as CSV.
+   *
+   * Each phase is summarized by the number of times it was recorded, its
+   * total and maximum duration in microseconds, the total number of
+   * allocations and allocated bytes, and the peak resident set size.  Each
+   * counter is summarized by its current value.
+   */
+  void write_csv( std::ostream& os ) const
+  {
+    struct phase_summary
+    {
+      uint64_t calls{ 0 };
+      uint64_t total{ 0 };
+      uint64_t max{ 0 };
+      uint64_t allocations{ 0 };
+      uint64_t allocated_bytes{ 0 };
+      uint64_t peak_rss{ 0 };
+    };
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    std::map<std::string, phase_summary> phases;
+    for ( auto const& e : _events )
+    {
+      if ( e.is_counter )
+        continue;
+
+      auto& s = phases[e.name];
+      ++s.calls;
+      s.total += e.duration;
+      s.max = std::max( s.max, e.duration );
+      s.allocations += e.allocations;
+      s.allocated_bytes += e.allocated_bytes;
+      s.peak_rss = std::max( s.peak_rss, e.peak_rss );
+    }
+
+    os << "type,name,calls,total_us,max_us,value,allocations,allocated_bytes,peak_rss_kb\n";
+    for ( auto const& [name, s] : phases )
+    {
+      os << fmt::format( "phase,{},{},{},{},,{},{},{}\n", name, s.calls, s.total, s.max, s.allocations, s.allocated_bytes, s.peak_rss );
+    }
+    for ( auto const& [name, c] : _counters )
+    {
+      os << fmt::format( "counter,{},,,,{},,,\n", name, c.value.load() );
+    }
+  }
+
+  /*! \brief Writes a summary of the phases and counters as CSV into a file. */
+  void write_csv( std::string const& filename ) const
+  {
+    std::ofstream os( filename.c_str(), std::ofstream::out );
+    write_csv( os );
+    os.close();
+  }
+
+  /*! \brief Returns a small identifier of the calling thread. */
+  static uint32_t thread_id()
+  {
+    static std::atomic<uint32_t> next_id{ 0 };
+    thread_local uint32_t id = next_id++;
+    return id;
+  }
+
+private:
+  struct counter_data
+  {
+    std::atomic<int64_t> value{ 0 };
+    int64_t last_value{ 0 };
+  };
+
+  trace_recorder()
+      : _start( clock::now() )
+  {
+  }
+
+  static uint64_t to_microseconds( clock::duration d )
+  {
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::microseconds>( d ).count() );
+  }
+
+  static std::string escape( std::string const& s )
+  {
+    std::string res;
+    for ( auto c : s )
+    {
+      if ( c == '"' || c == '\\' )
+      {
+        res += '\\';
+      }
+      res += c;
+    }
+    return res;
+  }
+
+  /* record the counters that changed since the last snapshot (requires lock) */
+  void snapshot_counters( uint32_t thread_id, uint64_t timestamp )
+  {
+    for ( auto& [name, c] : _counters )
+    {
+      auto const value = c.value.load( std::memory_order_relaxed );
+      if ( value == c.last_value )
+        continue;
+
+      c.last_value = value;
+      trace_event event;
+      event.name = name;
+      event.is_counter = true;
+      event.thread_id = thread_id;
+      event.timestamp = timestamp;
+      event.value = value;
+      _events.push_back( event );
+    }
+  }
+
+private:
+  clock::time_point _start;
+  std::vector<trace_event> _events;
+  std::map<std::string, counter_data> _counters;
+  mutable std::mutex _mutex;
+};
+
+/*! \brief Records a phase from its construction to its destruction. */
+class trace_scope
+{
+public:
+  explicit trace_scope( char const* name )
+      : _name( name ),
+        _allocations( trace_allocation_counters::num_allocations.load( std::memory_order_relaxed ) ),
+        _allocated_bytes( trace_allocation_counters::num_bytes.load( std::memory_order_relaxed ) ),
+        _begin( trace_recorder::clock::now() )
+  {
+  }
+
+  trace_scope( trace_scope const& ) = delete;
+  trace_scope& operator=( trace_scope const& ) = delete;
+
+  ~trace_scope()
+  {
+    auto const end = trace_recorder::clock::now();
+    trace_recorder::instance().record_phase( _name, _begin, end,
+                                             trace_allocation_counters::num_allocations.load( std::memory_order_relaxed ) - _allocations,
+                                             trace_allocation_counters::num_bytes.load( std::memory_order_relaxed ) - _allocated_bytes );
+  }
+
+private:
+  char const* _name;
+  uint64_t _allocations;
+  uint64_t _allocated_bytes;
+  trace_recorder::clock::time_point _begin;
+};
+
+namespace detail
+{
+
+inline void* trace_allocate( std::size_t size )
+{
+  trace_allocation_counters::num_allocations.fetch_add( 1u, std::memory_order_relaxed );
+  trace_allocation_counters::num_bytes.fetch_add( size, std::memory_order_relaxed );
+  if ( void* p = std::malloc( size == 0u ? 1u : size ) )
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+/* not inlined, such that the compiler does not pair `free` with `new` */
+#ifdef __GNUC__
+__attribute__( ( noinline ) )
+#endif
+inline void
+trace_deallocate( void* p ) noexcept
+{
+  std::free( p );
+}
+
+} // namespace detail
+
+} // namespace mockturtle
+
+#define MOCKTURTLE_TRACE_CONCAT_IMPL( a, b ) a##b
+#define MOCKTURTLE_TRACE_CONCAT( a, b ) MOCKTURTLE_TRACE_CONCAT_IMPL( a, b )
+
+#ifdef ENABLE_TRACING
+
+/*! \brief Records a phase that lasts until the end of the enclosing scope. */
+#define MOCKTURTLE_TRACE_SCOPE( name ) ::mockturtle::trace_scope MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_scope_, __LINE__ )( name )
+
+/*! \brief Increments the counter `name` by `value`. */
+#define MOCKTURTLE_TRACE_COUNT( name, value )                                                                                       \
+  do                                                                                                                                \
+  {                                                                                                                                 \
+    static auto& MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_counter_, __LINE__ ) = ::mockturtle::trace_recorder::instance().counter( name ); \
+    MOCKTURTLE_TRACE_CONCAT( _mockturtle_trace_counter_, __LINE__ ).fetch_add( static_cast<int64_t>( value ), std::memory_order_relaxed );  \
+  } while ( false )
+
+#else
+
+#define MOCKTURTLE_TRACE_SCOPE( name ) static_cast<void>( 0 )
+#define MOCKTURTLE_TRACE_COUNT( name, value ) static_cast<void>( 0 )
+
+#endif
+
+/*! \brief Replaces the global allocation functions to count allocations.
+ *
+ * Must be used at namespace scope in exactly one translation unit.
+ */
+#define MOCKTURTLE_TRACE_ALLOCATIONS()                         \
+  void* operator new( std::size_t size )                      \
+  {                                                           \
+    return ::mockturtle::detail::trace_allocate( size );      \
+  }                                                           \
+  void operator delete( void* p ) noexcept                    \
+  {                                                           \
+    ::mockturtle::detail::trace_deallocate( p );              \
+  }                                                           \
+  void operator delete( void* p, std::size_t ) noexcept       \
+  {                                                           \
+    ::mockturtle::detail::trace_deallocate( p );              \
+  }
@@ -42,6 +42,8 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include "tracing.hpp"
+
 namespace mockturtle
 {
 
@@ -141,9 +143,11 @@ uint32_t truth_table_cache<TT>::insert( TT tt )
   }
 
   /* is truth table already in cache? */
+  MOCKTURTLE_TRACE_COUNT( "truth_table_cache/lookups", 1 );
   const auto it = _indexes.find( tt );
   if ( it != _indexes.end() )
   {
+    MOCKTURTLE_TRACE_COUNT( "truth_table_cache/hits", 1 );
     return static_cast<uint32_t>( 2 * it->second + is_compl );
   }
 
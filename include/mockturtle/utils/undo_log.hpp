@@ -0,0 +1,148 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file undo_log.hpp
+  \brief Transactional undo log for in-place network modifications
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "../traits.hpp"
+#include "network_snapshot.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Transactional undo log of a network.
+ *
+ * Between `begin` and `commit` or `rollback`, the network logs the
+ * previous content of each node before modifying it (node creation,
+ * fanin replacement, fanout counters, `take_out_node`, and
+ * `revive_node`), including whether the node was in the structural hash
+ * table, as well as the previous drivers of redirected outputs.  Rolling
+ * back a transaction undoes its modifications in reverse order, in time
+ * linear in their number, and removes the nodes, inputs, and outputs
+ * created during the transaction.  Transactions can be nested: committing
+ * an inner transaction keeps its modifications in the log of the enclosing
+ * one.
+ *
+ * As for `network_snapshot`, the log applies to the storage shared by all
+ * copies of the network, rolling back does not emit network events, and
+ * the values and visited flags of nodes are not restored.
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      depth_view aig = ...;
+      network_undo_log log{ aig };
+
+      log.begin();
+      aig.substitute_node( n, candidate );
+      aig.update_levels();
+      if ( aig.depth() > max_depth )
+      {
+        log.rollback();
+        aig.update_levels();
+      }
+      else
+      {
+        log.commit();
+      }
+   \endverbatim
+ */
+template<class Ntk>
+class network_undo_log
+{
+public:
+  explicit network_undo_log( Ntk const& ntk )
+      : _storage( ntk._storage )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_node_backup_v<typename Ntk::base_type>, "Ntk does not save its nodes before modifying them" );
+  }
+
+  network_undo_log( network_undo_log<Ntk> const& ) = delete;
+  network_undo_log<Ntk>& operator=( network_undo_log<Ntk> const& ) = delete;
+
+  /*! \brief Keeps the modifications of the transactions that are still open. */
+  ~network_undo_log()
+  {
+    while ( _num_transactions > 0u )
+    {
+      commit();
+    }
+  }
+
+  /*! \brief Opens a transaction, nested in the currently open one (if any). */
+  void begin()
+  {
+    _storage->begin_transaction();
+    ++_num_transactions;
+  }
+
+  /*! \brief Closes the innermost transaction and keeps its modifications. */
+  void commit()
+  {
+    assert( _num_transactions > 0u );
+    _storage->commit_transaction();
+    --_num_transactions;
+  }
+
+  /*! \brief Closes the innermost transaction and undoes its modifications. */
+  void rollback()
+  {
+    assert( _num_transactions > 0u );
+    _storage->rollback_transaction();
+    --_num_transactions;
+  }
+
+  /*! \brief Number of open transactions. */
+  uint32_t num_transactions() const
+  {
+    return _num_transactions;
+  }
+
+  /*! \brief Number of logged modifications of nodes and outputs. */
+  uint64_t num_entries() const
+  {
+    return _storage->undo_log.node_entries.size() + _storage->undo_log.output_entries.size();
+  }
+
+private:
+  typename Ntk::storage _storage;
+  uint32_t _num_transactions{ 0u };
+};
+
+template<class T>
+network_undo_log( T const& ) -> network_undo_log<T>;
+
+} // namespace mockturtle
@@ -39,9 +39,13 @@
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
+#include "fanout_view.hpp"
 #include "immutable_view.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 
 namespace mockturtle
@@ -54,6 +58,9 @@ struct depth_view_params
 
   /*! \brief Whether PIs have costs. */
   bool pi_cost{ false };
+
+  /*! \brief Update levels, depth, and critical paths when nodes are modified or deleted. */
+  bool incremental{ false };
 };
 
 /*! \brief Implements `depth` and `level` methods for networks.
@@ -69,6 +76,15 @@ struct depth_view_params
  * recalculated (due to efficiency reasons).  In order to recalculate levels,
  * depth, and critical paths, one can call `update_levels` instead.
  *
+ * In incremental mode (see `depth_view_params`), the view keeps the fanouts
+ * of the nodes and updates the levels when nodes are modified: the changes
+ * are propagated forward through the affected fanout cone, in increasing
+ * level order, and stop at nodes whose level does not change.  Levels are
+ * then also kept for nodes outside the transitive fanin of the outputs.
+ * The depth and the critical paths are recomputed from the levels when they
+ * are queried after a change, and `update_levels` only recomputes the levels
+ * if they have been changed with `set_level`.
+ *
  * **Required network functions:**
  * - `size`
  * - `get_node`
@@ -128,7 +144,7 @@ public:
     static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    register_events();
   }
 
   /*! \brief Standard constructor.
@@ -149,20 +165,21 @@ public:
 
     update_levels();
 
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    register_events();
   }
 
   /*! \brief Copy constructor. */
   explicit depth_view( depth_view<Ntk, NodeCostFn, false> const& other )
-      : Ntk( other ), _ps( other._ps ), _levels( other._levels ), _crit_path( other._crit_path ), _depth( other._depth ), _cost_fn( other._cost_fn )
+      : Ntk( other ), _ps( other._ps ), _levels( other._levels ), _crit_path( other._crit_path ), _critical_nodes( other._critical_nodes ), _depth( other._depth ), _cost_fn( other._cost_fn ),
+        _levels_changed( other._levels_changed ), _levels_overridden( other._levels_overridden )
   {
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    register_events();
   }
 
   depth_view<Ntk, NodeCostFn, false>& operator=( depth_view<Ntk, NodeCostFn, false> const& other )
   {
     /* delete the event of this network */
-    Ntk::events().release_add_event( add_event );
+    release_events();
 
     /* update the base class */
     this->_storage = other._storage;
@@ -172,22 +189,26 @@ public:
     _ps = other._ps;
     _levels = other._levels;
     _crit_path = other._crit_path;
+    _critical_nodes = other._critical_nodes;
     _depth = other._depth;
     _cost_fn = other._cost_fn;
+    _levels_changed = other._levels_changed;
+    _levels_overridden = other._levels_overridden;
 
     /* register new event in the other network */
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    register_events();
 
     return *this;
   }
 
   ~depth_view()
   {
-    Ntk::events().release_add_event( add_event );
+    release_events();
   }
 
   uint32_t depth() const
   {
+    update_critical_paths();
     return _depth;
   }
 
@@ -198,12 +219,14 @@ public:
 
   bool is_on_critical_path( node const& n ) const
   {
+    update_critical_paths();
     return _crit_path[n];
   }
 
   void set_level( node const& n, uint32_t level )
   {
     _levels[n] = level;
+    _levels_overridden = true;
   }
 
   void set_depth( uint32_t level )
@@ -213,8 +236,18 @@ public:
 
   void update_levels()
   {
+    if ( _fanout && !_levels_overridden )
+    {
+      /* the levels are kept up to date in incremental mode */
+      update_critical_paths();
+      return;
+    }
+
     _levels.reset( 0 );
     _crit_path.reset( false );
+    _critical_nodes.clear();
+    _levels_changed = false;
+    _levels_overridden = false;
 
     this->incr_trav_id();
     compute_levels();
@@ -232,6 +265,45 @@ public:
   }
 
 private:
+  void register_events()
+  {
+    if ( _ps.incremental )
+    {
+      /* created first, so that the fanouts are updated before the levels */
+      _fanout = std::make_unique<fanout_view<Ntk>>( *this );
+      _queued.assign( this->size(), false );
+
+      modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+        (void)previous;
+        schedule( n );
+        propagate_levels();
+      } );
+      delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
+        (void)n;
+        _levels_changed = true;
+      } );
+    }
+
+    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+  }
+
+  void release_events()
+  {
+    Ntk::events().release_add_event( add_event );
+
+    if ( modified_event )
+    {
+      Ntk::events().release_modified_event( modified_event );
+    }
+
+    if ( delete_event )
+    {
+      Ntk::events().release_delete_event( delete_event );
+    }
+
+    _fanout.reset();
+  }
+
   uint32_t compute_levels( node const& n )
   {
     if ( this->visited( n ) == this->trav_id() )
@@ -287,6 +359,19 @@ private:
       } );
     }
 
+    if ( _ps.incremental )
+    {
+      /* dangling nodes may be used in later substitutions, so their levels are kept as well */
+      this->foreach_gate( [&]( auto const& n ) {
+        compute_levels( n );
+      } );
+    }
+
+    mark_critical_paths();
+  }
+
+  void mark_critical_paths() const
+  {
     this->foreach_po( [&]( auto const& f ) {
       const auto n = this->get_node( f );
       if ( _levels[n] == _depth )
@@ -307,9 +392,10 @@ private:
     }
   }
 
-  void set_critical_path( node const& n )
+  void set_critical_path( node const& n ) const
   {
     _crit_path[n] = true;
+    _critical_nodes.push_back( n );
     if ( !this->is_constant( n ) && !( _ps.pi_cost && this->is_pi( n ) ) )
     {
       const auto lvl = _levels[n];
@@ -328,10 +414,41 @@ private:
     }
   }
 
-  void on_add( node const& n )
+  /* recomputes the depth and the critical paths after levels have changed in incremental mode */
+  void update_critical_paths() const
   {
-    _levels.resize();
+    if ( !_levels_changed )
+    {
+      return;
+    }
+    _levels_changed = false;
 
+    _depth = 0;
+    auto const update_depth = [&]( auto const& f ) {
+      auto clevel = _levels[f];
+      if ( _ps.count_complements && this->is_complemented( f ) )
+      {
+        clevel++;
+      }
+      _depth = std::max( _depth, clevel );
+    };
+    this->foreach_po( update_depth );
+    if constexpr ( has_foreach_ri_v<Ntk> )
+    {
+      this->foreach_ri( update_depth );
+    }
+
+    _crit_path.resize( false );
+    for ( auto const& n : _critical_nodes )
+    {
+      _crit_path[n] = false;
+    }
+    _critical_nodes.clear();
+    mark_critical_paths();
+  }
+
+  uint32_t compute_level( node const& n ) const
+  {
     uint32_t level{ 0 };
     this->foreach_fanin( n, [&]( auto const& f ) {
       auto clevel = _levels[f];
@@ -342,16 +459,107 @@ private:
       level = std::max( level, clevel );
     } );
 
-    _levels[n] = level + _cost_fn( *this, n );
+    return level + _cost_fn( *this, n );
+  }
+
+  void on_add( node const& n )
+  {
+    _levels.resize();
+    _levels[n] = compute_level( n );
+
+    if ( _ps.incremental )
+    {
+      _levels_changed = true;
+    }
+  }
+
+  /* schedules a node for a level update in the bucket of its current level */
+  void schedule( node const& n )
+  {
+    auto const index = this->node_to_index( n );
+    if ( index >= _queued.size() )
+    {
+      _queued.resize( this->size(), false );
+    }
+    if ( _queued[index] )
+    {
+      return;
+    }
+    _queued[index] = true;
+
+    auto const level = _levels[n];
+    if ( level >= _buckets.size() )
+    {
+      _buckets.resize( level + 1u );
+    }
+    _buckets[level].push_back( n );
+    _first_bucket = std::min<uint32_t>( _first_bucket, level );
+    ++_num_scheduled;
+  }
+
+  /* updates the levels of the scheduled nodes and of their transitive fanout, in increasing level order */
+  void propagate_levels()
+  {
+    while ( _num_scheduled > 0u )
+    {
+      auto& bucket = _buckets[_first_bucket];
+      if ( bucket.empty() )
+      {
+        ++_first_bucket;
+        continue;
+      }
+
+      auto const n = bucket.back();
+      bucket.pop_back();
+      --_num_scheduled;
+      _queued[this->node_to_index( n )] = false;
+
+      if constexpr ( has_is_dead_v<Ntk> )
+      {
+        if ( this->is_dead( n ) )
+        {
+          continue;
+        }
+      }
+
+      auto const level = compute_level( n );
+      if ( level == _levels[n] )
+      {
+        continue;
+      }
+      _levels[n] = level;
+      _levels_changed = true;
+
+      /* fanouts are scheduled in the bucket of their current level, possibly before `_first_bucket` */
+      _fanout->foreach_fanout( n, [&]( auto const& p ) {
+        schedule( p );
+      } );
+    }
+    _first_bucket = std::numeric_limits<uint32_t>::max();
   }
 
   depth_view_params _ps;
   node_map<uint32_t, Ntk> _levels;
-  node_map<uint32_t, Ntk> _crit_path;
-  uint32_t _depth{};
+  mutable node_map<uint32_t, Ntk> _crit_path;
+  mutable std::vector<node> _critical_nodes;
+  mutable uint32_t _depth{};
   NodeCostFn _cost_fn;
 
+protected:
+  /* incremental mode (the fanouts are shared with derived views) */
+  std::unique_ptr<fanout_view<Ntk>> _fanout;
+
+private:
+  std::vector<std::vector<node>> _buckets;
+  std::vector<bool> _queued;
+  uint32_t _first_bucket{ std::numeric_limits<uint32_t>::max() };
+  uint64_t _num_scheduled{ 0u };
+  mutable bool _levels_changed{ false };
+  bool _levels_overridden{ false };
+
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
 };
 
 template<class T>
@@ -41,7 +41,10 @@
 #include "../utils/node_map.hpp"
 #include "immutable_view.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <limits>
 #include <stack>
 #include <vector>
 
@@ -62,6 +65,13 @@ struct fanout_view_params
  * fanout are computed at construction and can be recomputed by
  * calling the `update_fanout` method.
  *
+ * The fanouts of all nodes are packed in a single array (compressed
+ * sparse row format), in which each node owns a contiguous range with
+ * some free slots.  A node whose range is full is moved to the end of
+ * the array, and the array is compacted when the abandoned slots
+ * outnumber the used ones.  Fanouts are visited in the order in which
+ * they have been added.
+ *
  * **Required network functions:**
  * - `foreach_node`
  * - `foreach_fanin`
@@ -91,7 +101,7 @@ public:
   using signal = typename Ntk::signal;
 
   explicit fanout_view( fanout_view_params const& ps = {} )
-      : Ntk(), _fanout( *this ), _ps( ps )
+      : Ntk(), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
@@ -103,7 +113,7 @@ public:
   }
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
-      : Ntk( ntk ), _fanout( ntk ), _ps( ps )
+      : Ntk( ntk ), _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
@@ -116,7 +126,7 @@ public:
 
   /*! \brief Copy constructor. */
   fanout_view( fanout_view<Ntk, false> const& other )
-      : Ntk( other ), _fanout( other._fanout ), _ps( other._ps )
+      : Ntk( other ), _ranges( other._ranges ), _fanouts( other._fanouts ), _num_abandoned( other._num_abandoned ), _ps( other._ps )
   {
     register_events();
   }
@@ -131,7 +141,9 @@ public:
 
     /* copy */
     _ps = other._ps;
-    _fanout = other._fanout;
+    _ranges = other._ranges;
+    _fanouts = other._fanouts;
+    _num_abandoned = other._num_abandoned;
 
     register_events();
 
@@ -147,7 +159,9 @@ public:
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+    auto const index = this->node_to_index( n );
+    auto const size = _ranges[index].size;
+    detail::foreach_element( fanout_iterator{ &_ranges, &_fanouts, index, 0u }, fanout_iterator{ &_ranges, &_fanouts, index, size }, fn );
   }
 
   void update_fanout()
@@ -157,7 +171,8 @@ public:
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    auto const& range = _ranges[this->node_to_index( n )];
+    return std::vector<node>( _fanouts.begin() + range.offset, _fanouts.begin() + range.offset + range.size );
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -199,7 +214,8 @@ public:
       if ( Ntk::get_node( _new ) == _old && !Ntk::is_complemented( _new ) )
         continue;
 
-      const auto parents = _fanout[_old];
+      const auto parents = fanout( _old );
+      _detached = _old;
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -207,6 +223,7 @@ public:
           to_substitute.push( *repl );
         }
       }
+      reattach_fanout( _old );
 
       /* check outputs */
       Ntk::replace_in_outputs( _old, _new );
@@ -230,11 +247,13 @@ public:
       Ntk::revive_node( Ntk::get_node( new_signal ) );
     }
 
-    const auto parents = _fanout[old_node];
+    const auto parents = fanout( old_node );
+    _detached = old_node;
     for ( auto n : parents )
     {
       Ntk::replace_in_node_no_restrash( n, old_node, new_signal );
     }
+    reattach_fanout( old_node );
 
     /* check outputs */
     Ntk::replace_in_outputs( old_node, new_signal );
@@ -247,14 +266,175 @@ public:
   }
 
 private:
+  /* range of the fanouts of a node in the fanout array */
+  struct fanout_range
+  {
+    uint64_t offset{ 0u };
+    uint32_t size{ 0u };
+    uint32_t capacity{ 0u };
+  };
+
+  /* iterates over the range of a node by position, hence it stays valid if the array grows or is compacted */
+  struct fanout_iterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = node;
+    using difference_type = std::ptrdiff_t;
+    using pointer = node const*;
+    using reference = node const&;
+
+    std::vector<fanout_range> const* ranges;
+    std::vector<node> const* fanouts;
+    uint64_t index;
+    uint32_t position;
+
+    reference operator*() const
+    {
+      return ( *fanouts )[( *ranges )[index].offset + position];
+    }
+
+    fanout_iterator& operator++()
+    {
+      ++position;
+      return *this;
+    }
+
+    fanout_iterator operator++( int )
+    {
+      auto const copy = *this;
+      ++position;
+      return copy;
+    }
+
+    bool operator==( fanout_iterator const& other ) const
+    {
+      return position == other.position;
+    }
+
+    bool operator!=( fanout_iterator const& other ) const
+    {
+      return position != other.position;
+    }
+  };
+
+  static constexpr node no_node = std::numeric_limits<node>::max();
+
+  /* number of free slots given to a range holding `size` fanouts */
+  static uint32_t slack( uint32_t size )
+  {
+    return size / 2u + 1u;
+  }
+
+  void add_fanout( node const& n, node const& fanout )
+  {
+    auto& range = _ranges[this->node_to_index( n )];
+    if ( range.size == range.capacity )
+    {
+      grow( range );
+    }
+    _fanouts[range.offset + range.size++] = fanout;
+  }
+
+  void remove_fanout( node const& n, node const& fanout )
+  {
+    auto& range = _ranges[this->node_to_index( n )];
+    auto const begin = _fanouts.begin() + range.offset;
+    range.size = static_cast<uint32_t>( std::remove( begin, begin + range.size, fanout ) - begin );
+  }
+
+  /* moves a full range to the end of the fanout array */
+  void grow( fanout_range& range )
+  {
+    auto const capacity = range.capacity + slack( range.capacity );
+    if ( range.offset + range.capacity == _fanouts.size() )
+    {
+      _fanouts.resize( range.offset + capacity );
+      range.capacity = capacity;
+      return;
+    }
+
+    if ( _num_abandoned + range.capacity > _fanouts.size() / 2u )
+    {
+      compact( &range );
+      if ( range.size < range.capacity )
+      {
+        return;
+      }
+      if ( range.offset + range.capacity == _fanouts.size() )
+      {
+        _fanouts.resize( range.offset + capacity );
+        range.capacity = capacity;
+        return;
+      }
+    }
+
+    auto const offset = _fanouts.size();
+    _fanouts.resize( offset + capacity );
+    std::copy( _fanouts.begin() + range.offset, _fanouts.begin() + range.offset + range.size, _fanouts.begin() + offset );
+    _num_abandoned += range.capacity;
+    range.offset = offset;
+    range.capacity = capacity;
+  }
+
+  /* packs the ranges in node order, leaving free slots in each range */
+  void compact( fanout_range const* full_range = nullptr )
+  {
+    std::vector<node> fanouts;
+    uint64_t total{ 0u };
+    for ( auto const& range : _ranges )
+    {
+      total += range.size + slack( range.size );
+    }
+    fanouts.reserve( total );
+
+    for ( auto& range : _ranges )
+    {
+      auto const offset = fanouts.size();
+      fanouts.insert( fanouts.end(), _fanouts.begin() + range.offset, _fanouts.begin() + range.offset + range.size );
+      fanouts.resize( offset + range.size + ( &range == full_range ? 0u : slack( range.size ) ) );
+      range.offset = offset;
+      range.capacity = static_cast<uint32_t>( fanouts.size() - offset );
+    }
+
+    _fanouts = std::move( fanouts );
+    _num_abandoned = 0u;
+  }
+
+  /* updates the fanouts of a node after its parents have been modified */
+  void reattach_fanout( node const& n )
+  {
+    _detached = no_node;
+
+    auto& range = _ranges[this->node_to_index( n )];
+    auto const begin = _fanouts.begin() + range.offset;
+    auto const end = std::remove_if( begin, begin + range.size, [&, this]( auto const& p ) {
+      if ( Ntk::is_dead( p ) )
+      {
+        return true;
+      }
+
+      bool is_fanin{ false };
+      Ntk::foreach_fanin( p, [&, this]( auto const& f ) {
+        if ( Ntk::get_node( f ) == n )
+        {
+          is_fanin = true;
+          return false;
+        }
+        return true;
+      } );
+      return !is_fanin;
+    } );
+    range.size = static_cast<uint32_t>( end - begin );
+  }
+
   void register_events()
   {
     if ( _ps.update_on_add )
     {
       add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
-        _fanout.resize();
+        _ranges.resize( this->size() );
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          add_fanout( Ntk::get_node( f ), n );
         } );
       } );
     }
@@ -262,13 +442,19 @@ private:
     if ( _ps.update_on_modified )
     {
       modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
-        (void)previous;
+        /* the fanouts of a node whose parents are being redirected during a substitution are updated at once */
         for ( auto const& f : previous )
         {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          if ( Ntk::get_node( f ) != _detached )
+          {
+            remove_fanout( Ntk::get_node( f ), n );
+          }
         }
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
+          if ( Ntk::get_node( f ) != _detached )
+          {
+            add_fanout( Ntk::get_node( f ), n );
+          }
         } );
       } );
     }
@@ -276,9 +462,9 @@ private:
     if ( _ps.update_on_delete )
     {
       delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
-        _fanout[n].clear();
+        _ranges[this->node_to_index( n )].size = 0u;
         Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
+          remove_fanout( Ntk::get_node( f ), n );
         } );
       } );
     }
@@ -304,39 +490,60 @@ private:
 
   void compute_fanout()
   {
-    _fanout.reset();
+    _ranges.assign( this->size(), fanout_range{} );
+    _num_abandoned = 0u;
 
     /* Compute fanout also for buffers in buffered networks */
-    if constexpr ( is_buffered_network_type_v<Ntk> )
-    {
-      this->foreach_node( [&]( auto const& n ) {
-        if ( this->is_pi( n ) || this->is_constant( n ) )
+    auto const foreach_parent = [&]( auto&& fn ) {
+      if constexpr ( is_buffered_network_type_v<Ntk> )
+      {
+        this->foreach_node( [&]( auto const& n ) {
+          if ( this->is_pi( n ) || this->is_constant( n ) )
+            return true;
+          fn( n );
           return true;
-        this->foreach_fanin( n, [&]( auto const& c ) {
-          auto& fanout = _fanout[c];
-          if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-          {
-            fanout.push_back( n );
-          }
         } );
-        return true;
-      } );
-    }
-    else
-    {
-      this->foreach_gate( [&]( auto const& n ) {
-        this->foreach_fanin( n, [&]( auto const& c ) {
-          auto& fanout = _fanout[c];
-          if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-          {
-            fanout.push_back( n );
-          }
+      }
+      else
+      {
+        this->foreach_gate( [&]( auto const& n ) {
+          fn( n );
         } );
+      }
+    };
+
+    /* count the fanins to reserve the ranges */
+    foreach_parent( [&]( auto const& n ) {
+      this->foreach_fanin( n, [&]( auto const& c ) {
+        ++_ranges[this->node_to_index( this->get_node( c ) )].capacity;
       } );
+    } );
+
+    uint64_t offset{ 0u };
+    for ( auto& range : _ranges )
+    {
+      range.offset = offset;
+      range.capacity += slack( range.capacity );
+      offset += range.capacity;
     }
+    _fanouts.assign( offset, no_node );
+
+    /* a node is a fanout only once, even if it has the same fanin several times (the parents are visited one after the other) */
+    foreach_parent( [&]( auto const& n ) {
+      this->foreach_fanin( n, [&]( auto const& c ) {
+        auto& range = _ranges[this->node_to_index( this->get_node( c ) )];
+        if ( range.size == 0u || _fanouts[range.offset + range.size - 1u] != n )
+        {
+          _fanouts[range.offset + range.size++] = n;
+        }
+      } );
+    } );
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  std::vector<fanout_range> _ranges;
+  std::vector<node> _fanouts;
+  uint64_t _num_abandoned{ 0u };
+  node _detached{ no_node };
   fanout_view_params _ps;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
@@ -0,0 +1,394 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file required_view.hpp
+  \brief Implements reverse levels, required times, and slacks for a network
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "../utils/cost_functions.hpp"
+#include "../utils/node_map.hpp"
+#include "depth_view.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Implements `reverse_level`, `required`, and `slack` methods for networks.
+ *
+ * This view extends `depth_view` in incremental mode.  In addition to the
+ * levels, it keeps the reverse level of each node, which is the longest
+ * path from the node to an output, not counting the cost of the node
+ * itself.  The required time of a node is then the depth minus its reverse
+ * level, and its slack is the difference between its required time and
+ * its level.  Nodes on a critical path have zero slack, and nodes that do
+ * not reach an output have the depth as required time.  The slack is
+ * negative for nodes that are deeper than the depth, e.g., for candidates
+ * that are not yet connected to an output.
+ *
+ * Reverse levels do not depend on the depth, so that they can be updated
+ * locally when nodes are added, modified, or deleted: the changes are
+ * propagated backward through the affected fanin cone, in decreasing level
+ * order, and stop at nodes whose reverse level does not change.  Reverse
+ * levels are queried in constant time, whereas `required` and `slack` use
+ * the depth, which is recomputed after changes to the network.
+ *
+ * Outputs are tracked when they are created or redirected by
+ * `substitute_node` on this view.  After modifying the outputs otherwise,
+ * the reverse levels must be recomputed with `update_required`.
+ * Complemented edges are not counted (`count_complements` must not be set).
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `is_dead`
+ * - `foreach_co`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `substitute_node`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      // create network somehow
+      aig_network aig = ...;
+
+      // create a required view on the network
+      required_view aig_required{aig};
+
+      // find nodes that can be made deeper without increasing the depth
+      aig_required.foreach_gate( [&]( auto const& n ) {
+        if ( aig_required.slack( n ) > 0 )
+        {
+          // ...
+        }
+      } );
+   \endverbatim
+ */
+template<class Ntk, class NodeCostFn = unit_cost<Ntk>>
+class required_view : public depth_view<Ntk, NodeCostFn>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Standard constructor.
+   *
+   * \param ntk Base network
+   */
+  explicit required_view( Ntk const& ntk, NodeCostFn const& cost_fn = {}, depth_view_params const& ps = {} )
+      : depth_view<Ntk, NodeCostFn>( ntk, cost_fn, incremental_params( ps ) ), _rlevels( ntk ), _po_refs( ntk ), _cost_fn( cost_fn )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_dead_v<Ntk>, "Ntk does not implement the is_dead method" );
+    static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_substitute_node_v<Ntk>, "Ntk does not implement the substitute_node method" );
+    assert( !ps.count_complements && "complemented edges are not supported" );
+
+    update_required();
+    register_events();
+  }
+
+  /*! \brief Copy constructor. */
+  explicit required_view( required_view<Ntk, NodeCostFn> const& other )
+      : depth_view<Ntk, NodeCostFn>( other ), _rlevels( other._rlevels ), _po_refs( other._po_refs ), _po_drivers( other._po_drivers ), _cost_fn( other._cost_fn )
+  {
+    register_events();
+  }
+
+  required_view<Ntk, NodeCostFn>& operator=( required_view<Ntk, NodeCostFn> const& other )
+  {
+    release_events();
+
+    depth_view<Ntk, NodeCostFn>::operator=( other );
+    _rlevels = other._rlevels;
+    _po_refs = other._po_refs;
+    _po_drivers = other._po_drivers;
+    _cost_fn = other._cost_fn;
+
+    register_events();
+    return *this;
+  }
+
+  ~required_view()
+  {
+    release_events();
+  }
+
+  /*! \brief Longest path from `n` to an output, excluding the cost of `n`. */
+  uint32_t reverse_level( node const& n ) const
+  {
+    return _rlevels[n] == no_path ? 0u : _rlevels[n];
+  }
+
+  /*! \brief Latest level of `n` that does not increase the depth. */
+  uint32_t required( node const& n ) const
+  {
+    return this->depth() - reverse_level( n );
+  }
+
+  /*! \brief Difference between the required time and the level of `n` (negative if `n` is deeper than the depth). */
+  int32_t slack( node const& n ) const
+  {
+    return static_cast<int32_t>( required( n ) ) - static_cast<int32_t>( this->level( n ) );
+  }
+
+  void create_po( signal const& f )
+  {
+    depth_view<Ntk, NodeCostFn>::create_po( f );
+    add_po_driver( this->get_node( f ) );
+    propagate_required();
+  }
+
+  void substitute_node( node const& old_node, signal const& new_signal )
+  {
+    Ntk::substitute_node( old_node, new_signal );
+
+    /* outputs may have been redirected to the new node or to simplified parents */
+    auto i = 0u;
+    this->foreach_co( [&]( auto const& f ) {
+      auto const n = this->get_node( f );
+      if ( _po_drivers[i] != n )
+      {
+        --_po_refs[_po_drivers[i]];
+        schedule( _po_drivers[i] );
+        ++_po_refs[n];
+        schedule( n );
+        _po_drivers[i] = n;
+      }
+      ++i;
+    } );
+    propagate_required();
+  }
+
+  /*! \brief Recomputes all reverse levels and output drivers. */
+  void update_required()
+  {
+    _rlevels.reset( no_path );
+    _po_refs.reset( 0u );
+    _po_drivers.clear();
+    this->foreach_co( [&]( auto const& f ) {
+      auto const n = this->get_node( f );
+      ++_po_refs[n];
+      _rlevels[n] = 0u;
+      _po_drivers.push_back( n );
+    } );
+
+    /* fanouts have higher levels than their fanins (with positive costs) */
+    std::vector<node> gates;
+    gates.reserve( this->num_gates() );
+    this->foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+    std::sort( gates.begin(), gates.end(), [&]( auto const& a, auto const& b ) {
+      return this->level( a ) > this->level( b ) || ( this->level( a ) == this->level( b ) && a > b );
+    } );
+    for ( auto const& n : gates )
+    {
+      if ( _rlevels[n] == no_path )
+      {
+        continue;
+      }
+
+      auto const rlevel = _rlevels[n] + _cost_fn( *this, n );
+      this->foreach_fanin( n, [&]( auto const& f ) {
+        auto& frlevel = _rlevels[f];
+        frlevel = frlevel == no_path ? rlevel : std::max( frlevel, rlevel );
+      } );
+    }
+  }
+
+private:
+  static constexpr uint32_t no_path = std::numeric_limits<uint32_t>::max();
+
+  static depth_view_params incremental_params( depth_view_params ps )
+  {
+    ps.incremental = true;
+    return ps;
+  }
+
+  void register_events()
+  {
+    /* registered after the events of the depth view, so that fanouts and levels are up to date */
+    add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
+      _rlevels.resize( no_path );
+      _po_refs.resize( 0u );
+      schedule_fanins( n );
+      propagate_required();
+    } );
+    modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+      for ( auto const& f : previous )
+      {
+        schedule( this->get_node( f ) );
+      }
+      schedule_fanins( n );
+      propagate_required();
+    } );
+    delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
+      schedule_fanins( n );
+      propagate_required();
+    } );
+  }
+
+  void release_events()
+  {
+    Ntk::events().release_add_event( add_event );
+    Ntk::events().release_modified_event( modified_event );
+    Ntk::events().release_delete_event( delete_event );
+  }
+
+  void add_po_driver( node const& n )
+  {
+    _po_refs.resize( 0u );
+    ++_po_refs[n];
+    _po_drivers.push_back( n );
+    schedule( n );
+  }
+
+  uint32_t compute_required( node const& n ) const
+  {
+    uint32_t rlevel = _po_refs[n] > 0u ? 0u : no_path;
+    this->_fanout->foreach_fanout( n, [&]( auto const& p ) {
+      if ( this->is_dead( p ) || _rlevels[p] == no_path )
+      {
+        return;
+      }
+      auto const prlevel = _rlevels[p] + _cost_fn( *this, p );
+      rlevel = rlevel == no_path ? prlevel : std::max( rlevel, prlevel );
+    } );
+    return rlevel;
+  }
+
+  void schedule_fanins( node const& n )
+  {
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      schedule( this->get_node( f ) );
+    } );
+  }
+
+  /* schedules a node for a reverse level update in the bucket of its level */
+  void schedule( node const& n )
+  {
+    if ( this->is_dead( n ) )
+    {
+      return;
+    }
+
+    auto const index = this->node_to_index( n );
+    if ( index >= _queued.size() )
+    {
+      _queued.resize( this->size(), false );
+    }
+    if ( _queued[index] )
+    {
+      return;
+    }
+    _queued[index] = true;
+
+    auto const level = this->level( n );
+    if ( level >= _buckets.size() )
+    {
+      _buckets.resize( level + 1u );
+    }
+    _buckets[level].push_back( n );
+    _last_bucket = std::max<uint32_t>( _last_bucket, level );
+    ++_num_scheduled;
+  }
+
+  /* updates the reverse levels of the scheduled nodes and of their transitive fanin, in decreasing level order */
+  void propagate_required()
+  {
+    while ( _num_scheduled > 0u )
+    {
+      auto& bucket = _buckets[_last_bucket];
+      if ( bucket.empty() )
+      {
+        --_last_bucket;
+        continue;
+      }
+
+      auto const n = bucket.back();
+      bucket.pop_back();
+      --_num_scheduled;
+      _queued[this->node_to_index( n )] = false;
+
+      if ( this->is_dead( n ) )
+      {
+        continue;
+      }
+
+      auto const rlevel = compute_required( n );
+      if ( rlevel == _rlevels[n] )
+      {
+        continue;
+      }
+      _rlevels[n] = rlevel;
+
+      /* fanins are scheduled in the bucket of their level, possibly after `_last_bucket` */
+      schedule_fanins( n );
+    }
+    _last_bucket = 0u;
+  }
+
+  node_map<uint32_t, Ntk> _rlevels;
+  node_map<uint32_t, Ntk> _po_refs;
+  std::vector<node> _po_drivers;
+  NodeCostFn _cost_fn;
+
+  std::vector<std::vector<node>> _buckets;
+  std::vector<bool> _queued;
+  uint32_t _last_bucket{ 0u };
+  uint64_t _num_scheduled{ 0u };
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+template<class T>
+required_view( T const& ) -> required_view<T>;
+
+template<class T, class NodeCostFn = unit_cost<T>>
+required_view( T const&, NodeCostFn const&, depth_view_params const& ) -> required_view<T, NodeCostFn>;
+
+} // namespace mockturtle
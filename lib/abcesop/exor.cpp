@@ -58,9 +58,9 @@ namespace abc::exorcism {
 ////////////////////////////////////////////////////////////////////////
 
 // information about the cube cover
-cinfo g_CoverInfo;
+thread_local cinfo g_CoverInfo;
 
-extern int s_fDecreaseLiterals;
+extern thread_local int s_fDecreaseLiterals;
 
 ////////////////////////////////////////////////////////////////////////
 ///                       EXTERNAL FUNCTIONS                         ///
@@ -964,6 +964,8 @@ int Abc_ExorcismMain( Vec_Wec_t * vEsop, int nIns, int nOuts, std::function<void
     g_CoverInfo.Verbosity = Verbosity;
     g_CoverInfo.nCubesMax = nCubesMax;
     g_CoverInfo.fUseQCost = fUseQCost;
+    // the state is kept per thread, reset it such that the result does not depend on earlier calls
+    s_fDecreaseLiterals = 0;
     if ( fUseQCost )
         s_fDecreaseLiterals = 1;
     if ( g_CoverInfo.Verbosity )
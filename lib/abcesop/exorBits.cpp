@@ -38,6 +38,8 @@
 ///                  http://vlsi.colorado.edu/~fabio/                ///
 ////////////////////////////////////////////////////////////////////////
 
+#include <mutex>
+
 #include "eabc/exor.h"
 
 namespace abc::exorcism {
@@ -54,7 +56,7 @@ namespace abc::exorcism {
 // the number of cubes is constantly updated when the cube cover is processed
 // in this module, only the number of variables (nVarsIn) and integers (nWordsIn)
 // is used, which do not change
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 
 ////////////////////////////////////////////////////////////////////////
 ///                  FUNCTIONS OF THIS MODULE                        ///
@@ -150,7 +152,11 @@ unsigned char BitCount[FULL16BITS];
 
 void PrepareBitSetModule()
 // this function should be called before anything is done with the cube cover
+// the tables are shared by all threads, so they are computed only once
 {   
+    static std::once_flag fPrepared;
+    std::call_once( fPrepared, []()
+    {
     // prepare bit count
     int i, k;
     int nLimit;
@@ -164,6 +170,7 @@ void PrepareBitSetModule()
     // prepare bit groups
     for ( k = 0; k < 163; k++ )
         BitGroupNumbers[ SparseNumbers[k] ] = k;
+    } );
 /*
     // verify bit groups
     int n = 4368;
@@ -213,10 +220,10 @@ void ExorVar( Cube * pC, int Var, varvalue Val )
 ///                      FUNCTION DEFINITIONS                        ///
 ////////////////////////////////////////////////////////////////////////
 
-static int DiffVarCounter, cVars;
-static drow Temp1, Temp2, Temp;
-static drow LastNonZeroWord;
-static int LastNonZeroWordNum;
+static thread_local int DiffVarCounter, cVars;
+static thread_local drow Temp1, Temp2, Temp;
+static thread_local drow LastNonZeroWord;
+static thread_local int LastNonZeroWordNum;
 
 int GetDistance( Cube * pC1, Cube * pC2 )
 // finds and returns the distance between two cubes pC1 and pC2
@@ -245,10 +252,10 @@ int GetDistance( Cube * pC1, Cube * pC2 )
 }
 
 // place to put the number of the different variable and its value in the second cube
-extern int s_DiffVarNum;
-extern int s_DiffVarValueP_old;
-extern int s_DiffVarValueP_new;
-extern int s_DiffVarValueQ;
+extern thread_local int s_DiffVarNum;
+extern thread_local int s_DiffVarValueP_old;
+extern thread_local int s_DiffVarValueP_new;
+extern thread_local int s_DiffVarValueQ;
 
 int GetDistancePlus( Cube * pC1, Cube * pC2 )
 // finds and returns the distance between two cubes pC1 and pC2
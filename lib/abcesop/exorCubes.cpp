@@ -53,7 +53,7 @@ namespace abc::exorcism {
 ////////////////////////////////////////////////////////////////////////
 
 // information about the cube cover before and after simplification
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 
 ////////////////////////////////////////////////////////////////////////
 ///                    FUNCTIONS OF THIS MODULE                      ///
@@ -78,10 +78,10 @@ Cube * GetFreeCube();
 ////////////////////////////////////////////////////////////////////////
 
 // the pointer to the allocated memory
-Cube ** s_pCoverMemory;
+thread_local Cube ** s_pCoverMemory;
 
 // the list of free cubes
-Cube * s_CubesFree;
+thread_local Cube * s_CubesFree;
 
 ///////////////////////////////////////////////////////////////////
 ///                  CUBE COVER MEMORY MANAGEMENT                //
@@ -54,7 +54,7 @@ namespace abc::exorcism {
 ////////////////////////////////////////////////////////////////////////
 
 // information about options and the cover
-extern cinfo g_CoverInfo;
+extern thread_local cinfo g_CoverInfo;
 
 // the look-up table for the number of 1's in unsigned short
 extern unsigned char BitCount[];
@@ -176,9 +176,9 @@ int IteratorCubePairNext();
 ////////////////////////////////////////////////////////////////////////`
 
 // the number of allocated places
-int s_nPosAlloc;
+thread_local int s_nPosAlloc;
 // the maximum number of occupied places
-int s_nPosMax[3];
+thread_local int s_nPosMax[3];
 
 ////////////////////////////////////////////////////////////////////////
 ///                      Minimization Strategy                       ///
@@ -211,12 +211,12 @@ int s_nPosMax[3];
 ////////////////////////////////////////////////////////////////////////
 
 // Cube set is a list of cubes
-static Cube* s_List;
+static thread_local Cube* s_List;
 
 ///////////////////////////////////////////////////////////////////////////
 // undo information
 ///////////////////////////////////////////////////////////////////////////
-static struct
+static thread_local struct
 {
     int fInput;   // 1 if the input was changed
     Cube* p;      // the pointer to the modified cube
@@ -234,34 +234,34 @@ static struct
 // enable pair accumulation
 // from the begginning (while the starting cover is generated)
 // only the distance 2 accumulation is enabled
-static int s_fDistEnable2 = 1;
-static int s_fDistEnable3;
-static int s_fDistEnable4;
+static thread_local int s_fDistEnable2 = 1;
+static thread_local int s_fDistEnable3;
+static thread_local int s_fDistEnable4;
 
 // temporary storage for cubes generated by the ExorLink iterator
-static Cube* s_CubeGroup[5];
+static thread_local Cube* s_CubeGroup[5];
 // the marks telling whether the given cube is inserted
-static int s_fInserted[5];
+static thread_local int s_fInserted[5];
 
 // enable selection only those Dist2 and Dist3 that do not increase literals
-int s_fDecreaseLiterals = 0;
+thread_local int s_fDecreaseLiterals = 0;
 
 // the counters for display
-static int s_cEnquequed;
-static int s_cAttempts;
-static int s_cReshapes;
+static thread_local int s_cEnquequed;
+static thread_local int s_cAttempts;
+static thread_local int s_cReshapes;
 
 // the number of cubes before ExorLink starts
-static int s_nCubesBefore;
+static thread_local int s_nCubesBefore;
 // the distance code specific for each ExorLink
-static cubedist s_Dist;
+static thread_local cubedist s_Dist;
 
 // other variables
-static int s_Gain;
-static int s_GainTotal;
-static int s_GroupCounter;
-static int s_GroupBest;
-static Cube *s_pC1, *s_pC2;
+static thread_local int s_Gain;
+static thread_local int s_GainTotal;
+static thread_local int s_GroupCounter;
+static thread_local int s_GroupBest;
+static thread_local Cube *s_pC1, *s_pC2;
 
 ////////////////////////////////////////////////////////////////////////
 ///                  Iterative ExorLink Operation                    ///
@@ -633,12 +633,12 @@ END_OF_LOOP: {}
 }
 
 // local static variables
-Cube* s_q;
-int s_Distance;
-int s_DiffVarNum;
-int s_DiffVarValueP_old;
-int s_DiffVarValueP_new;
-int s_DiffVarValueQ;
+thread_local Cube* s_q;
+thread_local int s_Distance;
+thread_local int s_DiffVarNum;
+thread_local int s_DiffVarValueP_old;
+thread_local int s_DiffVarValueP_new;
+thread_local int s_DiffVarValueQ;
 
 int CheckForCloseCubes( Cube* p, int fAddCube )
 // checks the cube storage for a cube that is dist-0 and dist-1 removed 
@@ -871,7 +871,7 @@ Cube* CubeExtract( Cube* p )
 ///////////////////////////////////////////////////////////////////
 
 // the iterator starts from the Head and stops when it sees NULL
-Cube* s_pCubeLast;
+thread_local Cube* s_pCubeLast;
 
 ///////////////////////////////////////////////////////////////////
 ///                     Cube Set Iterator                       ///
@@ -914,7 +914,7 @@ typedef struct
     int  fEmpty;     // this flag is 1 if there is nothing in the queque
 } que;
 
-static que s_Que[3];  // Dist-2, Dist-3, Dist-4 queques
+static thread_local que s_Que[3];  // Dist-2, Dist-3, Dist-4 queques
 
 // the number of allocated places
 //int s_nPosAlloc;
@@ -1006,7 +1006,7 @@ int GetQuequeStats( cubedist Dist )
 
 // iterating through the queque (with authomatic garbage collection)
 // only one iterator can be active at a time
-static struct
+static thread_local struct
 {
     int fStarted;    // status of the iterator (1 if working)
     cubedist Dist;   // the currently iterated queque
@@ -1017,8 +1017,8 @@ static struct
     int CutValue;    // the number of literals below which the cubes are not used
 } s_Iter;
 
-static que* pQ;
-static Cube *p1, *p2;
+static thread_local que* pQ;
+static thread_local Cube *p1, *p2;
 
 int IteratorCubePairStart( cubedist CubeDist, Cube** ppC1, Cube** ppC2 )
 // start an iterator through cubes of dist CubeDist,
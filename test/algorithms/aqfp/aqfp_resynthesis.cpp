@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <cstring>
 #include <optional>
 #include <set>
 
@@ -184,3 +185,105 @@ TEST_CASE( "AQFP delay-oriented resynthesis", "[aqfp_resyn]" )
   auto actual_cost = cost_fn( aqfp, res.node_level, res.po_level );
   CHECK( 142u == actual_cost );
 }
+
+TEST_CASE( "AQFP database in binary format", "[aqfp_resyn]" )
+{
+  auto klut = get_test_klut();
+
+  mockturtle::aqfp_assumptions assume = { false, false, true, 4u };
+  std::unordered_map<uint32_t, double> gate_costs = { { 3u, 6.0 }, { 5u, 10.0 } };
+  std::unordered_map<uint32_t, double> splitters = { { 1u, 2.0 }, { assume.splitter_capacity, 2.0 } };
+
+  mockturtle::aqfp_db<> db( gate_costs, splitters );
+  std::stringstream ss( get_database() );
+  db.load_db( ss );
+
+  std::stringstream bin;
+  db.save_binary_db( bin );
+
+  mockturtle::aqfp_db<> db_bin( gate_costs, splitters );
+  CHECK( db_bin.load_binary_db( bin ) );
+
+  /* used in place from a buffer */
+  auto const buffer = bin.str();
+  mockturtle::aqfp_db<> db_view( gate_costs, splitters );
+  CHECK( db_view.load_binary_db( buffer.data(), buffer.size() ) );
+
+  std::stringstream bin_view;
+  db_view.save_binary_db( bin_view );
+  CHECK( bin_view.str() == buffer );
+
+  /* merged into a non-empty database */
+  mockturtle::aqfp_db<> db_merged( gate_costs, splitters );
+  std::stringstream ss_merged( get_database() );
+  db_merged.load_db( ss_merged );
+  CHECK( db_merged.load_binary_db( buffer.data(), buffer.size() ) );
+
+  auto truncated = buffer;
+  truncated.resize( truncated.size() - 8u );
+  mockturtle::aqfp_db<> db_truncated( gate_costs, splitters );
+  CHECK( !db_truncated.load_binary_db( truncated.data(), truncated.size() ) );
+
+  /* well-formed DAGs with fewer than 4 leaves or too many nodes, appended to
+     the DAG pool and used by all entries */
+  auto const load_with_dag = [&]( std::vector<uint8_t> const& dag ) {
+    auto corrupted = buffer;
+    uint32_t num_classes, num_entries, dag_pool_size;
+    std::memcpy( &num_classes, corrupted.data() + 12u, sizeof( uint32_t ) );
+    std::memcpy( &num_entries, corrupted.data() + 16u, sizeof( uint32_t ) );
+    std::memcpy( &dag_pool_size, corrupted.data() + 20u, sizeof( uint32_t ) );
+
+    auto const entries_pos = 24u + ( 1u << 16u ) * sizeof( uint32_t ) + num_classes * 16u;
+    uint64_t const dag_offset = dag_pool_size;
+    for ( auto e = 0u; e < num_entries; ++e )
+    {
+      std::memcpy( corrupted.data() + entries_pos + 24u * e + 16u, &dag_offset, sizeof( uint64_t ) );
+    }
+    corrupted.append( dag.begin(), dag.end() );
+    dag_pool_size += static_cast<uint32_t>( dag.size() );
+    std::memcpy( corrupted.data() + 20u, &dag_pool_size, sizeof( uint32_t ) );
+
+    mockturtle::aqfp_db<> db_corrupted( gate_costs, splitters );
+    return db_corrupted.load_binary_db( corrupted.data(), corrupted.size() );
+  };
+  CHECK( load_with_dag( { 4u, 0u, 1u, 2u, 3u, 0u, 4u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u } ) );
+  CHECK( !load_with_dag( { 2u, 0u, 1u, 0u, 0u, 0u } ) );
+
+  std::vector<uint8_t> large_dag = { 4u, 0u, 1u, 2u, 3u, 250u, 10u, 0u };
+  large_dag.resize( large_dag.size() + 250u + 260u * sizeof( uint32_t ), 0u ); /* gates without fanins and levels */
+  CHECK( !load_with_dag( large_dag ) );
+
+  std::stringstream invalid( get_database() );
+  mockturtle::aqfp_db<> db_invalid( gate_costs, splitters );
+  CHECK( !db_invalid.load_binary_db( invalid ) );
+
+  uint32_t num_entries = 0u, num_entries_bin = 0u, num_entries_view = 0u, num_entries_merged = 0u;
+  db.for_each_db_entry( [&]( auto, auto const&, double ) { ++num_entries; } );
+  db_bin.for_each_db_entry( [&]( auto, auto const&, double ) { ++num_entries_bin; } );
+  db_view.for_each_db_entry( [&]( auto, auto const&, double ) { ++num_entries_view; } );
+  db_merged.for_each_db_entry( [&]( auto, auto const&, double ) { ++num_entries_merged; } );
+  CHECK( num_entries == num_entries_bin );
+  CHECK( num_entries == num_entries_view );
+  CHECK( num_entries == num_entries_merged );
+
+  for ( auto strategy : { mockturtle::aqfp_node_resyn_strategy::area, mockturtle::aqfp_node_resyn_strategy::delay } )
+  {
+    mockturtle::aqfp_node_resyn_param ps{ assume, splitters, strategy };
+    mockturtle::aqfp_fanout_resyn fanout_resyn( assume );
+    mockturtle::aqfp_node_resyn node_resyn( db, ps );
+    mockturtle::aqfp_node_resyn node_resyn_bin( db_bin, ps );
+    mockturtle::aqfp_node_resyn node_resyn_merged( db_merged, ps );
+
+    mockturtle::aqfp_network aqfp, aqfp_bin, aqfp_merged;
+    auto res = mockturtle::aqfp_resynthesis( aqfp, klut, node_resyn, fanout_resyn );
+    auto res_bin = mockturtle::aqfp_resynthesis( aqfp_bin, klut, node_resyn_bin, fanout_resyn );
+    auto res_merged = mockturtle::aqfp_resynthesis( aqfp_merged, klut, node_resyn_merged, fanout_resyn );
+
+    CHECK( aqfp.num_gates() == aqfp_bin.num_gates() );
+    CHECK( res.node_level == res_bin.node_level );
+    CHECK( res.po_level == res_bin.po_level );
+    CHECK( aqfp.num_gates() == aqfp_merged.num_gates() );
+    CHECK( res.node_level == res_merged.node_level );
+    CHECK( res.po_level == res_merged.po_level );
+  }
+}
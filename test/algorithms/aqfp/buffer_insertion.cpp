@@ -108,4 +108,42 @@ TEST_CASE( "optimization with chunked movement", "[buffer_insertion]" )
   CHECK( verify_aqfp_buffer( buffered_ntk, ps.assume, buffering.pi_levels() ) == true );
   CHECK( num_buf_opt < num_buf_asap );
 }
+
+TEST_CASE( "multi-threaded scheduling and chunked movement", "[buffer_insertion]" )
+{
+  aig_network aig_ntk;
+  auto const read = lorina::read_aiger( fmt::format( "{}/c432.aig", BENCHMARKS_PATH ), aiger_reader( aig_ntk ) );
+  CHECK( read == lorina::return_code::success );
+
+  buffer_insertion_params ps;
+  ps.optimization_effort = buffer_insertion_params::until_sat;
+
+  for ( auto const scheduling : { buffer_insertion_params::ASAP, buffer_insertion_params::ALAP_depth } )
+  {
+    ps.scheduling = scheduling;
+    ps.num_threads = 1u;
+    buffer_insertion buffering_st( aig_ntk, ps );
+    buffering_st.schedule();
+    buffering_st.count_buffers();
+    auto const num_buf_scheduled = buffering_st.num_buffers();
+
+    ps.num_threads = 4u;
+    buffer_insertion buffering_mt( aig_ntk, ps );
+    buffering_mt.schedule();
+    buffering_mt.count_buffers();
+    CHECK( buffering_mt.depth() == buffering_st.depth() );
+    CHECK( buffering_mt.po_levels() == buffering_st.po_levels() );
+    aig_ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( buffering_mt.level( n ) == buffering_st.level( n ) );
+    } );
+
+    buffering_mt.optimize();
+    buffering_mt.count_buffers();
+    CHECK( buffering_mt.num_buffers() < num_buf_scheduled );
+
+    buffered_aig_network buffered_ntk;
+    buffering_mt.dump_buffered_network( buffered_ntk );
+    CHECK( verify_aqfp_buffer( buffered_ntk, ps.assume, buffering_mt.pi_levels() ) == true );
+  }
+}
 #endif
@@ -159,3 +159,62 @@ TEST_CASE( "SOP balance XAG adder", "[balancing]" )
   auto const miter_ntk = *miter<xag_network>( xag, res );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "Rebalance with concurrently precomputed decompositions", "[balancing]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> as( 8u ), bs( 8u );
+  std::generate( as.begin(), as.end(), [&]() { return xag.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return xag.create_pi(); } );
+  auto carry = xag.get_constant( false );
+  carry_ripple_adder_inplace( xag, as, bs, carry );
+  std::for_each( as.begin(), as.end(), [&]( auto const& f ) { xag.create_po( f ); } );
+
+  balancing_params ps;
+  balancing_stats st;
+  const auto xag_serial = balancing( xag, { esop_rebalancing<xag_network>{} }, ps );
+
+  esop_rebalancing<xag_network> esop{};
+  ps.num_threads = 4u;
+  const auto xag_parallel = balancing( xag, { esop }, esop.precompute_function(), ps, &st );
+
+  CHECK( depth_view{ xag_parallel }.depth() == depth_view{ xag_serial }.depth() );
+  CHECK( xag_parallel.num_gates() == xag_serial.num_gates() );
+  CHECK( *equivalence_checking( *miter<xag_network>( xag, xag_parallel ) ) );
+
+  /* the cache is shared with the copies stored in the rebalancing and precomputation functions */
+  const auto num_cached = esop.cache->size();
+  CHECK( num_cached > 0u );
+  CHECK( esop.cache->hits() > 0u );
+
+  /* a second run reuses all cached decompositions */
+  sop_rebalancing<xag_network> sop{};
+  const auto aig_first = balancing( xag, { sop }, sop.precompute_function(), ps );
+  const auto misses = sop.cache->misses();
+  const auto aig_second = balancing( xag, { sop }, sop.precompute_function(), ps );
+  CHECK( sop.cache->misses() == misses );
+  CHECK( aig_first.num_gates() == aig_second.num_gates() );
+}
+
+TEST_CASE( "SOP balancing reuses the covers computed during mapping", "[balancing]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> as( 8u ), bs( 8u );
+  std::generate( as.begin(), as.end(), [&]() { return aig.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, as, bs, carry );
+  std::for_each( as.begin(), as.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+
+  lut_map_params ps;
+  ps.decompositions = std::make_shared<decomposition_cache>();
+  const auto aig_shared = sop_balancing( aig, ps );
+
+  /* the decomposition of the mapping looks up the covers computed during mapping */
+  CHECK( ps.decompositions->size() > 0u );
+  CHECK( ps.decompositions->hits() > 0u );
+
+  const auto aig_default = sop_balancing( aig );
+  CHECK( depth_view{ aig_shared }.depth() == depth_view{ aig_default }.depth() );
+  CHECK( *equivalence_checking( *miter<aig_network>( aig, aig_shared ) ) );
+}
@@ -1,4 +1,5 @@
 #include <catch.hpp>
+#include <random>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -16,6 +17,7 @@
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/traits.hpp>
 #include <mockturtle/views/names_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
 
 using namespace mockturtle;
 
@@ -350,3 +352,110 @@ TEST_CASE( "cleanup crossed network", "[cleanup]" )
   CHECK( crossed_simulation[1] == cleaned_crossed_simulation[1] );
   CHECK( crossed_simulation[2] == cleaned_crossed_simulation[2] );
 }
+
+template<class Ntk>
+void test_bulk_cleanup()
+{
+  using signal = typename Ntk::signal;
+
+  Ntk ntk;
+  std::vector<signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+
+  std::mt19937 rng( 42u );
+  auto const random_signal = [&]() {
+    auto const f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    return ( rng() & 1 ) ? !f : f;
+  };
+
+  /* more gates than a chunk of the parallel fanin rewriting */
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    auto const a = random_signal();
+    auto const b = random_signal();
+    auto const c = random_signal();
+    switch ( rng() % 3u )
+    {
+    case 0u:
+      fs.push_back( ntk.create_and( a, b ) );
+      break;
+    case 1u:
+      fs.push_back( ntk.create_xor( a, b ) );
+      break;
+    default:
+      fs.push_back( ntk.create_or( ntk.create_and( a, b ), c ) );
+      break;
+    }
+  }
+
+  for ( auto i = 0u; i < 10u; ++i )
+  {
+    ntk.create_po( fs[fs.size() - 1u - 13u * i] );
+  }
+  ntk.create_po( fs[0] );
+
+  /* substitutions with newer gates break the topological order of the indices */
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    auto const n = ntk.get_node( fs[8u + 10u * i] );
+    auto const g = ntk.create_and( fs[i % 8u], !fs[( 3u * i + 1u ) % 8u] );
+    if ( !ntk.is_constant( n ) && !ntk.is_ci( n ) && !ntk.is_dead( n ) && ntk.get_node( g ) > n )
+    {
+      ntk.substitute_node( n, ( i & 1 ) ? !g : g );
+    }
+  }
+
+  auto const fast = cleanup_dangling( ntk );
+
+  Ntk ref;
+  std::vector<signal> pis;
+  ntk.foreach_pi( [&]( auto const& ) {
+    pis.push_back( ref.create_pi() );
+  } );
+  for ( auto const& f : cleanup_dangling( ntk, ref, pis.begin(), pis.end() ) )
+  {
+    ref.create_po( f );
+  }
+
+  /* the fast path creates the same network as the node by node copy */
+  REQUIRE( fast.size() == ref.size() );
+  CHECK( fast.num_gates() == ref.num_gates() );
+  fast.foreach_node( [&]( auto const& n ) {
+    CHECK( fast.fanout_size( n ) == ref.fanout_size( n ) );
+    fast.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      std::vector<signal> ref_fanins;
+      ref.foreach_fanin( n, [&]( auto const& g ) {
+        ref_fanins.push_back( g );
+      } );
+      CHECK( f == ref_fanins[i] );
+    } );
+  } );
+  fast.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == ref.po_at( i ) );
+  } );
+  fast.foreach_gate( [&]( auto const& n ) {
+    CHECK( fast._storage->hash.at( fast._storage->nodes[n] ) == n );
+  } );
+
+  CHECK( simulate<kitty::static_truth_table<8u>>( fast ) == simulate<kitty::static_truth_table<8u>>( topo_view{ ntk } ) );
+
+  /* the result does not depend on the number of threads */
+  auto const parallel = cleanup_dangling( ntk, false, false, 4u );
+  REQUIRE( parallel.size() == fast.size() );
+  parallel.foreach_gate( [&]( auto const& n ) {
+    parallel.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      CHECK( f == fast._storage->nodes[n].children[i] );
+    } );
+  } );
+}
+
+TEST_CASE( "fast cleanup of structurally hashed networks", "[cleanup]" )
+{
+  test_bulk_cleanup<aig_network>();
+  test_bulk_cleanup<xag_network>();
+  test_bulk_cleanup<mig_network>();
+  test_bulk_cleanup<xmg_network>();
+}
@@ -1,13 +1,17 @@
 #include <catch.hpp>
 
 #include <iostream>
+#include <random>
+#include <vector>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/cnf_cut.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/utils/choice_classes.hpp>
 
 using namespace mockturtle;
 
@@ -139,6 +143,61 @@ TEST_CASE( "compute truth tables of AIG cuts", "[cut_enumeration]" )
   CHECK( cuts.truth_table( cuts.cuts( i4 )[3] )._bits[0] == 0x0d );
 }
 
+TEST_CASE( "enumerate cuts of an AIG with structural choices", "[cut_enumeration]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( b, c );
+  const auto f4 = aig.create_and( a, f3 );
+  const auto f5 = aig.create_nand( f4, a );
+  aig.create_po( f5 );
+
+  /* f4 is the only structure used by the output */
+  choice_classes choices( aig, { { aig.get_node( f4 ), f2 } } );
+  const auto cuts = choice_cut_enumeration<aig_network, true>( aig, choices );
+
+  const auto to_vector = []( auto const& cut ) {
+    return std::vector<uint32_t>( cut.begin(), cut.end() );
+  };
+
+  const auto i1 = aig.node_to_index( aig.get_node( f1 ) );
+  const auto i2 = aig.node_to_index( aig.get_node( f2 ) );
+  const auto i3 = aig.node_to_index( aig.get_node( f3 ) );
+  const auto i5 = aig.node_to_index( aig.get_node( f5 ) );
+
+  /* the representative f2 has the cuts of both structures */
+  std::vector<std::vector<uint32_t>> cuts2;
+  for ( auto const& cut : cuts.cuts( i2 ) )
+  {
+    cuts2.push_back( to_vector( *cut ) );
+  }
+  CHECK( cuts2.size() == 4u );
+  CHECK( std::find( cuts2.begin(), cuts2.end(), std::vector<uint32_t>{ 1, 2, 3 } ) != cuts2.end() );
+  CHECK( std::find( cuts2.begin(), cuts2.end(), std::vector<uint32_t>{ 3, i1 } ) != cuts2.end() );
+  CHECK( std::find( cuts2.begin(), cuts2.end(), std::vector<uint32_t>{ 1, i3 } ) != cuts2.end() );
+  CHECK( std::find( cuts2.begin(), cuts2.end(), std::vector<uint32_t>{ i2 } ) != cuts2.end() );
+
+  /* the fanin f4 of f5 is replaced by its representative */
+  CHECK( to_vector( cuts.cuts( i5 )[0] ) == std::vector<uint32_t>{ 1, i2 } );
+  CHECK( cuts.truth_table( cuts.cuts( i5 )[0] )._bits[0] == 0x8 ); /* the node of the NAND */
+  for ( auto const& cut : cuts.cuts( i2 ) )
+  {
+    if ( cut->size() == 3u )
+    {
+      CHECK( cuts.truth_table( *cut )._bits[0] == 0x80 );
+    }
+    else if ( cut->size() == 2u )
+    {
+      CHECK( cuts.truth_table( *cut )._bits[0] == 0x8 );
+    }
+  }
+}
+
 TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
 {
   klut_network klut;
@@ -181,6 +240,50 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+TEST_CASE( "compute cut data from truth tables with several threads", "[cut_enumeration]" )
+{
+  /* wide layers, such that the cuts of a layer are computed concurrently */
+  aig_network aig;
+  std::vector<aig_network::signal> prev, next;
+  for ( auto i = 0u; i < 128u; ++i )
+  {
+    prev.push_back( aig.create_pi() );
+  }
+  std::mt19937 rng( 13u );
+  for ( auto layer = 0u; layer < 8u; ++layer )
+  {
+    next.clear();
+    for ( auto i = 0u; i < 128u; ++i )
+    {
+      auto const a = prev[rng() % prev.size()];
+      auto const b = prev[rng() % prev.size()];
+      next.push_back( ( rng() & 1 ) ? aig.create_xor( a, !b ) : aig.create_and( !a, b ) );
+    }
+    prev = next;
+  }
+  for ( auto const& f : prev )
+  {
+    aig.create_po( f );
+  }
+
+  cut_enumeration_params ps;
+  const auto cuts1 = fast_cut_enumeration<aig_network, 4, true, cut_enumeration_cnf_cut>( aig, ps );
+  ps.num_threads = 4u;
+  const auto cuts4 = fast_cut_enumeration<aig_network, 4, true, cut_enumeration_cnf_cut>( aig, ps );
+
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const& set1 = cuts1.cuts( aig.node_to_index( n ) );
+    auto const& set4 = cuts4.cuts( aig.node_to_index( n ) );
+    REQUIRE( set1.size() == set4.size() );
+    for ( auto i = 0u; i < set1.size(); ++i )
+    {
+      CHECK( std::vector<uint32_t>( set1[i].begin(), set1[i].end() ) == std::vector<uint32_t>( set4[i].begin(), set4[i].end() ) );
+      CHECK( set1[i]->data.cost == set4[i]->data.cost );
+      CHECK( cuts1.truth_table( set1[i] ) == cuts4.truth_table( set4[i] ) );
+    }
+  } );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/cut_rewriting.hpp>
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/exact.hpp>
@@ -7,6 +10,7 @@
 #include <mockturtle/algorithms/node_resynthesis/xag_minmc2.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg3_npn.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -461,3 +465,37 @@ TEST_CASE( "Cut rewriting with stacked depth-fanout views", "[cut_rewriting]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "Multi-threaded in-place cut rewriting", "[cut_rewriting]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    aig.create_po( aig.create_maj( a[i], b[i], a[( i + 1 ) % 6] ) );
+    aig.create_po( aig.create_xor( aig.create_and( a[i], b[( i + 2 ) % 6] ), aig.create_or( a[i], b[i] ) ) );
+  }
+
+  xag_npn_resynthesis<aig_network> resyn;
+  cut_rewriting_params ps;
+  ps.cut_enumeration_ps.cut_size = 4;
+
+  auto aig1 = cleanup_dangling( aig );
+  cut_rewriting_with_compatibility_graph( aig1, resyn, ps );
+
+  ps.num_threads = 4u;
+  auto aig4 = cleanup_dangling( aig );
+  cut_rewriting_with_compatibility_graph( aig4, resyn, ps );
+
+  CHECK( aig1.size() == aig4.size() );
+
+  aig1 = cleanup_dangling( aig1 );
+  aig4 = cleanup_dangling( aig4 );
+  CHECK( aig4.num_gates() < aig.num_gates() );
+  CHECK( aig1.num_gates() == aig4.num_gates() );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( aig4, sim ) );
+}
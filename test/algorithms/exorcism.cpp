@@ -1,6 +1,9 @@
 #include <catch.hpp>
 
+#include <vector>
+
 #include <mockturtle/algorithms/exorcism.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
 
 using namespace mockturtle;
 
@@ -19,3 +22,25 @@ TEST_CASE( "Call exorcism on 4-input function", "[exorcism]" )
     CHECK( func == func2 );
   }
 }
+
+TEST_CASE( "Call exorcism from several threads", "[exorcism]" )
+{
+  std::vector<kitty::dynamic_truth_table> funcs( 200u, kitty::dynamic_truth_table( 6u ) );
+  for ( auto& func : funcs )
+  {
+    kitty::create_random( func );
+  }
+
+  std::vector<std::vector<kitty::cube>> serial( funcs.size() );
+  for ( auto i = 0u; i < funcs.size(); ++i )
+  {
+    serial[i] = exorcism( funcs[i] );
+  }
+
+  std::vector<std::vector<kitty::cube>> parallel( funcs.size() );
+  parallel_for( 4u, funcs.size(), [&]( uint64_t i, uint32_t ) {
+    parallel[i] = exorcism( funcs[i] );
+  } );
+
+  CHECK( parallel == serial );
+}
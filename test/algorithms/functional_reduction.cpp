@@ -3,6 +3,7 @@
 #include <kitty/static_truth_table.hpp>
 
 #include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
 #include <mockturtle/algorithms/functional_reduction.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -129,3 +130,79 @@ TEST_CASE( "functional reduction on XMG", "[functional_reduction]" )
   CHECK( ntk.size() == 9 );
   CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
 }
+
+TEST_CASE( "functional reduction with structural choices on AIG", "[functional_reduction]" )
+{
+  aig_network ntk;
+
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto c = ntk.create_pi();
+  const auto d = ntk.create_pi();
+
+  const auto f1 = ntk.create_and( ntk.create_and( a, b ), ntk.create_and( c, d ) );
+  const auto f2 = ntk.create_and( ntk.create_and( a, c ), ntk.create_and( b, d ) );
+  const auto f3 = ntk.create_or( ntk.create_and( a, !b ), ntk.create_and( !a, b ) );
+  const auto f4 = ntk.create_or( ntk.create_and( a, b ), ntk.create_and( !a, !b ) );
+
+  ntk.create_po( f1 );
+  ntk.create_po( f2 );
+  ntk.create_po( ntk.create_and( f3, c ) );
+  ntk.create_po( ntk.create_and( f4, d ) );
+  // f1 == f2, f3 == !f4
+
+  auto vals = simulate<kitty::static_truth_table<4>>( ntk );
+
+  const auto choices = functional_choices( ntk );
+  CHECK( choices.num_classes() == 2u );
+  CHECK( choices.num_choices() == 2u );
+  CHECK( ntk.num_gates() == 8u );
+  CHECK( vals == simulate<kitty::static_truth_table<4>>( ntk ) );
+
+  /* the substituted nodes are kept as choices */
+  CHECK( choices.representative( ntk.get_node( f2 ) ) == ntk.get_node( f1 ) );
+  CHECK( choices.representative( ntk.get_node( f4 ) ) == ntk.get_node( f3 ) );
+  CHECK( choices.phase( ntk.get_node( f4 ) ) == ( ntk.is_complemented( f3 ) == ntk.is_complemented( f4 ) ) );
+  CHECK( ntk.is_dead( ntk.get_node( f1 ) ) != ntk.is_dead( ntk.get_node( f2 ) ) );
+  CHECK( ntk.is_dead( ntk.get_node( f3 ) ) != ntk.is_dead( ntk.get_node( f4 ) ) );
+
+  /* all nodes in the order of the choices, including dead members, have their functions */
+  std::vector<kitty::static_truth_table<4>> tts( ntk.size() );
+  for ( auto const& n : choices.topological_order() )
+  {
+    if ( ntk.is_ci( n ) )
+    {
+      kitty::create_nth_var( tts[n], ntk.pi_index( n ) );
+    }
+    else if ( !ntk.is_constant( n ) )
+    {
+      std::vector<kitty::static_truth_table<4>> fanin_tts;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanin_tts.push_back( tts[ntk.get_node( f )] );
+      } );
+      tts[n] = ntk.compute( n, fanin_tts.begin(), fanin_tts.end() );
+    }
+  }
+  CHECK( tts[ntk.get_node( f2 )] == tts[ntk.get_node( f1 )] );
+  CHECK( tts[ntk.get_node( f4 )] == ~tts[ntk.get_node( f3 )] );
+
+  /* the cuts of the representatives implement the functions of their nodes */
+  const auto cuts = choice_cut_enumeration<aig_network, true>( ntk, choices );
+  CHECK( cuts.cuts( ntk.get_node( f1 ) ).size() > cuts.cuts( ntk.get_node( f2 ) ).size() );
+  for ( auto const& n : choices.topological_order() )
+  {
+    for ( auto const& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+    {
+      const auto tt = cuts.truth_table( *cut );
+      for ( auto m = 0u; m < 16u; ++m )
+      {
+        auto index = 0u, i = 0u;
+        for ( auto leaf : *cut )
+        {
+          index |= kitty::get_bit( tts[leaf], m ) << i++;
+        }
+        CHECK( kitty::get_bit( tt, index ) == kitty::get_bit( tts[n], m ) );
+      }
+    }
+  }
+}
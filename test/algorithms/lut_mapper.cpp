@@ -1,6 +1,11 @@
 #include <catch.hpp>
 
+#include <cstdint>
+#include <random>
+#include <vector>
+
 #include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/detail/incremental_timing.hpp>
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/lut_mapper.hpp>
 #include <mockturtle/algorithms/miter.hpp>
@@ -334,3 +339,103 @@ TEST_CASE( "LUT map remapping LUT network", "[lut_mapper]" )
   CHECK( mapped_ntk.num_cells() == 1 );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "Incremental required times match a full recomputation", "[lut_mapper]" )
+{
+  /* node i is implemented with some of the nodes 0 .. i - 1, the last nodes are outputs */
+  constexpr uint32_t num_nodes = 200u;
+  constexpr uint32_t num_inputs = 8u;
+  constexpr uint32_t required_outputs = 100u;
+  std::mt19937 rng( 42u );
+
+  std::vector<uint32_t> levels( num_nodes );
+  for ( auto i = 0u; i < num_nodes; ++i )
+  {
+    levels[i] = i;
+  }
+
+  std::vector<std::vector<uint32_t>> cover( num_nodes );
+  std::vector<uint32_t> delays( num_nodes, 0u );
+  auto const change_node = [&]( uint32_t i ) {
+    cover[i].clear();
+    for ( auto j = 0u; j < 1u + rng() % 4u; ++j )
+    {
+      cover[i].push_back( rng() % i );
+    }
+    delays[i] = 1u + rng() % 2u;
+  };
+  for ( auto i = num_inputs; i < num_nodes; ++i )
+  {
+    change_node( i );
+  }
+
+  auto const full_required_times = [&]() {
+    std::vector<uint32_t> required( num_nodes, UINT32_MAX >> 1 );
+    for ( auto i = num_nodes - 10u; i < num_nodes; ++i )
+    {
+      required[i] = required_outputs;
+    }
+    for ( auto i = num_nodes; i-- > num_inputs; )
+    {
+      for ( auto f : cover[i] )
+      {
+        required[f] = std::min( required[f], required[i] - delays[i] );
+      }
+    }
+    return required;
+  };
+
+  detail::incremental_required_times<uint64_t> timing( levels );
+  auto const record = [&]( uint32_t i ) {
+    timing.set_node( i, delays[i], cover[i].begin(), cover[i].end() );
+  };
+
+  auto required = full_required_times();
+  for ( auto i = num_inputs; i < num_nodes; ++i )
+  {
+    record( i );
+  }
+  timing.validate();
+
+  auto const recompute = [&]( uint32_t index ) {
+    uint32_t r = index >= num_nodes - 10u ? required_outputs : UINT32_MAX >> 1;
+    timing.foreach_fanout( index, [&]( uint32_t f ) {
+      r = std::min( r, required[f] - delays[f] );
+    } );
+    if ( r == required[index] )
+      return false;
+    required[index] = r;
+    return true;
+  };
+
+  for ( auto round = 0u; round < 20u; ++round )
+  {
+    if ( round % 5u == 4u )
+    {
+      /* the cover changes outside of the incremental update, as in area sharing: record it and start again */
+      for ( auto j = 0u; j < 20u; ++j )
+      {
+        change_node( num_inputs + rng() % ( num_nodes - num_inputs ) );
+      }
+      for ( auto i = num_inputs; i < num_nodes; ++i )
+      {
+        record( i );
+      }
+      timing.invalidate();
+      required = full_required_times();
+      timing.validate();
+    }
+    else
+    {
+      for ( auto j = 0u; j < 5u; ++j )
+      {
+        auto const i = num_inputs + rng() % ( num_nodes - num_inputs );
+        change_node( i );
+        record( i );
+      }
+      timing.update( recompute );
+    }
+
+    CHECK( required == full_required_times() );
+  }
+}
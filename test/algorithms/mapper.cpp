@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -375,6 +376,97 @@ TEST_CASE( "Map of sequential AIG", "[mapper]" )
   CHECK( st.delay < 1.9f + eps );
 }
 
+TEST_CASE( "Multi-threaded map", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3, classification_type::np_configurations> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  map_params ps;
+  map_stats st1;
+  binding_view<klut_network> luts1 = map( aig, lib, ps, &st1 );
+
+  ps.num_threads = 4u;
+  map_stats st4;
+  binding_view<klut_network> luts4 = map( aig, lib, ps, &st4 );
+
+  CHECK( luts1.size() == luts4.size() );
+  CHECK( luts1.num_gates() == luts4.num_gates() );
+  CHECK( st1.area == st4.area );
+  CHECK( st1.delay == st4.delay );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( luts4, sim ) );
+
+  xag_npn_resynthesis<aig_network> resyn;
+  exact_library<aig_network> exact_lib( resyn );
+
+  ps.num_threads = 1u;
+  map_stats st5;
+  aig_network res1 = map( aig, exact_lib, ps, &st5 );
+
+  ps.num_threads = 4u;
+  map_stats st6;
+  aig_network res4 = map( aig, exact_lib, ps, &st6 );
+
+  CHECK( res1.num_gates() == res4.num_gates() );
+  CHECK( st5.area == st6.area );
+  CHECK( st5.delay == st6.delay );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( res4, sim ) );
+}
+
+TEST_CASE( "Map with many area recovery rounds", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3, classification_type::np_configurations> lib( gates );
+
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  map_params ps;
+  map_stats st;
+  binding_view<klut_network> luts = map( aig, lib, ps, &st );
+
+  /* required times are updated incrementally between rounds */
+  ps.area_flow_rounds = 4u;
+  ps.ela_rounds = 6u;
+  ps.eswp_rounds = 2u;
+  map_stats st_rounds;
+  binding_view<klut_network> luts_rounds = map( aig, lib, ps, &st_rounds );
+
+  const float eps{ 0.005f };
+
+  CHECK( st_rounds.delay < st.delay + eps );
+  CHECK( st_rounds.area < st.area + eps );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( luts_rounds, sim ) );
+}
+
 TEST_CASE( "Exact map of bad MAJ3 and constant output", "[mapper]" )
 {
   mig_npn_resynthesis resyn{ true };
@@ -5,7 +5,9 @@
 #include <mockturtle/algorithms/node_resynthesis.hpp>
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/direct.hpp>
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xmg_npn.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -360,3 +362,111 @@ TEST_CASE( "Node resynthesis with direct synthesis", "[node_resynthesis]" )
     CHECK( simulate<kitty::dynamic_truth_table>( xmg, { 3u } )[0] == tt );
   }
 }
+
+TEST_CASE( "Node resynthesis with concurrent exact synthesis", "[node_resynthesis]" )
+{
+  kitty::dynamic_truth_table maj( 3 ), xor3( 3 ), mux( 3 );
+  kitty::create_majority( maj );
+  kitty::create_from_hex_string( xor3, "96" );
+  kitty::create_from_hex_string( mux, "d8" );
+
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto d = klut.create_pi();
+  const auto f1 = klut.create_node( { a, b, c }, maj );
+  const auto f2 = klut.create_node( { b, c, d }, maj );
+  const auto f3 = klut.create_node( { f1, f2, a }, xor3 );
+  const auto f4 = klut.create_node( { f3, c, d }, mux );
+  const auto f5 = klut.create_node( { f1, f4, d }, maj );
+  klut.create_po( f3 );
+  klut.create_po( f5 );
+
+  /* dangling node with a different function */
+  klut.create_node( { a, b, d }, mux );
+
+  exact_aig_resynthesis<aig_network> resyn;
+  node_resynthesis_params ps;
+  node_resynthesis_stats st;
+  const auto aig_serial = node_resynthesis<aig_network>( klut, resyn, ps );
+
+  ps.num_threads = 4u;
+  const auto aig_parallel = node_resynthesis<aig_network>( klut, resyn, ps, &st );
+
+  CHECK( st.num_functions == 3u );
+  CHECK( aig_parallel.num_pis() == 4u );
+  CHECK( aig_parallel.num_pos() == 2u );
+  CHECK( aig_parallel.num_gates() == aig_serial.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig_parallel ) == simulate<kitty::static_truth_table<4u>>( klut ) );
+}
+
+TEST_CASE( "Node resynthesis rebuilds the network concurrently", "[node_resynthesis]" )
+{
+  klut_network klut;
+  std::vector<klut_network::signal> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( klut.create_pi() );
+  }
+
+  kitty::dynamic_truth_table tt( 4u );
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    kitty::create_random( tt, i );
+    auto const n = fs.size();
+    fs.push_back( klut.create_node( { fs[n - 1u - i % 16u], fs[n - 1u - ( 3u * i + 1u ) % 16u], fs[( 5u * i ) % n], fs[( 11u * i + 7u ) % n] }, tt ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    klut.create_po( fs[fs.size() - 1u - 3u * i] );
+  }
+
+  xag_npn_resynthesis<xag_network, xag_network, xag_npn_db_kind::xag_complete> resyn;
+  node_resynthesis_params ps;
+  const auto xag_serial = node_resynthesis<xag_network>( klut, resyn, ps );
+
+  ps.num_threads = 4u;
+  const auto xag_parallel = node_resynthesis<xag_network>( klut, resyn, ps );
+
+  CHECK( xag_parallel.num_gates() == xag_serial.num_gates() );
+  default_simulator<kitty::dynamic_truth_table> sim( 16u );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag_parallel, sim ) == simulate<kitty::dynamic_truth_table>( klut, sim ) );
+}
+
+namespace
+{
+
+/* destination network that cannot be default constructed */
+struct bound_aig_network : aig_network
+{
+  explicit bound_aig_network( uint32_t num_pis )
+  {
+    (void)num_pis;
+  }
+};
+
+} // namespace
+
+TEST_CASE( "Node resynthesis falls back to the serial mode", "[node_resynthesis]" )
+{
+  kitty::dynamic_truth_table maj( 3 );
+  kitty::create_majority( maj );
+
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  klut.create_po( klut.create_node( { a, b, c }, maj ) );
+
+  exact_aig_resynthesis<aig_network> resyn;
+  node_resynthesis_params ps;
+  ps.num_threads = 4u;
+  node_resynthesis_stats st;
+  bound_aig_network aig( 3u );
+  node_resynthesis( aig, klut, resyn, ps, &st );
+
+  CHECK( st.serial_fallback );
+  CHECK( st.num_functions == 0u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == simulate<kitty::static_truth_table<3u>>( klut ) );
+}
@@ -3,10 +3,12 @@
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/pattern_generation.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
 #include <kitty/bit_operations.hpp>
+#include <lorina/aiger.hpp>
 
 using namespace mockturtle;
 
@@ -117,3 +119,37 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Multi-threaded stuck-at pattern generation", "[pattern_generation]" )
+{
+  aig_network aig;
+  auto const result = lorina::read_aiger( fmt::format( "{}/c432.aig", BENCHMARKS_PATH ), aiger_reader( aig ) );
+  REQUIRE( result == lorina::return_code::success );
+
+  for ( auto odc_levels : { 0, 5 } )
+  {
+    partial_simulator sim( aig.num_pis(), 16 );
+
+    pattern_generation_params ps;
+    ps.num_stuck_at = 2;
+    ps.odc_levels = odc_levels;
+    ps.num_threads = 4;
+    ps.batch_size = 16;
+    pattern_generation_stats st;
+    pattern_generation( aig, sim, ps, &st );
+
+    CHECK( sim.num_bits() == 16 + st.num_generated_patterns );
+    CHECK( st.num_generated_patterns > 0 );
+
+    /* every non-constant node has both values */
+    auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+    uint32_t num_constant = 0;
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( kitty::is_const0( tts[n] ) || kitty::is_const0( ~tts[n] ) )
+      {
+        ++num_constant;
+      }
+    } );
+    CHECK( num_constant == st.num_constant );
+  }
+}
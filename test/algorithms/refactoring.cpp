@@ -1,9 +1,15 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <mockturtle/algorithms/node_resynthesis/akers.hpp>
 #include <mockturtle/algorithms/node_resynthesis/bidecomposition.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/sop_factoring.hpp>
 #include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/traits.hpp>
@@ -185,3 +191,30 @@ TEST_CASE( "Refactoring from inverted projection", "[refactoring]" )
     CHECK( mig.is_complemented( f ) );
   } );
 }
+
+TEST_CASE( "Multi-threaded refactoring", "[refactoring]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    const auto g1 = aig.create_or( aig.create_and( a[i], !b[i] ), aig.create_and( !a[i], b[i] ) );
+    const auto g2 = aig.create_or( aig.create_and( a[i], b[( i + 1 ) % 6] ), aig.create_and( a[i], !b[( i + 1 ) % 6] ) );
+    aig.create_po( aig.create_and( g1, g2 ) );
+  }
+
+  sop_factoring<aig_network> resyn;
+  refactoring_params ps;
+  ps.num_threads = 4u;
+
+  auto res = cleanup_dangling( aig );
+  refactoring( res, resyn, ps );
+  res = cleanup_dangling( res );
+
+  CHECK( res.num_gates() < aig.num_gates() );
+
+  default_simulator<kitty::dynamic_truth_table> sim( aig.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( res, sim ) );
+}
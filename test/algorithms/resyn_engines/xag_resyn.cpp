@@ -234,3 +234,68 @@ TEST_CASE( "Synthesize XAGs for all 4-input functions", "[xag_resyn]" )
   CHECK( success_counter == 54622 );
   CHECK( failed_counter == 10914 );
 }
+
+template<class TT>
+struct xag_resyn_sparams_no_kernels : public xag_resyn_static_params_default<TT>
+{
+  static constexpr bool use_small_tt_kernels = false;
+};
+
+template<class TT>
+struct aig_resyn_sparams_no_kernels : public aig_resyn_static_params_default<TT>
+{
+  static constexpr bool use_small_tt_kernels = false;
+};
+
+template<class TT, class Params, class ParamsNoKernels>
+void test_small_tt_kernels( TT const& proto, uint32_t num_divisors, uint32_t num_tests )
+{
+  xag_resyn_stats st;
+  xag_resyn_decompose<TT, Params> engine( st );
+  xag_resyn_decompose<TT, ParamsNoKernels> engine_no_kernels( st );
+
+  std::vector<TT> tts( num_divisors, proto );
+  std::vector<uint32_t> divs;
+  for ( auto i = 0u; i < num_divisors; ++i )
+  {
+    divs.emplace_back( i );
+  }
+
+  TT target = proto, care = proto;
+  for ( auto i = 0u; i < num_tests; ++i )
+  {
+    for ( auto j = 0u; j < num_divisors; ++j )
+    {
+      kitty::create_random( tts[j], 2 * i * num_divisors + j );
+    }
+    /* target depending on a few divisors so that solutions exist */
+    target = ( tts[i % num_divisors] & tts[( i + 1 ) % num_divisors] ) ^ ( tts[( i + 2 ) % num_divisors] | tts[( i + 3 ) % num_divisors] );
+    kitty::create_random( care, 2 * i * num_divisors + num_divisors );
+    care |= tts[( i + 4 ) % num_divisors];
+
+    auto const res = engine( target, care, divs.begin(), divs.end(), tts, 6u );
+    auto const res_no_kernels = engine_no_kernels( target, care, divs.begin(), divs.end(), tts, 6u );
+    CHECK( res.has_value() == res_no_kernels.has_value() );
+    if ( res && res_no_kernels )
+    {
+      CHECK( res->raw() == res_no_kernels->raw() );
+    }
+  }
+}
+
+TEST_CASE( "AIG/XAG resynthesis -- word-level kernels for small truth tables", "[xag_resyn]" )
+{
+  using TT6 = kitty::static_truth_table<6>;
+  using TT7 = kitty::static_truth_table<7>;
+  using TT8 = kitty::static_truth_table<8>;
+  test_small_tt_kernels<TT6, xag_resyn_static_params_default<TT6>, xag_resyn_sparams_no_kernels<TT6>>( TT6(), 12u, 50u );
+  test_small_tt_kernels<TT7, xag_resyn_static_params_default<TT7>, xag_resyn_sparams_no_kernels<TT7>>( TT7(), 12u, 50u );
+  test_small_tt_kernels<TT8, aig_resyn_static_params_default<TT8>, aig_resyn_sparams_no_kernels<TT8>>( TT8(), 12u, 50u );
+
+  using DTT = kitty::dynamic_truth_table;
+  test_small_tt_kernels<DTT, xag_resyn_static_params_default<DTT>, xag_resyn_sparams_no_kernels<DTT>>( DTT( 5u ), 10u, 50u );
+  test_small_tt_kernels<DTT, aig_resyn_static_params_default<DTT>, aig_resyn_sparams_no_kernels<DTT>>( DTT( 8u ), 12u, 50u );
+
+  using PTT = kitty::partial_truth_table;
+  test_small_tt_kernels<PTT, xag_resyn_static_params_default<PTT>, xag_resyn_sparams_no_kernels<PTT>>( PTT( 150u ), 12u, 50u );
+}
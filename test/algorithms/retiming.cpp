@@ -159,4 +159,43 @@ TEST_CASE( "Retime backward 3", "[retime]" )
 
   retime( ntk );
   CHECK( ntk.num_registers() == 3u );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Retime forward across a deep chain", "[retime]" )
+{
+  generic_network ntk;
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto b1 = create_register_box( ntk, a );
+  const auto b2 = create_register_box( ntk, b );
+
+  auto f = ntk.create_and( b1, b2 );
+  for ( auto i = 0u; i < 100000u; ++i )
+  {
+    f = ntk.create_not( f );
+  }
+  ntk.create_po( f );
+
+  retime( ntk );
+  CHECK( ntk.num_registers() == 1u );
+}
+
+TEST_CASE( "Retime independent register groups in parallel", "[retime]" )
+{
+  generic_network ntk;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    const auto a = ntk.create_pi();
+    const auto b = ntk.create_pi();
+    const auto c = ntk.create_pi();
+    const auto b1 = create_register_box( ntk, a );
+    const auto b2 = create_register_box( ntk, b );
+    const auto b3 = create_register_box( ntk, c );
+    ntk.create_po( ntk.create_maj( b1, b2, b3 ) );
+  }
+
+  retime_params ps;
+  ps.num_threads = 4u;
+  retime( ntk, ps );
+  CHECK( ntk.num_registers() == 16u );
+}
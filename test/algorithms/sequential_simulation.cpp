@@ -0,0 +1,196 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/detail/switching_activity.hpp>
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/sequential.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "simulate a sequential AIG cycle by cycle", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+
+  /* a toggling register, and a shift register of depth 2 */
+  const auto a = aig.create_pi();
+  const auto t = aig.create_ro();
+  const auto s1 = aig.create_ro();
+  const auto s2 = aig.create_ro();
+  const auto f = aig.create_and( a, t );
+  aig.create_po( f );
+  aig.create_ri( !t );
+  aig.create_ri( a );
+  aig.create_ri( s1 );
+
+  mockturtle::register_t reg;
+  reg.init = 1;
+  aig.set_register( 0u, reg );
+
+  sequential_simulation_params ps;
+  ps.num_words = 2u;
+  sequential_simulator sim( aig, ps );
+  CHECK( sim.num_traces() == 128u );
+
+  std::vector<std::vector<uint64_t>> inputs = { { 0xf0f0, 0x1 }, { 0xff00, 0x2 }, { 0x0ff0, 0x3 } };
+  sim.simulate_cycle( inputs[0] );
+  CHECK( sim.value( aig.get_node( t ) ) == ~UINT64_C( 0 ) );
+  CHECK( sim.value( aig.get_node( s1 ) ) == 0u );
+  CHECK( sim.value( f, 0u ) == 0xf0f0 );
+  CHECK( sim.value( f, 1u ) == 0x1 );
+
+  sim.simulate_cycle( inputs[1] );
+  CHECK( sim.value( aig.get_node( t ) ) == 0u );
+  CHECK( sim.value( aig.get_node( s1 ), 1u ) == 0x1 );
+  CHECK( sim.value( f ) == 0u );
+
+  sim.simulate_cycle( inputs[2] );
+  CHECK( sim.value( aig.get_node( s1 ) ) == 0xff00 );
+  CHECK( sim.value( aig.get_node( s2 ) ) == 0xf0f0 );
+  CHECK( sim.value( aig.get_node( s2 ), 1u ) == 0x1 );
+  CHECK( sim.num_cycles() == 3u );
+
+  /* t toggles in all traces, a in 8 + 2 and 8 + 1 traces */
+  CHECK( sim.toggles( aig.get_node( t ) ) == 256u );
+  CHECK( sim.toggles( aig.get_node( a ) ) == 19u );
+  auto const activity = sim.switching_activity();
+  CHECK( activity[aig.node_to_index( aig.get_node( t ) )] == 1.0f );
+  CHECK( activity[aig.node_to_index( aig.get_node( a ) )] == Approx( 19.0 / 256.0 ) );
+
+  sim.reset();
+  CHECK( sim.num_cycles() == 0u );
+  CHECK( sim.toggles( aig.get_node( t ) ) == 0u );
+  CHECK( sim.value( aig.get_node( t ) ) == ~UINT64_C( 0 ) );
+}
+
+TEST_CASE( "simulate a sequential k-LUT network cycle by cycle", "[sequential_simulation]" )
+{
+  sequential<klut_network> klut;
+
+  /* 2-bit counter with enable */
+  const auto en = klut.create_pi();
+  const auto q0 = klut.create_ro();
+  const auto q1 = klut.create_ro();
+
+  kitty::dynamic_truth_table xor2( 2u ), xor3( 3u ), and2( 2u );
+  kitty::create_from_hex_string( xor2, "6" );
+  kitty::create_from_hex_string( and2, "8" );
+  kitty::create_from_hex_string( xor3, "96" );
+  const auto d0 = klut.create_node( { en, q0 }, xor2 );
+  const auto d1 = klut.create_node( { q1, klut.create_node( { en, q0 }, and2 ) }, xor2 );
+  klut.create_po( klut.create_node( { en, q0, q1 }, xor3 ) );
+  klut.create_ri( d0 );
+  klut.create_ri( d1 );
+
+  sequential_simulator sim( klut );
+
+  /* trace i is enabled in cycle c iff bit c of i is set */
+  std::vector<uint64_t> counts( 64u, 0u );
+  for ( auto c = 0u; c < 6u; ++c )
+  {
+    uint64_t enable{ 0u };
+    for ( auto i = 0u; i < 64u; ++i )
+    {
+      enable |= static_cast<uint64_t>( ( i >> c ) & 1u ) << i;
+    }
+    sim.simulate_cycle( { enable } );
+
+    for ( auto i = 0u; i < 64u; ++i )
+    {
+      auto const v0 = ( sim.value( q0 ) >> i ) & 1u;
+      auto const v1 = ( sim.value( q1 ) >> i ) & 1u;
+      CHECK( v0 + 2u * v1 == counts[i] % 4u );
+      counts[i] += ( i >> c ) & 1u;
+    }
+  }
+}
+
+TEST_CASE( "stream input vectors of a sequential simulation", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r = aig.create_ro();
+  aig.create_po( aig.create_and( a, r ) );
+  aig.create_ri( aig.create_xor( b, r ) );
+
+  /* one cycle per line, a alternates in every cycle and b is set in the first cycle */
+  std::stringstream stream;
+  stream << "# a b\n";
+  for ( auto i = 0u; i < 9u; ++i )
+  {
+    stream << ( i % 2u ? '1' : '0' ) << ( i == 0u ? '1' : '0' ) << "\n";
+  }
+
+  sequential_simulator sim( aig );
+  CHECK( sim.simulate_stream( stream ) == 9u );
+  CHECK( sim.num_cycles() == 9u );
+  CHECK( sim.value( aig.get_node( a ) ) == 0u );
+  CHECK( sim.value( aig.get_node( r ) ) == ~UINT64_C( 0 ) );
+
+  /* a toggles in all transitions, b and r once */
+  auto const activity = sim.switching_activity();
+  CHECK( activity[aig.node_to_index( aig.get_node( a ) )] == 1.0f );
+  CHECK( activity[aig.node_to_index( aig.get_node( b ) )] == Approx( 1.0 / 8.0 ) );
+  CHECK( activity[aig.node_to_index( aig.get_node( r ) )] == Approx( 1.0 / 8.0 ) );
+}
+
+TEST_CASE( "stream one input vector per trace", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+  const auto a = aig.create_pi();
+  aig.create_po( a );
+
+  /* trace i has value 1 iff i is odd, then all values are inverted */
+  std::stringstream stream;
+  for ( auto c = 0u; c < 2u; ++c )
+  {
+    for ( auto i = 0u; i < 64u; ++i )
+    {
+      stream << ( ( i + c ) % 2u ? '1' : '0' ) << ( i == 63u ? '\n' : ' ' );
+    }
+  }
+
+  sequential_simulator sim( aig );
+  CHECK( sim.simulate_stream( stream ) == 2u );
+  CHECK( sim.value( aig.get_node( a ) ) == UINT64_C( 0x5555555555555555 ) );
+  CHECK( sim.toggles( aig.get_node( a ) ) == 64u );
+}
+
+TEST_CASE( "reject malformed input vectors", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  aig.create_po( aig.create_and( a, b ) );
+
+  for ( auto const& text : { "01\n1\n", "01\n0x\n", "01\n011\n", "01\n01 10\n" } )
+  {
+    std::stringstream stream( text );
+    sequential_simulator sim( aig );
+    CHECK( !sim.simulate_stream( stream ) );
+    CHECK( sim.num_cycles() == 1u );
+  }
+
+  sequential_simulator sim( aig );
+  CHECK( !sim.simulate_file( "" ) );
+}
+
+TEST_CASE( "switching activity of sequential networks", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+  const auto a = aig.create_pi();
+  const auto t = aig.create_ro();
+  aig.create_po( aig.create_and( a, t ) );
+  aig.create_ri( !t );
+
+  auto const activity = detail::switching_activity( aig, 4096u );
+  CHECK( activity[aig.node_to_index( aig.get_node( t ) )] == 1.0f );
+  CHECK( activity[aig.node_to_index( aig.get_node( a ) )] == Approx( 0.5 ).epsilon( 0.1 ) );
+}
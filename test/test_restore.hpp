@@ -0,0 +1,85 @@
+#pragma once
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace mockturtle
+{
+
+/* random (possibly complemented) signal among `fs` */
+template<typename Ntk>
+typename Ntk::signal pick_random_signal( std::vector<typename Ntk::signal> const& fs, std::mt19937& rng )
+{
+  auto const f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+  return ( rng() & 1 ) ? !f : f;
+}
+
+/* creates 16 PIs, `num_gates` random majority gates, and 32 POs; returns all created signals */
+template<typename Ntk>
+std::vector<typename Ntk::signal> create_random_network( Ntk& ntk, uint32_t num_gates, std::mt19937& rng )
+{
+  std::vector<typename Ntk::signal> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    fs.push_back( ntk.create_maj( pick_random_signal<Ntk>( fs, rng ), pick_random_signal<Ntk>( fs, rng ), pick_random_signal<Ntk>( fs, rng ) ) );
+  }
+  for ( auto i = 0u; i < 32u; ++i )
+  {
+    ntk.create_po( fs[fs.size() - 1u - 7u * i] );
+  }
+  return fs;
+}
+
+/* checks that the storage of `ntk` was restored to the one of `ref` */
+template<typename Ntk>
+void check_same_structure( Ntk const& ntk, Ntk const& ref )
+{
+  REQUIRE( ntk.size() == ref.size() );
+  CHECK( ntk.num_pis() == ref.num_pis() );
+  CHECK( ntk.num_pos() == ref.num_pos() );
+  CHECK( ntk.num_gates() == ref.num_gates() );
+  CHECK( ntk._storage->hash.size() == ref._storage->hash.size() );
+
+  for ( auto i = 0u; i < ntk.size(); ++i )
+  {
+    CHECK( ntk._storage->nodes[i] == ref._storage->nodes[i] );
+    CHECK( ntk.fanout_size( i ) == ref.fanout_size( i ) );
+    CHECK( ntk.is_dead( i ) == ref.is_dead( i ) );
+  }
+  for ( auto const& [key, index] : ref._storage->hash )
+  {
+    auto const it = ntk._storage->hash.find( key );
+    CHECK( ( it != ntk._storage->hash.end() && it->second == index ) );
+  }
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == ref.po_at( i ) );
+  } );
+}
+
+/* checks that structural hashing finds the restored gates among `fs` */
+template<typename Ntk>
+void check_restored_hashing( Ntk& ntk, std::vector<typename Ntk::signal> const& fs )
+{
+  for ( auto i = 16u; i < fs.size(); i += 13u )
+  {
+    auto const n = ntk.get_node( fs[i] );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) || ntk.is_dead( n ) )
+      continue;
+    std::vector<typename Ntk::signal> children;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      children.push_back( f );
+    } );
+    auto const size_before = ntk.size();
+    CHECK( ntk.clone_node( ntk, n, children ) == ntk.make_signal( n ) );
+    CHECK( ntk.size() == size_before );
+  }
+}
+
+} // namespace mockturtle
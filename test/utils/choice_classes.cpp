@@ -0,0 +1,118 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/choice_classes.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "build choice classes from equivalences", "[choice_classes]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+
+  /* (a & b) & c and a & (b & c) */
+  auto const x = aig.create_and( aig.create_and( a, b ), c );
+  auto const y = aig.create_and( a, aig.create_and( b, c ) );
+
+  /* XOR and XNOR with different structures */
+  auto const p = aig.create_or( aig.create_and( a, !b ), aig.create_and( !a, b ) );
+  auto const q = aig.create_or( aig.create_and( a, b ), aig.create_and( !a, !b ) );
+
+  aig.create_po( x );
+  aig.create_po( y );
+  aig.create_po( p );
+  aig.create_po( q );
+
+  /* the node of q is the complement of p, unless q is complemented */
+  auto const q_node_sig = aig.is_complemented( q ) ? p : !p;
+  choice_classes choices( aig, { { aig.get_node( y ), x }, { aig.get_node( q ), q_node_sig } } );
+  CHECK( choices.num_classes() == 2u );
+  CHECK( choices.num_choices() == 2u );
+  CHECK( choices.num_rejected() == 0u );
+
+  CHECK( choices.representative( aig.get_node( y ) ) == aig.get_node( x ) );
+  CHECK( choices.has_choices( aig.get_node( x ) ) );
+  CHECK( !choices.has_choices( aig.get_node( y ) ) );
+  CHECK( !choices.is_representative( aig.get_node( y ) ) );
+  CHECK( !choices.phase( aig.get_node( y ) ) );
+
+  CHECK( choices.representative( aig.get_node( q ) ) == aig.get_node( p ) );
+  CHECK( choices.phase( aig.get_node( q ) ) == aig.is_complemented( q_node_sig ) );
+
+  std::vector<aig_network::node> members;
+  choices.foreach_choice( aig.get_node( y ), [&]( auto const& n, bool phase ) {
+    members.push_back( n );
+    CHECK( !phase );
+  } );
+  CHECK( members == std::vector<aig_network::node>{ aig.get_node( x ), aig.get_node( y ) } );
+
+  /* all dependencies of a node in the choice network precede it */
+  auto const& order = choices.topological_order();
+  CHECK( order.size() == aig.size() );
+  std::vector<int32_t> position( aig.size(), -1 );
+  for ( auto i = 0u; i < order.size(); ++i )
+  {
+    position[aig.node_to_index( order[i] )] = i;
+  }
+  for ( auto const& n : order )
+  {
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      auto const r = choices.representative( aig.get_node( f ) );
+      CHECK( position[aig.node_to_index( r )] >= 0 );
+      CHECK( position[aig.node_to_index( r )] < position[aig.node_to_index( n )] );
+    } );
+    choices.foreach_choice( n, [&]( auto const& m, bool ) {
+      if ( choices.is_representative( n ) )
+      {
+        CHECK( position[aig.node_to_index( m )] <= position[aig.node_to_index( n )] );
+      }
+    } );
+  }
+}
+
+TEST_CASE( "reject choices that create cycles", "[choice_classes]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  auto const f3 = aig.create_and( f2, a );
+  aig.create_po( f3 );
+
+  /* f2 and f3 depend on f1, the constant and the inputs are never members */
+  choice_classes choices( aig, { { aig.get_node( f2 ), f1 }, { aig.get_node( f1 ), f3 }, { aig.get_node( f1 ), a }, { aig.get_node( f2 ), aig.get_constant( false ) } } );
+  CHECK( choices.num_classes() == 0u );
+  CHECK( choices.num_rejected() == 2u );
+  CHECK( choices.topological_order().size() == aig.size() );
+}
+
+TEST_CASE( "reject choices that create cycles through other classes", "[choice_classes]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const s = aig.create_and( a, c );
+  std::vector<aig_network::signal> d{ aig.create_and( a, b ) };
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    d.push_back( aig.create_and( d.back(), !b ) );
+  }
+  auto const t = aig.create_and( s, b );
+  aig.create_po( t );
+  aig.create_po( d.back() );
+
+  /* once s depends on the deepest node of the chain, t does too, such that t
+   * cannot be a choice of the first node of the chain */
+  choice_classes choices( aig, { { aig.get_node( s ), d.back() }, { aig.get_node( t ), d.front() } } );
+  CHECK( choices.num_classes() == 1u );
+  CHECK( choices.num_rejected() == 1u );
+  CHECK( choices.representative( aig.get_node( d.back() ) ) == aig.get_node( s ) );
+  CHECK( choices.is_representative( aig.get_node( t ) ) );
+}
@@ -0,0 +1,193 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/concurrent_network_builder.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* overlapping cones, such that structural hashing merges gates of different cones */
+template<class Builder, class Signal>
+Signal build_cone( Builder& builder, std::vector<Signal> const& pis, uint32_t index )
+{
+  auto f = pis[index % pis.size()];
+  for ( auto j = 0u; j < 6u; ++j )
+  {
+    auto const a = pis[( index + j ) % pis.size()];
+    auto const b = pis[( index + j + 1u ) % pis.size()];
+    auto const g = ( j % 2u == 0u ) ? builder.create_xor( a, b ) : builder.create_or( a, !b );
+    f = ( ( index + j ) % 3u == 0u ) ? builder.create_and( f, g ) : builder.create_xor( f, !g );
+  }
+  return f;
+}
+
+template<class Ntk>
+void check_concurrent_construction()
+{
+  using signal = typename Ntk::signal;
+
+  /* reference network built sequentially */
+  Ntk ref;
+  std::vector<signal> ref_pis( 8u );
+  for ( auto& pi : ref_pis )
+  {
+    pi = ref.create_pi();
+  }
+  ref.create_and( ref_pis[0], ref_pis[1] ); /* existing gate */
+  for ( auto i = 0u; i < 32u; ++i )
+  {
+    ref.create_po( build_cone( ref, ref_pis, i ) );
+  }
+
+  Ntk ntk;
+  std::vector<signal> pis( 8u );
+  for ( auto& pi : pis )
+  {
+    pi = ntk.create_pi();
+  }
+  ntk.create_and( pis[0], pis[1] );
+
+  uint32_t num_added{ 0u };
+  auto add_event = ntk.events().register_add_event( [&]( auto const& ) { ++num_added; } );
+
+  std::vector<signal> outputs( 32u );
+  concurrent_network_builder builder( ntk );
+  parallel_for( 4u, outputs.size(), [&]( uint64_t index, uint32_t ) {
+    outputs[index] = build_cone( builder, pis, static_cast<uint32_t>( index ) );
+  } );
+  CHECK( builder.num_new_gates() == ref.num_gates() - 1u );
+  builder.commit();
+  CHECK( builder.num_new_gates() == 0u );
+  ntk.events().release_add_event( add_event );
+
+  for ( auto const& f : outputs )
+  {
+    ntk.create_po( f );
+  }
+
+  CHECK( ntk.num_gates() == ref.num_gates() );
+  CHECK( num_added == ref.num_gates() - 1u );
+
+  /* reference counters are updated */
+  ntk.foreach_node( [&]( auto const& n ) {
+    uint32_t fanouts{ 0u };
+    ntk.foreach_gate( [&]( auto const& g ) {
+      ntk.foreach_fanin( g, [&]( auto const& f ) {
+        fanouts += ntk.get_node( f ) == n ? 1u : 0u;
+      } );
+    } );
+    ntk.foreach_po( [&]( auto const& f ) {
+      fanouts += ntk.get_node( f ) == n ? 1u : 0u;
+    } );
+    CHECK( ntk.fanout_size( n ) == fanouts );
+  } );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 8u );
+  CHECK( simulate<kitty::dynamic_truth_table>( ntk, sim ) == simulate<kitty::dynamic_truth_table>( ref, sim ) );
+
+  /* the builder can be reused and hashes against the committed gates */
+  concurrent_network_builder builder2( ntk );
+  CHECK( builder2.create_and( outputs[0], outputs[1] ) == ntk.create_and( outputs[0], outputs[1] ) );
+  CHECK( builder2.create_and( pis[0], pis[1] ) == ntk.create_and( pis[0], pis[1] ) );
+  CHECK( builder2.num_new_gates() == 0u );
+}
+
+} // namespace
+
+TEST_CASE( "concurrent construction of AIGs", "[concurrent_network_builder]" )
+{
+  check_concurrent_construction<aig_network>();
+}
+
+TEST_CASE( "concurrent construction of XAGs", "[concurrent_network_builder]" )
+{
+  check_concurrent_construction<xag_network>();
+}
+
+TEST_CASE( "concurrent construction of MIGs", "[concurrent_network_builder]" )
+{
+  check_concurrent_construction<mig_network>();
+}
+
+TEST_CASE( "concurrent construction of XMGs", "[concurrent_network_builder]" )
+{
+  check_concurrent_construction<xmg_network>();
+}
+
+TEST_CASE( "concurrent construction of majority and XOR3 gates", "[concurrent_network_builder]" )
+{
+  xmg_network xmg;
+  auto const a = xmg.create_pi();
+  auto const b = xmg.create_pi();
+  auto const c = xmg.create_pi();
+
+  concurrent_network_builder builder( xmg );
+  auto const f1 = builder.create_maj( a, !b, c );
+  auto const f2 = builder.create_maj( !c, b, !a );
+  auto const f3 = builder.create_xor3( a, b, !c );
+  auto const f4 = builder.create_xor3( !c, a, b );
+  CHECK( f1 == !f2 );
+  CHECK( f3 == f4 );
+  CHECK( builder.create_maj( a, a, c ) == a );
+  CHECK( builder.create_xor3( a, b, b ) == a );
+  CHECK( builder.num_new_gates() == 2u );
+  builder.commit();
+
+  CHECK( xmg.num_gates() == 2u );
+  CHECK( xmg.create_maj( a, !b, c ) == f1 );
+  CHECK( xmg.create_xor3( a, b, !c ) == f3 );
+  CHECK( xmg.num_gates() == 2u );
+}
+
+TEST_CASE( "concurrent construction of many gates", "[concurrent_network_builder]" )
+{
+  /* 256 chains of 100 gates, more than the first segments can hold */
+  auto const build_chain = []( auto& builder, auto const& pis, uint32_t index ) {
+    auto f = pis[index % pis.size()];
+    for ( auto j = 0u; j < 100u; ++j )
+    {
+      f = builder.create_and( f, pis[( 7u * index + j ) % pis.size()] ^ ( ( ( index >> ( j % 8u ) ) & 1u ) == 1u ) );
+    }
+    return f;
+  };
+
+  aig_network ref, aig;
+  std::vector<aig_network::signal> ref_pis( 16u ), pis( 16u );
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    ref_pis[i] = ref.create_pi();
+    pis[i] = aig.create_pi();
+  }
+  for ( auto i = 0u; i < 256u; ++i )
+  {
+    ref.create_po( build_chain( ref, ref_pis, i ) );
+  }
+
+  std::vector<aig_network::signal> outputs( 256u );
+  concurrent_network_builder builder( aig, 100u );
+  parallel_for( 4u, outputs.size(), [&]( uint64_t index, uint32_t ) {
+    outputs[index] = build_chain( builder, pis, static_cast<uint32_t>( index ) );
+  } );
+  CHECK( builder.num_new_gates() == ref.num_gates() );
+  builder.commit();
+  for ( auto const& f : outputs )
+  {
+    aig.create_po( f );
+  }
+
+  CHECK( aig.num_gates() == ref.num_gates() );
+  CHECK( aig.num_gates() > 4096u );
+  default_simulator<kitty::dynamic_truth_table> sim( 16u );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig, sim ) == simulate<kitty::dynamic_truth_table>( ref, sim ) );
+}
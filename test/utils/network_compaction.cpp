@@ -0,0 +1,130 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/network_compaction.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+template<typename Ntk>
+void test_compact_nodes()
+{
+  Ntk ntk;
+  std::vector<typename Ntk::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( ntk.create_pi() );
+  }
+
+  std::mt19937 rng( 3u );
+  auto const random_signal = [&]() {
+    auto f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    while ( ntk.is_dead( ntk.get_node( f ) ) )
+    {
+      f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    }
+    return ( rng() & 1 ) ? !f : f;
+  };
+  for ( auto i = 0u; i < 500u; ++i )
+  {
+    fs.push_back( ntk.create_maj( random_signal(), random_signal(), random_signal() ) );
+  }
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    ntk.create_po( fs[fs.size() - 1u - 3u * i] );
+  }
+
+  /* substituting nodes by their fanins takes out their dangling fanin cones */
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    auto const n = ntk.get_node( fs[8u + ( 61u * i ) % 500u] );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) || ntk.is_dead( n ) )
+      continue;
+    typename Ntk::signal fanin;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanin = f;
+    } );
+    ntk.substitute_node( n, fanin );
+  }
+
+  /* substitutions may break the topological order of the node indices */
+  auto const simulate_outputs = [&]() {
+    return simulate<kitty::dynamic_truth_table>( topo_view{ ntk }, default_simulator<kitty::dynamic_truth_table>( ntk.num_pis() ) );
+  };
+  auto const tts = simulate_outputs();
+  auto const size_before = ntk.size();
+  auto const num_gates_before = ntk.num_gates();
+
+  /* node maps store the former index of each live node */
+  node_map<uint32_t, Ntk> indices( ntk );
+  unordered_node_map<uint32_t, Ntk> gate_indices( ntk );
+  ntk.foreach_node( [&]( auto const& n ) {
+    indices[n] = ntk.node_to_index( n );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      return;
+    gate_indices[n] = ntk.node_to_index( n );
+  } );
+  std::vector<typename Ntk::signal> old_fs;
+  for ( auto const& f : fs )
+  {
+    if ( !ntk.is_dead( ntk.get_node( f ) ) )
+    {
+      old_fs.push_back( f );
+    }
+  }
+
+  auto const remapping = compact_nodes( ntk );
+  CHECK( remapping.num_removed() > 0u );
+  CHECK( ntk.size() == size_before - remapping.num_removed() );
+  CHECK( ntk.num_gates() == num_gates_before );
+  CHECK( ntk._storage->hash.size() == num_gates_before );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( !ntk.is_dead( n ) );
+  } );
+  CHECK( simulate_outputs() == tts );
+
+  remapping.apply( indices, gate_indices );
+  CHECK( indices.size() == ntk.size() );
+  CHECK( gate_indices.size() == ntk.num_gates() );
+  for ( auto i = 0u; i < size_before; ++i )
+  {
+    if ( remapping.is_removed( i ) )
+      continue;
+    CHECK( indices[remapping( i )] == i );
+  }
+
+  /* the hash table refers to the relocated gates */
+  for ( auto const& f : old_fs )
+  {
+    auto const g = remapping( f );
+    CHECK( ntk.is_complemented( g ) == ntk.is_complemented( f ) );
+    auto const n = ntk.get_node( g );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      continue;
+    CHECK( gate_indices[n] == ntk.node_to_index( ntk.get_node( f ) ) );
+
+    auto const it = ntk._storage->hash.find( ntk._storage->nodes[n] );
+    CHECK( ( it != ntk._storage->hash.end() && it->second == n ) );
+  }
+
+  /* compacting again keeps all nodes */
+  CHECK( compact_nodes( ntk ).num_removed() == 0u );
+}
+
+TEST_CASE( "compact the nodes of networks in-place", "[network_compaction]" )
+{
+  test_compact_nodes<aig_network>();
+  test_compact_nodes<xag_network>();
+  test_compact_nodes<mig_network>();
+  test_compact_nodes<xmg_network>();
+}
@@ -0,0 +1,92 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/network_snapshot.hpp>
+
+#include "../test_restore.hpp"
+
+using namespace mockturtle;
+
+template<typename Ntk>
+void test_snapshot_rollback()
+{
+  Ntk ntk;
+  std::mt19937 rng( 5u );
+  auto const fs = create_random_network( ntk, 3000u, rng );
+  auto const random_signal = [&]() {
+    return pick_random_signal<Ntk>( fs, rng );
+  };
+  auto const ref = ntk.clone();
+
+  {
+    network_snapshot snapshot{ ntk };
+
+    /* modify the network: new gates, inputs, outputs, and substitutions */
+    auto const a = ntk.create_pi();
+    ntk.create_po( ntk.create_and( a, fs[20] ) );
+    for ( auto i = 0u; i < 20u; ++i )
+    {
+      auto const n = ntk.get_node( fs[fs.size() - 1u - 97u * i] );
+      if ( ntk.is_dead( n ) )
+        continue;
+      ntk.substitute_node( n, ntk.create_and( random_signal(), fs[i % 16u] ) );
+    }
+    CHECK( snapshot.num_saved_chunks() > 0u );
+
+    snapshot.rollback();
+    CHECK( !snapshot.is_active() );
+  }
+  check_same_structure( ntk, ref );
+
+  /* structural hashing still finds the restored gates */
+  check_restored_hashing( ntk, fs );
+
+  /* committed modifications are kept */
+  {
+    network_snapshot snapshot{ ntk };
+    ntk.create_po( ntk.create_and( fs[3], fs[4] ) );
+    snapshot.commit();
+  }
+  CHECK( ntk.num_pos() == ref.num_pos() + 1u );
+}
+
+TEST_CASE( "roll back modifications of networks to a snapshot", "[network_snapshot]" )
+{
+  test_snapshot_rollback<aig_network>();
+  test_snapshot_rollback<xag_network>();
+  test_snapshot_rollback<mig_network>();
+  test_snapshot_rollback<xmg_network>();
+}
+
+TEST_CASE( "save only modified chunks of nodes", "[network_snapshot]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 2u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; i < 10000u; ++i )
+  {
+    fs.push_back( aig.create_and( fs[fs.size() - 1u], !fs[fs.size() - 2u] ) );
+  }
+  aig.create_po( fs.back() );
+
+  network_snapshot snapshot{ aig };
+  CHECK( snapshot.num_saved_chunks() == 0u );
+
+  /* creating a gate only modifies the fanout counters of its fanins */
+  aig.create_po( aig.create_and( fs[1], fs[5000] ) );
+  CHECK( snapshot.num_saved_chunks() == 2u );
+
+  snapshot.rollback();
+  CHECK( aig.num_pos() == 1u );
+  CHECK( aig.num_gates() == 10000u );
+  CHECK( aig.fanout_size( aig.get_node( fs[5000] ) ) == 2u );
+}
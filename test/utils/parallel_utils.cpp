@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
+#include <mockturtle/views/rank_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "run tasks level by level on multiple threads", "[parallel_utils]" )
+{
+  std::vector<uint64_t> const level_sizes{ 5u, 0u, 100u, 1u, 37u };
+  std::vector<std::vector<uint32_t>> done( level_sizes.size() );
+  for ( auto l = 0u; l < level_sizes.size(); ++l )
+  {
+    done[l].resize( level_sizes[l], 0u );
+  }
+
+  std::atomic<uint32_t> num_violations{ 0u };
+  std::vector<std::atomic<uint64_t>> num_finished( level_sizes.size() );
+  parallel_for_levels( 4u, level_sizes, [&]( uint32_t level, uint64_t index, uint32_t thread_id ) {
+    if ( thread_id >= 4u )
+    {
+      ++num_violations;
+    }
+    /* all tasks of the previous levels are finished */
+    for ( auto l = 0u; l < level; ++l )
+    {
+      if ( num_finished[l] != level_sizes[l] )
+      {
+        ++num_violations;
+      }
+    }
+    ++done[level][index];
+    ++num_finished[level];
+  } );
+  CHECK( num_violations == 0u );
+  for ( auto l = 0u; l < level_sizes.size(); ++l )
+  {
+    for ( auto const& d : done[l] )
+    {
+      CHECK( d == 1u );
+    }
+  }
+
+  /* exceptions are rethrown after all threads have been joined */
+  CHECK_THROWS_AS( parallel_for_levels( 4u, level_sizes, [&]( uint32_t level, uint64_t index, uint32_t ) {
+                     if ( level == 2u && index == 50u )
+                     {
+                       throw std::runtime_error( "task failed" );
+                     }
+                   } ),
+                   std::runtime_error );
+}
+
+template<class Ntk>
+void check_level_order( Ntk const& ntk, node_map<uint32_t, Ntk> const& order )
+{
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( order[n] > 0u );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( order[ntk.get_node( f )] < order[n] );
+    } );
+  } );
+}
+
+TEST_CASE( "visit the gates of networks level by level on multiple threads", "[parallel_utils]" )
+{
+  random_network_generator_params_size ps;
+  ps.num_pis = 16u;
+  ps.num_gates = 2000u;
+  auto const aig = random_aig_generator( ps ).generate();
+
+  /* the order in which nodes are visited, which is only increased once a level is complete */
+  auto const visit = [&]( auto const& ntk, auto&& foreach_fn ) {
+    using Ntk = std::decay_t<decltype( ntk )>;
+    node_map<uint32_t, Ntk> order( ntk, 0u );
+    std::atomic<uint32_t> counter{ 0u };
+    std::vector<uint64_t> scratch( 4u, 0u );
+    foreach_fn( ntk, [&]( auto const& n, uint32_t thread_id ) {
+      uint32_t max_fanin{ 0u };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        max_fanin = std::max( max_fanin, order[ntk.get_node( f )] );
+      } );
+      order[n] = std::max( max_fanin + 1u, ++counter );
+      ++scratch[thread_id];
+    } );
+    uint64_t total{ 0u };
+    for ( auto const& s : scratch )
+    {
+      total += s;
+    }
+    return std::make_pair( order, total );
+  };
+
+  topo_view topo{ aig };
+  auto const [gate_order, num_gates] = visit( topo, []( auto const& ntk, auto&& fn ) {
+    parallel_foreach_gate_by_level( ntk, fn, 4u );
+  } );
+  CHECK( num_gates == aig.num_gates() );
+  check_level_order( topo, gate_order );
+
+  rank_view ranked{ aig };
+  auto const [rank_order, num_nodes] = visit( ranked, []( auto const& ntk, auto&& fn ) {
+    parallel_foreach_rank( ntk, fn, 4u );
+  } );
+  CHECK( num_nodes == aig.num_pis() + aig.num_gates() );
+  check_level_order( ranked, rank_order );
+}
@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <mockturtle/utils/tracing.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "record phases and counters", "[tracing]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  auto& counter = recorder.counter( "test/events" );
+  {
+    trace_scope outer( "test/outer" );
+    {
+      trace_scope inner( "test/inner" );
+      counter += 3;
+    }
+    counter += 2;
+  }
+
+  auto const events = recorder.events();
+  CHECK( events.size() == 4u );
+
+  CHECK( events[0].name == "test/inner" );
+  CHECK( !events[0].is_counter );
+  CHECK( events[1].name == "test/events" );
+  CHECK( events[1].is_counter );
+  CHECK( events[1].value == 3 );
+  CHECK( events[2].name == "test/outer" );
+  CHECK( events[3].name == "test/events" );
+  CHECK( events[3].value == 5 );
+
+  /* the inner phase is nested in the outer phase */
+  CHECK( events[2].timestamp <= events[0].timestamp );
+  CHECK( events[0].timestamp + events[0].duration <= events[2].timestamp + events[2].duration );
+
+  recorder.clear();
+  CHECK( recorder.events().empty() );
+  CHECK( counter == 0 );
+}
+
+TEST_CASE( "export traces", "[tracing]" )
+{
+  auto& recorder = trace_recorder::instance();
+  recorder.clear();
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    trace_scope scope( "test/phase" );
+    recorder.counter( "test/count" ) += 1;
+  }
+
+  std::stringstream json;
+  recorder.write_chrome_trace( json );
+  auto const trace = json.str();
+  CHECK( trace.find( "{\"traceEvents\":[" ) == 0u );
+  CHECK( trace.find( "\"name\":\"test/phase\",\"cat\":\"mockturtle\",\"ph\":\"X\"" ) != std::string::npos );
+  CHECK( trace.find( "\"name\":\"test/count\",\"ph\":\"C\"" ) != std::string::npos );
+
+  std::stringstream csv;
+  recorder.write_csv( csv );
+  std::string line;
+  std::getline( csv, line );
+  CHECK( line == "type,name,calls,total_us,max_us,value,allocations,allocated_bytes,peak_rss_kb" );
+  std::getline( csv, line );
+  CHECK( line.find( "phase,test/phase,3," ) == 0u );
+  std::getline( csv, line );
+  CHECK( line == "counter,test/count,,,,3,,," );
+
+  recorder.clear();
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/utils/undo_log.hpp>
+
+#include "../test_restore.hpp"
+
+using namespace mockturtle;
+
+template<typename Ntk>
+void test_undo_log()
+{
+  Ntk ntk;
+  std::mt19937 rng( 7u );
+  auto const fs = create_random_network( ntk, 2000u, rng );
+  auto const random_signal = [&]() {
+    return pick_random_signal<Ntk>( fs, rng );
+  };
+
+  auto const substitute = [&]( uint32_t offset ) {
+    for ( auto i = 0u; i < 10u; ++i )
+    {
+      auto const n = ntk.get_node( fs[fs.size() - 1u - offset - 89u * i] );
+      if ( ntk.is_dead( n ) )
+        continue;
+      ntk.substitute_node( n, ntk.create_and( random_signal(), fs[i % 16u] ) );
+    }
+  };
+
+  auto const ref = ntk.clone();
+  network_undo_log log{ ntk };
+
+  /* the modifications of a committed inner transaction are undone with the outer one */
+  log.begin();
+  substitute( 0u );
+
+  log.begin();
+  ntk.create_po( ntk.create_and( ntk.create_pi(), fs[20] ) );
+  substitute( 3u );
+  log.commit();
+  CHECK( log.num_transactions() == 1u );
+
+  log.begin();
+  substitute( 5u );
+  CHECK( log.num_entries() > 0u );
+  log.rollback();
+  CHECK( ntk.num_pis() == ref.num_pis() + 1u );
+
+  log.rollback();
+  CHECK( log.num_transactions() == 0u );
+  check_same_structure( ntk, ref );
+
+  /* rolling back an inner transaction keeps the modifications of the outer one */
+  log.begin();
+  substitute( 0u );
+  auto const ref_outer = ntk.clone();
+  log.begin();
+  substitute( 11u );
+  log.rollback();
+  log.commit();
+  CHECK( log.num_entries() == 0u );
+  check_same_structure( ntk, ref_outer );
+
+  /* structural hashing still finds the restored gates */
+  check_restored_hashing( ntk, fs );
+}
+
+TEST_CASE( "roll back nested transactions of networks", "[undo_log]" )
+{
+  test_undo_log<aig_network>();
+  test_undo_log<xag_network>();
+  test_undo_log<mig_network>();
+  test_undo_log<xmg_network>();
+}
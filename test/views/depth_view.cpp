@@ -1,5 +1,9 @@
 #include <catch.hpp>
 
+#include <functional>
+#include <random>
+#include <vector>
+
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/mig.hpp>
@@ -238,3 +242,78 @@ TEST_CASE( "compute levels during node construction after move assignment", "[de
 
   CHECK( dxag.depth() == 3u );
 }
+
+template<typename Ntk>
+void check_incremental_levels( depth_view<Ntk> const& ntk )
+{
+  depth_view<Ntk> ref{ static_cast<Ntk const&>( ntk ) };
+  CHECK( ntk.depth() == ref.depth() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    /* only the nodes in the transitive fanin of the outputs are visited when computing levels from scratch */
+    if ( ntk.is_dead( n ) || ntk.visited( n ) != ntk.trav_id() )
+      return;
+    CHECK( ntk.level( n ) == ref.level( n ) );
+    CHECK( ntk.is_on_critical_path( n ) == ref.is_on_critical_path( n ) );
+  } );
+}
+
+TEST_CASE( "update levels incrementally under substitutions", "[depth_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( mig.create_pi() );
+  }
+
+  std::mt19937 rng( 7u );
+  auto const random_signal = [&]() {
+    auto f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    while ( mig.is_dead( mig.get_node( f ) ) )
+    {
+      f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    }
+    return ( rng() & 1 ) ? !f : f;
+  };
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    fs.push_back( mig.create_maj( random_signal(), random_signal(), random_signal() ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    mig.create_po( fs[fs.size() - 1u - 5u * i] );
+  }
+
+  depth_view_params ps;
+  ps.incremental = true;
+  depth_view depth_mig{ mig, {}, ps };
+
+  std::function<bool( mig_network::node const&, mig_network::node const& )> depends_on = [&]( auto const& g, auto const& n ) {
+    bool found{ g == n };
+    depth_mig.foreach_fanin( g, [&]( auto const& f ) {
+      found = found || depends_on( depth_mig.get_node( f ), n );
+    } );
+    return found;
+  };
+  check_incremental_levels( depth_mig );
+
+  for ( auto i = 0u; i < 30u; ++i )
+  {
+    auto const n = depth_mig.get_node( fs[8u + ( 37u * i ) % 200u] );
+    if ( depth_mig.is_dead( n ) )
+      continue;
+
+    /* substitute with a shallower or a deeper node, which must not depend on `n` */
+    auto const g = ( i & 1 ) ? depth_mig.create_and( fs[i % 8u], fs[( i + 3u ) % 8u] )
+                             : depth_mig.create_maj( fs[i % 8u], random_signal(), random_signal() );
+    if ( depth_mig.get_node( g ) == n || depth_mig.is_dead( depth_mig.get_node( g ) ) || depends_on( depth_mig.get_node( g ), n ) )
+      continue;
+    depth_mig.substitute_node( n, g );
+    check_incremental_levels( depth_mig );
+  }
+
+  /* updating the levels only recomputes them if they have been overridden */
+  depth_mig.set_level( depth_mig.get_node( fs[100] ), 1000u );
+  depth_mig.update_levels();
+  check_incremental_levels( depth_mig );
+}
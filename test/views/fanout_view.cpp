@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
@@ -13,6 +15,7 @@
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/traits.hpp>
+#include <mockturtle/utils/parallel_utils.hpp>
 #include <mockturtle/views/fanout_view.hpp>
 
 using namespace mockturtle;
@@ -298,4 +301,109 @@ TEST_CASE( "substitute node with no restrash complemented node in fanout view",
   CHECK( faig.fanout_size( faig.get_node( f2 ) ) == 1 );
 
   CHECK( simulate<kitty::static_truth_table<2u>>( faig )[0]._bits == 0x7 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "maintain fanouts of high-fanout nodes in fanout view", "[fanout_view]" )
+{
+  aig_network aig;
+  fanout_view faig( aig );
+
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( faig.create_pi() );
+  }
+
+  /* a node with many fanouts, whose fanout range is moved several times */
+  auto const h = faig.create_and( pis[0], pis[1] );
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 2u; i < 8u; ++i )
+  {
+    for ( auto j = i + 1u; j < 8u; ++j )
+    {
+      fs.push_back( faig.create_and( h, faig.create_and( pis[i], !pis[j] ) ) );
+      fs.push_back( faig.create_and( !h, faig.create_xor( pis[i], pis[j] ) ) );
+    }
+  }
+  for ( auto const& f : fs )
+  {
+    faig.create_po( f );
+  }
+  CHECK( faig.fanout( faig.get_node( h ) ).size() == fs.size() );
+
+  auto const check_fanouts = [&]() {
+    fanout_view ref( aig );
+    faig.foreach_node( [&]( auto const& n ) {
+      if ( faig.is_dead( n ) )
+        return;
+
+      auto fanouts = faig.fanout( n );
+      auto ref_fanouts = ref.fanout( n );
+      std::sort( fanouts.begin(), fanouts.end() );
+      std::sort( ref_fanouts.begin(), ref_fanouts.end() );
+      CHECK( fanouts == ref_fanouts );
+    } );
+  };
+  check_fanouts();
+
+  /* all the fanouts of `h` are redirected */
+  auto const g = faig.create_and( pis[0], !pis[1] );
+  faig.substitute_node( faig.get_node( h ), g );
+  CHECK( faig.is_dead( faig.get_node( h ) ) );
+  CHECK( faig.fanout( faig.get_node( g ) ).size() == fs.size() );
+  check_fanouts();
+
+  faig.substitute_node_no_restrash( faig.get_node( g ), !pis[2] );
+  CHECK( faig.fanout( faig.get_node( pis[2] ) ).size() == fs.size() + 10u );
+  check_fanouts();
+
+  /* fanouts visited while creating new nodes */
+  std::vector<aig_network::node> visited;
+  faig.foreach_fanout( faig.get_node( pis[2] ), [&]( auto const& n ) {
+    visited.push_back( n );
+    faig.create_and( pis[3], faig.make_signal( n ) );
+  } );
+  CHECK( visited.size() == fs.size() + 10u );
+  check_fanouts();
+}
+
+TEST_CASE( "traverse fanouts from several threads in fanout view", "[fanout_view]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    fs.push_back( aig.create_and( fs[( 7u * i ) % fs.size()], !fs[( 13u * i + 5u ) % fs.size()] ) );
+  }
+  aig.create_po( fs.back() );
+
+  fanout_view const faig( aig );
+
+  /* const traversals have no side effects, hence they can run concurrently */
+  std::vector<uint64_t> sums( 4u, 0u );
+  parallel_for( 4u, sums.size(), [&]( uint64_t index, uint32_t ) {
+    for ( auto round = 0u; round < 10u; ++round )
+    {
+      faig.foreach_node( [&]( auto const& n ) {
+        faig.foreach_fanout( n, [&]( auto const& p ) {
+          sums[index] += faig.node_to_index( p );
+        } );
+      } );
+    }
+  } );
+
+  uint64_t sum{ 0u };
+  faig.foreach_node( [&]( auto const& n ) {
+    faig.foreach_fanout( n, [&]( auto const& p ) {
+      sum += faig.node_to_index( p );
+    } );
+  } );
+  for ( auto const& s : sums )
+  {
+    CHECK( s == 10u * sum );
+  }
+}
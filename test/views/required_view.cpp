@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/views/required_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "compute required times and slacks for AIG", "[required_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, a );
+  const auto f4 = aig.create_and( b, c );
+  aig.create_po( f3 );
+  aig.create_po( aig.create_and( f4, a ) );
+
+  required_view required_aig{ aig };
+  CHECK( required_aig.depth() == 3u );
+  CHECK( required_aig.reverse_level( aig.get_node( f3 ) ) == 0u );
+  CHECK( required_aig.reverse_level( aig.get_node( f2 ) ) == 1u );
+  CHECK( required_aig.reverse_level( aig.get_node( f1 ) ) == 2u );
+  CHECK( required_aig.reverse_level( aig.get_node( a ) ) == 3u );
+  CHECK( required_aig.reverse_level( aig.get_node( f4 ) ) == 1u );
+  CHECK( required_aig.required( aig.get_node( f4 ) ) == 2u );
+  CHECK( required_aig.slack( aig.get_node( f1 ) ) == 0 );
+  CHECK( required_aig.slack( aig.get_node( f4 ) ) == 1 );
+
+  /* dangling nodes do not constrain their fanins */
+  const auto f5 = required_aig.create_and( f4, f3 );
+  CHECK( required_aig.slack( aig.get_node( f4 ) ) == 1 );
+  CHECK( required_aig.required( aig.get_node( f5 ) ) == 3u );
+
+  /* a new output on a deeper node increases the depth and the reverse levels */
+  required_aig.create_po( f5 );
+  CHECK( required_aig.depth() == 4u );
+  CHECK( required_aig.reverse_level( aig.get_node( f4 ) ) == 1u );
+  CHECK( required_aig.reverse_level( aig.get_node( f1 ) ) == 3u );
+  CHECK( required_aig.slack( aig.get_node( f4 ) ) == 2 );
+  CHECK( required_aig.slack( aig.get_node( f1 ) ) == 0 );
+
+  /* candidates that are deeper than the depth have negative slack */
+  const auto f6 = required_aig.create_and( required_aig.create_and( f5, c ), b );
+  CHECK( required_aig.depth() == 4u );
+  CHECK( required_aig.level( aig.get_node( f6 ) ) == 6u );
+  CHECK( required_aig.required( aig.get_node( f6 ) ) == 4u );
+  CHECK( required_aig.slack( aig.get_node( f6 ) ) == -2 );
+}
+
+template<typename Ntk>
+void check_required( required_view<Ntk> const& ntk )
+{
+  required_view<Ntk> ref{ static_cast<Ntk const&>( ntk ) };
+  CHECK( ntk.depth() == ref.depth() );
+  ntk.foreach_node( [&]( auto const& n ) {
+    if ( ntk.is_dead( n ) )
+      return;
+    CHECK( ntk.reverse_level( n ) == ref.reverse_level( n ) );
+    CHECK( ntk.slack( n ) == ref.slack( n ) );
+  } );
+}
+
+TEST_CASE( "update required times incrementally under substitutions", "[required_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( mig.create_pi() );
+  }
+
+  std::mt19937 rng( 11u );
+  auto const random_signal = [&]() {
+    auto f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    while ( mig.is_dead( mig.get_node( f ) ) )
+    {
+      f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    }
+    return ( rng() & 1 ) ? !f : f;
+  };
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    fs.push_back( mig.create_maj( random_signal(), random_signal(), random_signal() ) );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    mig.create_po( fs[fs.size() - 1u - 5u * i] );
+  }
+
+  required_view required_mig{ mig };
+  check_required( required_mig );
+
+  std::function<bool( mig_network::node const&, mig_network::node const& )> depends_on = [&]( auto const& g, auto const& n ) {
+    bool found{ g == n };
+    required_mig.foreach_fanin( g, [&]( auto const& f ) {
+      found = found || depends_on( required_mig.get_node( f ), n );
+    } );
+    return found;
+  };
+
+  for ( auto i = 0u; i < 40u; ++i )
+  {
+    auto const n = required_mig.get_node( fs[8u + ( 37u * i ) % 200u] );
+    if ( required_mig.is_dead( n ) )
+      continue;
+
+    /* substitute with a shallower or a deeper node, which must not depend on `n` */
+    auto const g = ( i & 1 ) ? required_mig.create_and( fs[i % 8u], fs[( i + 3u ) % 8u] )
+                             : required_mig.create_maj( fs[i % 8u], random_signal(), random_signal() );
+    if ( required_mig.get_node( g ) == n || required_mig.is_dead( required_mig.get_node( g ) ) || depends_on( required_mig.get_node( g ), n ) )
+      continue;
+    required_mig.substitute_node( n, g );
+    check_required( required_mig );
+  }
+}